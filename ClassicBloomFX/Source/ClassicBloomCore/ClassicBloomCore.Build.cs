@@ -0,0 +1,19 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+using UnrealBuildTool;
+
+// CPU implementation of the bloom kernels; depends on Core only so it builds for servers and commandlets
+public class ClassicBloomCore : ModuleRules
+{
+	public ClassicBloomCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core"
+			}
+		);
+	}
+}
@@ -0,0 +1,36 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomBlurKernel.h"
+
+FClassicBloomBlurKernel FClassicBloomBlurKernel::Build(float Sigma, int32 NumTaps)
+{
+	FClassicBloomBlurKernel Kernel;
+	Kernel.NumFetchPairs = (SnapTapCount(NumTaps) - 1) / 4;
+	const int32 TapsPerSide = 2 * Kernel.NumFetchPairs;
+
+	Sigma = FMath::Max(Sigma, UE_KINDA_SMALL_NUMBER);
+	Kernel.TapSpacing = FMath::Max(1.0f, Sigma * CoveredSigmas / (float)TapsPerSide);
+
+	float TapWeights[2 * MaxFetchPairs + 1];
+	float TotalWeight = 0.0f;
+	for (int32 Tap = 0; Tap <= TapsPerSide; ++Tap)
+	{
+		const float Distance = (float)Tap * Kernel.TapSpacing / Sigma;
+		TapWeights[Tap] = FMath::Exp(-0.5f * Distance * Distance);
+		TotalWeight += (Tap == 0) ? TapWeights[Tap] : 2.0f * TapWeights[Tap];
+	}
+
+	// Taps 2i + 1 and 2i + 2 become one fetch between them; the bilinear weights reproduce both when they are a texel apart
+	Kernel.CenterWeight = TapWeights[0] / TotalWeight;
+	for (int32 Pair = 0; Pair < Kernel.NumFetchPairs; ++Pair)
+	{
+		const int32 Near = 2 * Pair + 1;
+		const float PairWeight = TapWeights[Near] + TapWeights[Near + 1];
+		Kernel.Offsets[Pair] = (PairWeight > 0.0f)
+			? ((float)Near * TapWeights[Near] + (float)(Near + 1) * TapWeights[Near + 1]) / PairWeight * Kernel.TapSpacing
+			: (float)Near * Kernel.TapSpacing;
+		Kernel.Weights[Pair] = PairWeight / TotalWeight;
+	}
+
+	return Kernel;
+}
@@ -0,0 +1,180 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomBudgetController.h"
+
+// ============================================================================
+// FClassicBloomQualityLadder
+// ============================================================================
+
+FClassicBloomQualityLadder::FClassicBloomQualityLadder(const FClassicBloomQualityLevel& Authored, EClassicBloomQualityAxes Axes)
+{
+	Levels.Add(Authored);
+
+	// Pass counts go before resolution: they soften the bloom less than a coarser divisor
+	static constexpr EClassicBloomQualityAxes Order[] =
+	{
+		EClassicBloomQualityAxes::BlurPasses,
+		EClassicBloomQualityAxes::GlareStreakCount,
+		EClassicBloomQualityAxes::KawaseMipCount,
+		EClassicBloomQualityAxes::DownsampleDivisor,
+	};
+
+	// Lower Axis by one step; false when it is disabled or already at its floor
+	auto Step = [Axes](EClassicBloomQualityAxes Axis, FClassicBloomQualityLevel& Level)
+	{
+		if (!EnumHasAnyFlags(Axes, Axis))
+		{
+			return false;
+		}
+		switch (Axis)
+		{
+		case EClassicBloomQualityAxes::DownsampleDivisor:
+			if (Level.DownsampleDivisor >= MaxDownsampleDivisor)
+			{
+				return false;
+			}
+			++Level.DownsampleDivisor;
+			return true;
+		case EClassicBloomQualityAxes::BlurPasses:
+			if (Level.BlurPasses <= MinBlurPasses)
+			{
+				return false;
+			}
+			--Level.BlurPasses;
+			return true;
+		case EClassicBloomQualityAxes::KawaseMipCount:
+			if (Level.KawaseMipCount <= MinKawaseMipCount)
+			{
+				return false;
+			}
+			--Level.KawaseMipCount;
+			return true;
+		case EClassicBloomQualityAxes::GlareStreakCount:
+			// Two at a time keeps even counts symmetric
+			if (Level.GlareStreakCount <= MinGlareStreakCount)
+			{
+				return false;
+			}
+			Level.GlareStreakCount = FMath::Max(Level.GlareStreakCount - 2, MinGlareStreakCount);
+			return true;
+		default:
+			return false;
+		}
+	};
+
+	static constexpr int32 NumAxes = UE_ARRAY_COUNT(Order);
+	int32 NextAxis = 0;
+	while (Levels.Num() < MaxLevels)
+	{
+		FClassicBloomQualityLevel Next = Levels.Last();
+		bool bStepped = false;
+		for (int32 Attempt = 0; Attempt < NumAxes && !bStepped; ++Attempt)
+		{
+			bStepped = Step(Order[NextAxis], Next);
+			NextAxis = (NextAxis + 1) % NumAxes;
+		}
+		if (!bStepped)
+		{
+			break;
+		}
+		Levels.Add(Next);
+	}
+}
+
+// ============================================================================
+// FClassicBloomBudgetController
+// ============================================================================
+
+FClassicBloomBudgetController::FClassicBloomBudgetController(const FClassicBloomBudgetControllerConfig& InConfig)
+	: Config(InConfig)
+{
+}
+
+void FClassicBloomBudgetController::SetTargetMs(float TargetMs)
+{
+	if (TargetMs != Config.TargetMs)
+	{
+		Config.TargetMs = TargetMs;
+		Integral = 0.0f;
+		bHasPreviousError = false;
+	}
+}
+
+void FClassicBloomBudgetController::SetNumLevels(int32 InNumLevels)
+{
+	NumLevels = FMath::Clamp(InNumLevels, 1, MaxLevels);
+	if (Level >= NumLevels)
+	{
+		PendingStepFrom = INDEX_NONE;
+		ChangeLevel(NumLevels - 1);
+	}
+}
+
+int32 FClassicBloomBudgetController::AddSample(float GpuMs)
+{
+	// Also rejects NaN
+	if (!(GpuMs >= 0.0f) || Config.TargetMs <= 0.0f)
+	{
+		return Level;
+	}
+
+	if (++SamplesSinceChange <= Config.SettleSamples)
+	{
+		return Level;
+	}
+	SmoothedMs = SmoothedMs > 0.0f ? FMath::Lerp(SmoothedMs, GpuMs, Config.SmoothingAlpha) : GpuMs;
+
+	// First settled sample after a step down: remember what the step saved
+	if (PendingStepFrom != INDEX_NONE)
+	{
+		if (PendingStepFromMs > 0.0f)
+		{
+			StepCostRatios[PendingStepFrom] = FMath::Clamp(SmoothedMs / PendingStepFromMs, 0.05f, 1.0f);
+		}
+		PendingStepFrom = INDEX_NONE;
+	}
+
+	const float Error = (GpuMs - Config.TargetMs) / Config.TargetMs;
+	const float Derivative = bHasPreviousError ? Error - PreviousError : 0.0f;
+	PreviousError = Error;
+	bHasPreviousError = true;
+
+	// Clamped so a long stretch at either end of the ladder does not wind the integral up
+	const float MaxIntegral = Config.IntegralGain > 0.0f ? 2.0f * Config.StepThreshold / Config.IntegralGain : 0.0f;
+	Integral = FMath::Clamp(Integral + Error, -MaxIntegral, MaxIntegral);
+
+	const float Output = Config.ProportionalGain * Error + Config.IntegralGain * Integral + Config.DerivativeGain * Derivative;
+	if (Output > Config.StepThreshold && Level < NumLevels - 1)
+	{
+		PendingStepFrom = Level;
+		PendingStepFromMs = SmoothedMs;
+		ChangeLevel(Level + 1);
+	}
+	else if (Output < -Config.StepThreshold && Level > 0)
+	{
+		// Unknown savings only need the headroom the error already shows
+		const float StepCostRatio = StepCostRatios[Level - 1];
+		const float PredictedMs = StepCostRatio > 0.0f ? SmoothedMs / StepCostRatio : SmoothedMs;
+		if (PredictedMs <= Config.TargetMs)
+		{
+			ChangeLevel(Level - 1);
+		}
+	}
+	return Level;
+}
+
+void FClassicBloomBudgetController::Reset()
+{
+	const int32 KeptNumLevels = NumLevels;
+	*this = FClassicBloomBudgetController(Config);
+	NumLevels = KeptNumLevels;
+}
+
+void FClassicBloomBudgetController::ChangeLevel(int32 NewLevel)
+{
+	Level = NewLevel;
+	SamplesSinceChange = 0;
+	SmoothedMs = 0.0f;
+	Integral = 0.0f;
+	bHasPreviousError = false;
+}
@@ -0,0 +1,5 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, ClassicBloomCore)
@@ -0,0 +1,676 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomCpuKernels.h"
+#include "ClassicBloomFFT.h"
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
+
+// ============================================================================
+// Shared helpers
+// ============================================================================
+
+// Rows handed to one worker; small enough to balance, large enough to amortize the task overhead
+static constexpr int32 ClassicBloomCpuRowsPerTask = 16;
+
+// Samples on each side of a glare streak (STREAK_SAMPLES)
+static constexpr int32 ClassicBloomCpuStreakSamples = 16;
+
+static FORCEINLINE VectorRegister4Float LerpColor(const VectorRegister4Float& A, const VectorRegister4Float& B, const VectorRegister4Float& Alpha)
+{
+	return VectorMultiplyAdd(VectorSubtract(B, A), Alpha, A);
+}
+
+static FORCEINLINE float Dot3(const VectorRegister4Float& Color, const VectorRegister4Float& Weights)
+{
+	return VectorGetComponent(VectorDot3(Color, Weights), 0);
+}
+
+static FORCEINLINE float MaxComponent3(const VectorRegister4Float& Color)
+{
+	FVector4f Components;
+	VectorStore(Color, &Components.X);
+	return FMath::Max3(Components.X, Components.Y, Components.Z);
+}
+
+static FORCEINLINE FVector2f ClampUV(const FVector2f& UV, const FVector2f& Min, const FVector2f& Max)
+{
+	return FVector2f(FMath::Clamp(UV.X, Min.X, Max.X), FMath::Clamp(UV.Y, Min.Y, Max.Y));
+}
+
+static FORCEINLINE FVector2f SaturateUV(const FVector2f& UV)
+{
+	return ClampUV(UV, FVector2f::ZeroVector, FVector2f::UnitVector);
+}
+
+static FORCEINLINE VectorRegister4Float LoadTexel(const FClassicBloomImage& Image, int32 X, int32 Y)
+{
+	return VectorLoad(&Image.Pixels.GetData()[Y * Image.Width + X].X);
+}
+
+// Texture2DSample with SF_Bilinear and AM_Clamp on every axis
+static VectorRegister4Float SampleBilinear(const FClassicBloomImage& Image, const FVector2f& UV)
+{
+	const float TexelX = UV.X * Image.Width - 0.5f;
+	const float TexelY = UV.Y * Image.Height - 0.5f;
+	const float FloorX = FMath::FloorToFloat(TexelX);
+	const float FloorY = FMath::FloorToFloat(TexelY);
+
+	const int32 X0 = FMath::Clamp((int32)FloorX, 0, Image.Width - 1);
+	const int32 X1 = FMath::Clamp((int32)FloorX + 1, 0, Image.Width - 1);
+	const int32 Y0 = FMath::Clamp((int32)FloorY, 0, Image.Height - 1);
+	const int32 Y1 = FMath::Clamp((int32)FloorY + 1, 0, Image.Height - 1);
+
+	const VectorRegister4Float FracX = VectorSetFloat1(TexelX - FloorX);
+	const VectorRegister4Float FracY = VectorSetFloat1(TexelY - FloorY);
+
+	const VectorRegister4Float Top = LerpColor(LoadTexel(Image, X0, Y0), LoadTexel(Image, X1, Y0), FracX);
+	const VectorRegister4Float Bottom = LerpColor(LoadTexel(Image, X0, Y1), LoadTexel(Image, X1, Y1), FracX);
+	return LerpColor(Top, Bottom, FracY);
+}
+
+// Run PixelFunction(SvPosition) for every pixel of Out, rows split across worker threads
+template <typename FunctionType>
+static void ForEachPixel(FClassicBloomImage& Out, const FunctionType& PixelFunction)
+{
+	const int32 NumTasks = FMath::DivideAndRoundUp(Out.Height, ClassicBloomCpuRowsPerTask);
+	ParallelFor(NumTasks, [&Out, &PixelFunction](int32 TaskIndex)
+	{
+		const int32 RowBegin = TaskIndex * ClassicBloomCpuRowsPerTask;
+		const int32 RowEnd = FMath::Min(RowBegin + ClassicBloomCpuRowsPerTask, Out.Height);
+		for (int32 Y = RowBegin; Y < RowEnd; ++Y)
+		{
+			FVector4f* Row = Out.Pixels.GetData() + Y * Out.Width;
+			for (int32 X = 0; X < Out.Width; ++X)
+			{
+				VectorStore(PixelFunction(FVector2f(X + 0.5f, Y + 0.5f)), &Row[X].X);
+				Row[X].W = 1.0f;
+			}
+		}
+	});
+}
+
+// Current value of the pixel ForEachPixel is about to write, for the additive blend passes.
+// Each pixel reads only its own previous value, so updating in place is safe.
+static VectorRegister4Float LoadOutput(const FClassicBloomImage& Out, const FVector2f& SvPosition)
+{
+	return LoadTexel(Out, (int32)SvPosition.X, (int32)SvPosition.Y);
+}
+
+// ============================================================================
+// Bright pass
+// ============================================================================
+
+static float BrightMask(const VectorRegister4Float& Color, float Threshold)
+{
+	const float Luminance = Dot3(Color, MakeVectorRegisterFloat(0.299f, 0.587f, 0.114f, 0.0f));
+
+	// A very low threshold means soft focus mode and keeps the full scene
+	if (Threshold < 0.02f)
+	{
+		return 1.0f;
+	}
+
+	return FMath::SmoothStep(Threshold, Threshold + 0.5f, Luminance);
+}
+
+void FClassicBloomCpuKernels::BrightPass(const FClassicBloomImage& Source, FVector2f UVScale, FVector2f UVBias, float Threshold, FClassicBloomImage& Out)
+{
+	ForEachPixel(Out, [&](const FVector2f& SvPosition)
+	{
+		const VectorRegister4Float Color = SampleBilinear(Source, SvPosition * UVScale + UVBias);
+		return VectorMultiply(Color, VectorSetFloat1(BrightMask(Color, Threshold)));
+	});
+}
+
+// ============================================================================
+// Gaussian blur
+// ============================================================================
+
+void FClassicBloomCpuKernels::GaussianBlur(const FClassicBloomImage& Source, FVector2f Direction, const FClassicBloomBlurKernel& Kernel, FClassicBloomImage& Out)
+{
+	const FVector2f TexelSize(1.0f / Out.Width, 1.0f / Out.Height);
+
+	// Half-texel margin extends the border texels instead of blending in the clamp region
+	const FVector2f ClampMin = TexelSize * 0.5f;
+	const FVector2f ClampMax = FVector2f::UnitVector - ClampMin;
+
+	FVector2f Offsets[FClassicBloomBlurKernel::MaxFetchPairs];
+	for (int32 Pair = 0; Pair < Kernel.NumFetchPairs; ++Pair)
+	{
+		Offsets[Pair] = Direction * TexelSize * Kernel.Offsets[Pair];
+	}
+
+	ForEachPixel(Out, [&](const FVector2f& SvPosition)
+	{
+		const FVector2f UV = SvPosition * TexelSize;
+		VectorRegister4Float Result = VectorMultiply(SampleBilinear(Source, ClampUV(UV, ClampMin, ClampMax)), VectorSetFloat1(Kernel.CenterWeight));
+
+		for (int32 Pair = 0; Pair < Kernel.NumFetchPairs; ++Pair)
+		{
+			const VectorRegister4Float Weight = VectorSetFloat1(Kernel.Weights[Pair]);
+			Result = VectorMultiplyAdd(SampleBilinear(Source, ClampUV(UV + Offsets[Pair], ClampMin, ClampMax)), Weight, Result);
+			Result = VectorMultiplyAdd(SampleBilinear(Source, ClampUV(UV - Offsets[Pair], ClampMin, ClampMax)), Weight, Result);
+		}
+		return Result;
+	});
+}
+
+// ============================================================================
+// Glare streaks
+// ============================================================================
+
+// Affine SvPosition -> UV mapping of the streak and resolve passes
+static FORCEINLINE FVector2f AffineUV(const FVector3f& U, const FVector3f& V, const FVector2f& SvPosition)
+{
+	return FVector2f(U.X * SvPosition.X + U.Y * SvPosition.Y + U.Z, V.X * SvPosition.X + V.Y * SvPosition.Y + V.Z);
+}
+
+void FClassicBloomCpuKernels::GlareStreak(const FClassicBloomImage& Source, const FVector3f& UVFromPositionU, const FVector3f& UVFromPositionV, TConstArrayView<FVector4f> Axes, float Length, float Falloff, bool bAdditive, FClassicBloomImage& Out)
+{
+	const FVector2f TexelSize(1.0f / Source.Width, 1.0f / Source.Height);
+
+	// Weights only depend on the sample index; negligible ones are skipped like in the shader
+	TArray<TPair<int32, float>, TInlineAllocator<ClassicBloomCpuStreakSamples>> Samples;
+	float TotalWeight = 1.0f; // Center
+	for (int32 Index = 1; Index <= ClassicBloomCpuStreakSamples; ++Index)
+	{
+		const float Weight = FMath::Exp(-(float(Index) / float(ClassicBloomCpuStreakSamples)) * Falloff);
+		if (Weight >= 0.001f)
+		{
+			Samples.Emplace(Index, Weight);
+			TotalWeight += 2.0f * Weight;
+		}
+	}
+	const VectorRegister4Float Scale = VectorSetFloat1(1.0f / TotalWeight);
+
+	float CenterShare = 0.0f;
+	for (const FVector4f& Axis : Axes)
+	{
+		CenterShare += Axis.Z;
+	}
+
+	ForEachPixel(Out, [&](const FVector2f& SvPosition)
+	{
+		const FVector2f UV = AffineUV(UVFromPositionU, UVFromPositionV, SvPosition);
+		VectorRegister4Float Result = VectorMultiply(SampleBilinear(Source, SaturateUV(UV)), VectorSetFloat1(CenterShare));
+
+		for (const TPair<int32, float>& Sample : Samples)
+		{
+			for (const FVector4f& Axis : Axes)
+			{
+				const FVector2f Offset = FVector2f(Axis.X, Axis.Y) * TexelSize * (Length / float(ClassicBloomCpuStreakSamples) * float(Sample.Key));
+				const VectorRegister4Float Weight = VectorSetFloat1(Sample.Value * Axis.Z);
+				Result = VectorMultiplyAdd(SampleBilinear(Source, SaturateUV(UV + Offset)), Weight, Result);
+				Result = VectorMultiplyAdd(SampleBilinear(Source, SaturateUV(UV - Offset)), Weight, Result);
+			}
+		}
+		Result = VectorMultiply(Result, Scale);
+		return bAdditive ? VectorAdd(Result, LoadOutput(Out, SvPosition)) : Result;
+	});
+}
+
+void FClassicBloomCpuKernels::GlareStreakResolve(const FClassicBloomImage& Buffer, const FVector3f& UVFromPositionU, const FVector3f& UVFromPositionV, bool bAdditive, FClassicBloomImage& Out)
+{
+	ForEachPixel(Out, [&](const FVector2f& SvPosition)
+	{
+		const VectorRegister4Float Result = SampleBilinear(Buffer, AffineUV(UVFromPositionU, UVFromPositionV, SvPosition));
+		return bAdditive ? VectorAdd(Result, LoadOutput(Out, SvPosition)) : Result;
+	});
+}
+
+void FClassicBloomCpuKernels::GlareStreakStep(const FClassicBloomImage& Source, FVector2f Direction, float Stride, float TapStart, const FVector4f& TapWeights, bool bAdditive, FClassicBloomImage& Out)
+{
+	const FVector2f TexelSize(1.0f / Out.Width, 1.0f / Out.Height);
+	const FVector2f StepOffset = Direction * TexelSize * Stride;
+	const float Weights[4] = { TapWeights.X, TapWeights.Y, TapWeights.Z, TapWeights.W };
+
+	ForEachPixel(Out, [&](const FVector2f& SvPosition)
+	{
+		const FVector2f UV = SvPosition * TexelSize;
+		VectorRegister4Float Result = GlobalVectorConstants::FloatZero;
+		for (int32 Tap = 0; Tap < 4; ++Tap)
+		{
+			const FVector2f SampleUV = SaturateUV(UV + StepOffset * (TapStart + float(Tap)));
+			Result = VectorMultiplyAdd(SampleBilinear(Source, SampleUV), VectorSetFloat1(Weights[Tap]), Result);
+		}
+		return bAdditive ? VectorAdd(Result, LoadOutput(Out, SvPosition)) : Result;
+	});
+}
+
+// ============================================================================
+// Kawase pyramid
+// ============================================================================
+
+// Karis average weight, 1 / (1 + luma) with luma taken from approximate sRGB
+static float KarisWeight(const VectorRegister4Float& Color)
+{
+	FVector4f Col;
+	VectorStore(Color, &Col.X);
+	const float InvGamma = 1.0f / 2.2f;
+	const float Luma = 0.2126f * FMath::Pow(FMath::Max(Col.X, 0.0001f), InvGamma)
+		+ 0.7152f * FMath::Pow(FMath::Max(Col.Y, 0.0001f), InvGamma)
+		+ 0.0722f * FMath::Pow(FMath::Max(Col.Z, 0.0001f), InvGamma);
+	return 1.0f / (1.0f + Luma * 0.25f);
+}
+
+static VectorRegister4Float SoftThreshold(const VectorRegister4Float& Color, float Threshold, float Knee)
+{
+	const float Brightness = MaxComponent3(Color);
+
+	float Soft = FMath::Clamp(Brightness - Threshold + Knee, 0.0f, 2.0f * Knee);
+	Soft = Soft * Soft / (4.0f * Knee + 0.00001f);
+
+	float Contribution = FMath::Max(Soft, Brightness - Threshold);
+	Contribution /= FMath::Max(Brightness, 0.00001f);
+
+	return VectorMultiply(Color, VectorSetFloat1(Contribution));
+}
+
+void FClassicBloomCpuKernels::KawaseDownsample(const FClassicBloomImage& Source, FVector2f UVScale, FVector2f UVBias, int32 MipLevel, float Threshold, float ThresholdKnee, FClassicBloomImage& Out)
+{
+	const float X = 1.0f / Source.Width;
+	const float Y = 1.0f / Source.Height;
+	const bool bKarisAverage = (MipLevel == 0);
+
+	ForEachPixel(Out, [&](const FVector2f& SvPosition)
+	{
+		const FVector2f UV = SvPosition * UVScale + UVBias;
+
+		// a - b - c
+		// - j - k -
+		// d - e - f
+		// - l - m -
+		// g - h - i
+		const VectorRegister4Float A = SampleBilinear(Source, UV + FVector2f(-2 * X, 2 * Y));
+		const VectorRegister4Float B = SampleBilinear(Source, UV + FVector2f(0, 2 * Y));
+		const VectorRegister4Float C = SampleBilinear(Source, UV + FVector2f(2 * X, 2 * Y));
+		const VectorRegister4Float D = SampleBilinear(Source, UV + FVector2f(-2 * X, 0));
+		const VectorRegister4Float E = SampleBilinear(Source, UV);
+		const VectorRegister4Float F = SampleBilinear(Source, UV + FVector2f(2 * X, 0));
+		const VectorRegister4Float G = SampleBilinear(Source, UV + FVector2f(-2 * X, -2 * Y));
+		const VectorRegister4Float H = SampleBilinear(Source, UV + FVector2f(0, -2 * Y));
+		const VectorRegister4Float I = SampleBilinear(Source, UV + FVector2f(2 * X, -2 * Y));
+		const VectorRegister4Float J = SampleBilinear(Source, UV + FVector2f(-X, Y));
+		const VectorRegister4Float K = SampleBilinear(Source, UV + FVector2f(X, Y));
+		const VectorRegister4Float L = SampleBilinear(Source, UV + FVector2f(-X, -Y));
+		const VectorRegister4Float M = SampleBilinear(Source, UV + FVector2f(X, -Y));
+
+		VectorRegister4Float Downsample;
+		if (bKarisAverage)
+		{
+			const VectorRegister4Float Corner = VectorSetFloat1(0.03125f);
+			const VectorRegister4Float Center = VectorSetFloat1(0.125f);
+			const VectorRegister4Float Groups[5] =
+			{
+				VectorMultiply(VectorAdd(VectorAdd(A, B), VectorAdd(D, E)), Corner),
+				VectorMultiply(VectorAdd(VectorAdd(B, C), VectorAdd(E, F)), Corner),
+				VectorMultiply(VectorAdd(VectorAdd(D, E), VectorAdd(G, H)), Corner),
+				VectorMultiply(VectorAdd(VectorAdd(E, F), VectorAdd(H, I)), Corner),
+				VectorMultiply(VectorAdd(VectorAdd(J, K), VectorAdd(L, M)), Center),
+			};
+
+			Downsample = GlobalVectorConstants::FloatZero;
+			for (const VectorRegister4Float& Group : Groups)
+			{
+				Downsample = VectorMultiplyAdd(Group, VectorSetFloat1(KarisWeight(Group)), Downsample);
+			}
+		}
+		else
+		{
+			Downsample = VectorMultiply(E, VectorSetFloat1(0.125f));
+			Downsample = VectorMultiplyAdd(VectorAdd(VectorAdd(A, C), VectorAdd(G, I)), VectorSetFloat1(0.03125f), Downsample);
+			Downsample = VectorMultiplyAdd(VectorAdd(VectorAdd(B, D), VectorAdd(F, H)), VectorSetFloat1(0.0625f), Downsample);
+			Downsample = VectorMultiplyAdd(VectorAdd(VectorAdd(J, K), VectorAdd(L, M)), VectorSetFloat1(0.125f), Downsample);
+		}
+
+		// Threshold on the first mip only
+		if (MipLevel == 0 && Threshold > 0.0f)
+		{
+			if (ThresholdKnee > 0.0f)
+			{
+				Downsample = SoftThreshold(Downsample, Threshold, Threshold * ThresholdKnee);
+			}
+			else if (MaxComponent3(Downsample) < Threshold)
+			{
+				Downsample = GlobalVectorConstants::FloatZero;
+			}
+		}
+
+		// Never fully black, as in the shader
+		return VectorMax(Downsample, VectorSetFloat1(0.0001f));
+	});
+}
+
+void FClassicBloomCpuKernels::KawaseUpsample(const FClassicBloomImage& Source, float FilterRadius, bool bAdditive, FClassicBloomImage& Out)
+{
+	const FVector2f InvSize(1.0f / Out.Width, 1.0f / Out.Height);
+	const float R = FilterRadius;
+
+	ForEachPixel(Out, [&](const FVector2f& SvPosition)
+	{
+		const FVector2f UV = SvPosition * InvSize;
+
+		// 3x3 tent: corners * 1, edges * 2, center * 4, over 16
+		const VectorRegister4Float Corners = VectorAdd(
+			VectorAdd(SampleBilinear(Source, UV + FVector2f(-R, R)), SampleBilinear(Source, UV + FVector2f(R, R))),
+			VectorAdd(SampleBilinear(Source, UV + FVector2f(-R, -R)), SampleBilinear(Source, UV + FVector2f(R, -R))));
+		const VectorRegister4Float Edges = VectorAdd(
+			VectorAdd(SampleBilinear(Source, UV + FVector2f(0, R)), SampleBilinear(Source, UV + FVector2f(-R, 0))),
+			VectorAdd(SampleBilinear(Source, UV + FVector2f(R, 0)), SampleBilinear(Source, UV + FVector2f(0, -R))));
+
+		VectorRegister4Float Upsample = VectorMultiply(SampleBilinear(Source, UV), VectorSetFloat1(4.0f));
+		Upsample = VectorMultiplyAdd(Edges, VectorSetFloat1(2.0f), Upsample);
+		Upsample = VectorAdd(Upsample, Corners);
+		Upsample = VectorMultiply(Upsample, VectorSetFloat1(1.0f / 16.0f));
+
+		return bAdditive ? VectorAdd(Upsample, LoadOutput(Out, SvPosition)) : Upsample;
+	});
+}
+
+// ============================================================================
+// FFT convolution
+// ============================================================================
+
+// R, G and B of one spectrum line as three complex lines (the shader's groupshared FFTLine)
+struct FClassicBloomCpuFFTLine
+{
+	TArray<FVector2f> Channels[3];
+
+	explicit FClassicBloomCpuFFTLine(int32 Size)
+	{
+		for (TArray<FVector2f>& Channel : Channels)
+		{
+			Channel.SetNumZeroed(Size);
+		}
+	}
+
+	void Store(int32 Index, const FVector4f& RG, const FVector4f& B)
+	{
+		Channels[0][Index] = FVector2f(RG.X, RG.Y);
+		Channels[1][Index] = FVector2f(RG.Z, RG.W);
+		Channels[2][Index] = FVector2f(B.X, B.Y);
+	}
+
+	void Write(int32 Index, FVector4f& OutRG, FVector4f& OutB) const
+	{
+		OutRG = FVector4f(Channels[0][Index].X, Channels[0][Index].Y, Channels[1][Index].X, Channels[1][Index].Y);
+		OutB = FVector4f(Channels[2][Index].X, Channels[2][Index].Y, 0.0f, 0.0f);
+	}
+
+	void Transform(bool bInverse)
+	{
+		for (TArray<FVector2f>& Channel : Channels)
+		{
+			FClassicBloomFFT::Transform(Channel, bInverse);
+		}
+	}
+};
+
+static FORCEINLINE FVector2f ComplexMul(const FVector2f& A, const FVector2f& B)
+{
+	return FVector2f(A.X * B.X - A.Y * B.Y, A.X * B.Y + A.Y * B.X);
+}
+
+void FClassicBloomCpuKernels::FFTForwardRows(const FClassicBloomImage& Source, FClassicBloomImage& SpectrumRG, FClassicBloomImage& SpectrumB)
+{
+	const int32 Width = SpectrumRG.Width;
+	ParallelFor(Source.Height, [&](int32 Row)
+	{
+		FClassicBloomCpuFFTLine Line(Width);
+		for (int32 X = 0; X < FMath::Min(Source.Width, Width); ++X)
+		{
+			const FVector4f& Value = Source.At(X, Row);
+			Line.Store(X, FVector4f(Value.X, 0.0f, Value.Y, 0.0f), FVector4f(Value.Z, 0.0f, 0.0f, 0.0f));
+		}
+		Line.Transform(false);
+		for (int32 X = 0; X < Width; ++X)
+		{
+			Line.Write(X, SpectrumRG.At(X, Row), SpectrumB.At(X, Row));
+		}
+	});
+}
+
+void FClassicBloomCpuKernels::FFTKernelRows(const FClassicBloomImage& Kernel, float KernelSizeInTexels, FClassicBloomImage& SpectrumRG, FClassicBloomImage& SpectrumB)
+{
+	const FIntPoint FFTSize = SpectrumRG.GetSize();
+	const FVector2f KernelSize(KernelSizeInTexels, KernelSizeInTexels * Kernel.Height / Kernel.Width);
+
+	ParallelFor(FFTSize.Y, [&](int32 Row)
+	{
+		FClassicBloomCpuFFTLine Line(FFTSize.X);
+		const int32 OffsetY = Row < FFTSize.Y / 2 ? Row : Row - FFTSize.Y;
+		for (int32 X = 0; X < FFTSize.X; ++X)
+		{
+			const int32 OffsetX = X < FFTSize.X / 2 ? X : X - FFTSize.X;
+			const FVector2f UV = FVector2f(0.5f, 0.5f) + FVector2f((float)OffsetX, (float)OffsetY) / KernelSize;
+			if (UV.X < 0.0f || UV.Y < 0.0f || UV.X > 1.0f || UV.Y > 1.0f)
+			{
+				continue;
+			}
+
+			FVector4f Value;
+			VectorStore(SampleBilinear(Kernel, UV), &Value.X);
+			Line.Store(X, FVector4f(Value.X, 0.0f, Value.Y, 0.0f), FVector4f(Value.Z, 0.0f, 0.0f, 0.0f));
+		}
+		Line.Transform(false);
+		for (int32 X = 0; X < FFTSize.X; ++X)
+		{
+			Line.Write(X, SpectrumRG.At(X, Row), SpectrumB.At(X, Row));
+		}
+	});
+}
+
+void FClassicBloomCpuKernels::FFTColumns(int32 NumRows, const FClassicBloomImage* KernelRG, const FClassicBloomImage* KernelB, FClassicBloomImage& SpectrumRG, FClassicBloomImage& SpectrumB)
+{
+	const FIntPoint FFTSize = SpectrumRG.GetSize();
+	const bool bConvolve = KernelRG && KernelB;
+
+	// A kernel image of any brightness neither brightens nor darkens the bloom: divide by its DC term
+	float Scale = 1.0f;
+	if (bConvolve)
+	{
+		const float KernelDC = (KernelRG->At(0, 0).X + KernelRG->At(0, 0).Z + KernelB->At(0, 0).X) / 3.0f;
+		Scale = 1.0f / ((float)FFTSize.X * (float)FFTSize.Y * FMath::Max(KernelDC, 1e-6f));
+	}
+
+	ParallelFor(FFTSize.X, [&](int32 Column)
+	{
+		FClassicBloomCpuFFTLine Line(FFTSize.Y);
+		for (int32 Y = 0; Y < NumRows; ++Y)
+		{
+			Line.Store(Y, SpectrumRG.At(Column, Y), SpectrumB.At(Column, Y));
+		}
+		Line.Transform(false);
+
+		if (bConvolve)
+		{
+			for (int32 Y = 0; Y < FFTSize.Y; ++Y)
+			{
+				const FVector4f& RG = KernelRG->At(Column, Y);
+				const FVector4f& B = KernelB->At(Column, Y);
+				Line.Channels[0][Y] = ComplexMul(Line.Channels[0][Y], FVector2f(RG.X, RG.Y) * Scale);
+				Line.Channels[1][Y] = ComplexMul(Line.Channels[1][Y], FVector2f(RG.Z, RG.W) * Scale);
+				Line.Channels[2][Y] = ComplexMul(Line.Channels[2][Y], FVector2f(B.X, B.Y) * Scale);
+			}
+			Line.Transform(true);
+		}
+
+		for (int32 Y = 0; Y < NumRows; ++Y)
+		{
+			Line.Write(Y, SpectrumRG.At(Column, Y), SpectrumB.At(Column, Y));
+		}
+	});
+}
+
+void FClassicBloomCpuKernels::FFTInverseRows(const FClassicBloomImage& SpectrumRG, const FClassicBloomImage& SpectrumB, FClassicBloomImage& Out)
+{
+	ParallelFor(Out.Height, [&](int32 Row)
+	{
+		FClassicBloomCpuFFTLine Line(SpectrumRG.Width);
+		for (int32 X = 0; X < SpectrumRG.Width; ++X)
+		{
+			Line.Store(X, SpectrumRG.At(X, Row), SpectrumB.At(X, Row));
+		}
+		Line.Transform(true);
+
+		// Ringing of the band-limited product can dip just below zero
+		for (int32 X = 0; X < Out.Width; ++X)
+		{
+			Out.At(X, Row) = FVector4f(
+				FMath::Max(Line.Channels[0][X].X, 0.0f),
+				FMath::Max(Line.Channels[1][X].X, 0.0f),
+				FMath::Max(Line.Channels[2][X].X, 0.0f),
+				1.0f);
+		}
+	});
+}
+
+// ============================================================================
+// Composite
+// ============================================================================
+
+static const VectorRegister4Float ClassicBloomCpuLumaWeights = MakeVectorRegisterFloatConstant(0.299f, 0.587f, 0.114f, 0.0f);
+
+static FORCEINLINE VectorRegister4Float Step(const VectorRegister4Float& Edge, const VectorRegister4Float& Value)
+{
+	return VectorSelect(VectorCompareGE(Value, Edge), GlobalVectorConstants::FloatOne, GlobalVectorConstants::FloatZero);
+}
+
+static VectorRegister4Float AdjustSaturation(const VectorRegister4Float& Color, float Saturation)
+{
+	const VectorRegister4Float Luminance = VectorSetFloat1(Dot3(Color, ClassicBloomCpuLumaWeights));
+	return LerpColor(Luminance, Color, VectorSetFloat1(Saturation));
+}
+
+static float Tanh(float Value)
+{
+	// Written so that large magnitudes saturate to +-1 instead of overflowing
+	return 1.0f - 2.0f / (FMath::Exp(2.0f * Value) + 1.0f);
+}
+
+static VectorRegister4Float ProtectHighlights(const VectorRegister4Float& Color, float Protection)
+{
+	if (Protection <= 0.0f)
+	{
+		return Color;
+	}
+
+	const float Luma = Dot3(Color, ClassicBloomCpuLumaWeights);
+	const float Threshold = FMath::Lerp(2.0f, 0.8f, Protection);
+	const float SoftClip = Threshold + (1.0f - Threshold) * Tanh((Luma - Threshold) / (1.0f - Threshold));
+	const float Scale = (Luma > 0.001f) ? (SoftClip / Luma) : 1.0f;
+	return VectorMultiply(Color, VectorSetFloat1(FMath::Clamp(Scale, 0.0f, 1.0f)));
+}
+
+// Overlay / hard light: lerp(2*Base*Blend, 1 - 2*(1-Base)*(1-Blend), step(0.5, Selector))
+static VectorRegister4Float OverlayBlend(const VectorRegister4Float& Base, const VectorRegister4Float& Blend, const VectorRegister4Float& Selector)
+{
+	const VectorRegister4Float One = GlobalVectorConstants::FloatOne;
+	const VectorRegister4Float Two = VectorSetFloat1(2.0f);
+	const VectorRegister4Float Dark = VectorMultiply(Two, VectorMultiply(Base, Blend));
+	const VectorRegister4Float Light = VectorSubtract(One, VectorMultiply(Two, VectorMultiply(VectorSubtract(One, Base), VectorSubtract(One, Blend))));
+	return LerpColor(Dark, Light, Step(GlobalVectorConstants::FloatOneHalf, Selector));
+}
+
+static VectorRegister4Float ApplyBloomBlendMode(const VectorRegister4Float& Base, const VectorRegister4Float& Blend, int32 Mode)
+{
+	const VectorRegister4Float One = GlobalVectorConstants::FloatOne;
+	const VectorRegister4Float Two = VectorSetFloat1(2.0f);
+
+	switch (Mode)
+	{
+		case 0: // Screen
+			return VectorSubtract(VectorAdd(Base, Blend), VectorMultiply(Base, Blend));
+		case 1: // Overlay
+			return OverlayBlend(Base, Blend, Base);
+		case 2: // Soft light
+		{
+			const VectorRegister4Float Dark = VectorAdd(
+				VectorMultiply(Two, VectorMultiply(Base, Blend)),
+				VectorMultiply(VectorMultiply(Base, Base), VectorSubtract(One, VectorMultiply(Two, Blend))));
+			const VectorRegister4Float Light = VectorAdd(
+				VectorMultiply(VectorSqrt(Base), VectorSubtract(VectorMultiply(Two, Blend), One)),
+				VectorMultiply(Two, VectorMultiply(Base, VectorSubtract(One, Blend))));
+			return LerpColor(Dark, Light, Step(GlobalVectorConstants::FloatOneHalf, Blend));
+		}
+		case 3: // Hard light
+			return OverlayBlend(Base, Blend, Blend);
+		case 4: // Lighten
+			return VectorMax(Base, Blend);
+		default: // Multiply
+			return VectorMultiply(Base, Blend);
+	}
+}
+
+// Tint or scene color, saturation and highlight protection, shared by the bloom and soft focus branches
+static VectorRegister4Float GradeBloom(const VectorRegister4Float& BloomSample, const FClassicBloomCpuCompositeParams& Params)
+{
+	const bool bUseSceneColor = Params.BloomTint.W > 0.5f;
+	VectorRegister4Float Color = bUseSceneColor ? BloomSample : VectorMultiply(BloomSample, VectorLoad(&Params.BloomTint.X));
+	Color = AdjustSaturation(Color, Params.Saturation);
+	if (Params.bProtectHighlights)
+	{
+		Color = ProtectHighlights(Color, Params.HighlightProtection);
+	}
+	return Color;
+}
+
+void FClassicBloomCpuKernels::Composite(const FClassicBloomImage& Scene, const FClassicBloomImage& Bloom, const FClassicBloomCpuCompositeParams& Params, FClassicBloomImage& Out)
+{
+	check(Scene.GetSize() == Out.GetSize());
+
+	const FVector2f InvSize(1.0f / Out.Width, 1.0f / Out.Height);
+	const bool bHasBloom = Params.BloomIntensity > 0.0f;
+	const bool bHasSoftFocus = Params.SoftFocusIntensity > 0.0f;
+
+	ForEachPixel(Out, [&](const FVector2f& SvPosition)
+	{
+		const FVector2f UV = SvPosition * InvSize;
+		const VectorRegister4Float SceneColor = SampleBilinear(Scene, UV);
+		const VectorRegister4Float BloomSample = SampleBilinear(Bloom, UV);
+
+		float BloomScale = 1.0f;
+		if (Params.bUseAdaptiveScaling)
+		{
+			const float SceneBrightness = Dot3(SceneColor, ClassicBloomCpuLumaWeights) + 0.001f;
+			const float AdaptiveScale = FMath::Clamp(1.0f / (1.0f + SceneBrightness * 2.0f), 0.0f, 1.0f);
+			BloomScale = FMath::Lerp(0.7f, 1.0f, AdaptiveScale);
+		}
+		else if (Params.bIsGameWorld)
+		{
+			BloomScale = Params.GameModeBloomScale;
+		}
+
+		// Debug visualizations
+		if (Params.bShowBloomOnly)
+		{
+			return VectorMultiply(BloomSample, VectorSetFloat1(Params.BloomIntensity * 10.0f));
+		}
+		if (Params.bShowGammaCompensation)
+		{
+			return VectorMultiply(SceneColor, VectorSetFloat1(2.0f));
+		}
+
+		if (bHasSoftFocus && bHasBloom)
+		{
+			// Soft focus overlay first, then the graded bloom with the selected blend mode on top
+			const VectorRegister4Float SoftGlow = VectorMultiply(BloomSample, VectorSetFloat1(Params.SoftFocusIntensity * Params.SoftFocusParams.X * BloomScale));
+			const VectorRegister4Float SoftFocusResult = OverlayBlend(SceneColor, SoftGlow, SceneColor);
+			const VectorRegister4Float Result = LerpColor(SceneColor, SoftFocusResult, VectorSetFloat1(FMath::Clamp(Params.SoftFocusIntensity * Params.SoftFocusParams.Y, 0.0f, 1.0f)));
+
+			const VectorRegister4Float BloomEffect = VectorMultiply(GradeBloom(BloomSample, Params), VectorSetFloat1(Params.BloomIntensity * BloomScale));
+			return ApplyBloomBlendMode(Result, BloomEffect, Params.BlendMode);
+		}
+		if (bHasSoftFocus)
+		{
+			const VectorRegister4Float SoftFocusEffect = VectorMultiply(GradeBloom(BloomSample, Params), VectorSetFloat1(Params.SoftFocusIntensity * BloomScale));
+			return ApplyBloomBlendMode(SceneColor, SoftFocusEffect, Params.BlendMode);
+		}
+		if (bHasBloom)
+		{
+			const VectorRegister4Float BloomEffect = VectorMultiply(GradeBloom(BloomSample, Params), VectorSetFloat1(Params.BloomIntensity * BloomScale));
+			return ApplyBloomBlendMode(SceneColor, BloomEffect, Params.BlendMode);
+		}
+		return SceneColor;
+	});
+}
@@ -0,0 +1,39 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomFFT.h"
+
+void FClassicBloomFFT::Transform(TArrayView<FVector2f> Line, bool bInverse)
+{
+	const int32 Size = Line.Num();
+	check(FMath::IsPowerOfTwo(Size));
+	const int32 Log2Size = FMath::FloorLog2((uint32)Size);
+
+	for (int32 Index = 0; Index < Size; ++Index)
+	{
+		const int32 Reversed = (int32)(ReverseBits((uint32)Index) >> (32 - Log2Size));
+		if (Index < Reversed)
+		{
+			Swap(Line[Index], Line[Reversed]);
+		}
+	}
+
+	const float Sign = bInverse ? 1.0f : -1.0f;
+	for (int32 HalfSize = 1; HalfSize < Size; HalfSize <<= 1)
+	{
+		for (int32 Butterfly = 0; Butterfly < Size / 2; ++Butterfly)
+		{
+			const int32 K = Butterfly & (HalfSize - 1);
+			const int32 Index0 = (Butterfly - K) * 2 + K;
+			const int32 Index1 = Index0 + HalfSize;
+
+			float TwiddleSin, TwiddleCos;
+			FMath::SinCos(&TwiddleSin, &TwiddleCos, Sign * UE_PI * (float)K / (float)HalfSize);
+
+			const FVector2f A = Line[Index0];
+			const FVector2f B = Line[Index1];
+			const FVector2f BTwiddled(B.X * TwiddleCos - B.Y * TwiddleSin, B.X * TwiddleSin + B.Y * TwiddleCos);
+			Line[Index0] = A + BTwiddled;
+			Line[Index1] = A - BTwiddled;
+		}
+	}
+}
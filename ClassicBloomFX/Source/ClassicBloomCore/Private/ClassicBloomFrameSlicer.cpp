@@ -0,0 +1,78 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomFrameSlicer.h"
+#include "Algo/StableSort.h"
+
+FClassicBloomFrameSlicer::FClassicBloomFrameSlicer(float FixedCost, TConstArrayView<float> SliceCosts, float MaxFrameFraction)
+{
+	check(SliceCosts.Num() <= MaxSlices);
+
+	float TotalCost = FMath::Max(FixedCost, 0.0f);
+	for (float Cost : SliceCosts)
+	{
+		TotalCost += FMath::Max(Cost, 0.0f);
+	}
+	if (SliceCosts.Num() == 0 || TotalCost <= 0.0f)
+	{
+		return;
+	}
+
+	// Largest slice first; the stable sort keeps equal slices in index order
+	TArray<int32, TInlineAllocator<MaxSlices>> Order;
+	for (int32 Index = 0; Index < SliceCosts.Num(); ++Index)
+	{
+		Order.Add(Index);
+	}
+	Algo::StableSort(Order, [&SliceCosts](int32 A, int32 B) { return SliceCosts[A] > SliceCosts[B]; });
+
+	const float Budget = MaxFrameFraction * TotalCost;
+	float BestPeak = MAX_flt;
+	const int32 MaxCandidatePeriod = FMath::Min(MaxPeriod, SliceCosts.Num());
+	for (int32 CandidatePeriod = 1; CandidatePeriod <= MaxCandidatePeriod; ++CandidatePeriod)
+	{
+		float FrameCosts[MaxPeriod];
+		uint32 Masks[MaxPeriod];
+		for (int32 Frame = 0; Frame < CandidatePeriod; ++Frame)
+		{
+			FrameCosts[Frame] = FMath::Max(FixedCost, 0.0f);
+			Masks[Frame] = 0;
+		}
+
+		for (int32 Slice : Order)
+		{
+			int32 Cheapest = 0;
+			for (int32 Frame = 1; Frame < CandidatePeriod; ++Frame)
+			{
+				if (FrameCosts[Frame] < FrameCosts[Cheapest])
+				{
+					Cheapest = Frame;
+				}
+			}
+			FrameCosts[Cheapest] += FMath::Max(SliceCosts[Slice], 0.0f);
+			Masks[Cheapest] |= 1u << Slice;
+		}
+
+		float Peak = 0.0f;
+		for (int32 Frame = 0; Frame < CandidatePeriod; ++Frame)
+		{
+			Peak = FMath::Max(Peak, FrameCosts[Frame]);
+		}
+
+		// A longer period only pays off when it lowers the peak
+		if (Peak < BestPeak)
+		{
+			BestPeak = Peak;
+			Period = CandidatePeriod;
+			for (int32 Frame = 0; Frame < CandidatePeriod; ++Frame)
+			{
+				FrameMasks[Frame] = Masks[Frame];
+			}
+		}
+		if (Peak <= Budget)
+		{
+			break;
+		}
+	}
+
+	PeakFraction = BestPeak / TotalCost;
+}
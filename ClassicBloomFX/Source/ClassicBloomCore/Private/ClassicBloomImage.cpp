@@ -0,0 +1,30 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomImage.h"
+
+void FClassicBloomImage::Resize(int32 InWidth, int32 InHeight)
+{
+	Width = FMath::Max(InWidth, 0);
+	Height = FMath::Max(InHeight, 0);
+	Pixels.SetNumZeroed(Width * Height);
+}
+
+void FClassicBloomImage::SetFromLinearColors(int32 InWidth, int32 InHeight, TConstArrayView<FLinearColor> Colors)
+{
+	check(Colors.Num() == InWidth * InHeight);
+
+	Resize(InWidth, InHeight);
+	for (int32 Index = 0; Index < Colors.Num(); ++Index)
+	{
+		Pixels[Index] = FVector4f(Colors[Index].R, Colors[Index].G, Colors[Index].B, 1.0f);
+	}
+}
+
+void FClassicBloomImage::ToLinearColors(TArray<FLinearColor>& OutColors) const
+{
+	OutColors.SetNumUninitialized(Pixels.Num());
+	for (int32 Index = 0; Index < Pixels.Num(); ++Index)
+	{
+		OutColors[Index] = FLinearColor(Pixels[Index].X, Pixels[Index].Y, Pixels[Index].Z, 1.0f);
+	}
+}
@@ -0,0 +1,92 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomBudgetController.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClassicBloomBudgetControllerTest
+{
+	// Simulated GPU: each level costs this share of the one above, timings land this many frames late
+	static constexpr float LevelCostRatio = 0.75f;
+	static constexpr int32 ReadbackLatency = 3;
+	static constexpr float Noise = 0.05f;
+
+	static constexpr float TargetMs = 1.0f;
+	static constexpr int32 NumLevels = 8;
+
+	// Level 0 cost per phase: under budget, a load step well over it, back under
+	static constexpr float PhaseBaseMs[] = { 0.6f, 2.0f, 0.6f };
+	static constexpr int32 PhaseFrames = 300;
+
+	// Frames a phase may take to reach its level
+	static constexpr int32 SettleFrames = 100;
+
+	static float GetLevelCostMs(float BaseMs, int32 Level)
+	{
+		return BaseMs * FMath::Pow(LevelCostRatio, (float)Level);
+	}
+
+	// Cheapest level of the ladder is not the goal: the best quality that fits the target is
+	static int32 GetExpectedLevel(float BaseMs)
+	{
+		int32 Level = 0;
+		while (Level < NumLevels - 1 && GetLevelCostMs(BaseMs, Level) > TargetMs)
+		{
+			++Level;
+		}
+		return Level;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClassicBloomBudgetControllerStepTest, "ClassicBloom.Core.BudgetController.StepResponse",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FClassicBloomBudgetControllerStepTest::RunTest(const FString& Parameters)
+{
+	using namespace ClassicBloomBudgetControllerTest;
+
+	FClassicBloomBudgetController Controller;
+	Controller.SetTargetMs(TargetMs);
+	Controller.SetNumLevels(NumLevels);
+
+	FRandomStream Random(0x0B100D);
+	TArray<float> InFlightMs;
+
+	for (int32 Phase = 0; Phase < UE_ARRAY_COUNT(PhaseBaseMs); ++Phase)
+	{
+		const float BaseMs = PhaseBaseMs[Phase];
+		int32 LevelChangesAfterSettling = 0;
+		int32 SettledLevel = INDEX_NONE;
+
+		for (int32 Frame = 0; Frame < PhaseFrames; ++Frame)
+		{
+			// The frame renders at the current level; the controller sees its time a few frames later
+			const int32 PreviousLevel = Controller.GetLevel();
+			InFlightMs.Add(GetLevelCostMs(BaseMs, PreviousLevel) * (1.0f + Noise * Random.FRandRange(-1.0f, 1.0f)));
+			if (InFlightMs.Num() > ReadbackLatency)
+			{
+				Controller.AddSample(InFlightMs[0]);
+				InFlightMs.RemoveAt(0);
+			}
+
+			if (Frame == SettleFrames)
+			{
+				SettledLevel = Controller.GetLevel();
+			}
+			else if (Frame > SettleFrames && Controller.GetLevel() != PreviousLevel)
+			{
+				++LevelChangesAfterSettling;
+			}
+		}
+
+		const int32 ExpectedLevel = GetExpectedLevel(BaseMs);
+		TestEqual(FString::Printf(TEXT("Phase %d (%.2f ms at level 0) settles at the best level within budget"), Phase, BaseMs), SettledLevel, ExpectedLevel);
+		TestEqual(FString::Printf(TEXT("Phase %d (%.2f ms at level 0) holds its level once settled"), Phase, BaseMs), LevelChangesAfterSettling, 0);
+	}
+
+	return true;
+}
+
+#endif
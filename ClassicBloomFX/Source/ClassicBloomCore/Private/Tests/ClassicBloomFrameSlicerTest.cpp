@@ -0,0 +1,77 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomFrameSlicer.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClassicBloomFrameSlicerTest
+{
+	// Frames of the period each slice runs on; every slice has to run exactly once per period
+	static TArray<int32> GetSliceFrames(const FClassicBloomFrameSlicer& Slicer, int32 NumSlices)
+	{
+		TArray<int32> Frames;
+		for (int32 Slice = 0; Slice < NumSlices; ++Slice)
+		{
+			int32 Frame = INDEX_NONE;
+			for (int32 Index = 0; Index < Slicer.GetPeriod(); ++Index)
+			{
+				if (Slicer.GetSliceMask(Index) & (1u << Slice))
+				{
+					Frame = (Frame == INDEX_NONE) ? Index : MAX_int32;
+				}
+			}
+			Frames.Add(Frame);
+		}
+		return Frames;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClassicBloomFrameSlicerScheduleTest, "ClassicBloom.Core.FrameSlicer.Schedule",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FClassicBloomFrameSlicerScheduleTest::RunTest(const FString& Parameters)
+{
+	using namespace ClassicBloomFrameSlicerTest;
+
+	// One slice: there is nothing to spread it against, so it runs every frame
+	{
+		const float SliceCosts[] = { 1.0f };
+		const FClassicBloomFrameSlicer Slicer(1.0f, SliceCosts, 0.6f);
+		TestEqual(TEXT("1 slice: period"), Slicer.GetPeriod(), 1);
+		TestTrue(TEXT("1 slice: runs every frame"), (Slicer.GetSliceMask(0) & 1u) != 0);
+		TestEqual(TEXT("1 slice: peak is the full chain"), Slicer.GetPeakFraction(), 1.0f, KINDA_SMALL_NUMBER);
+	}
+
+	// Two equal slices: one per frame fits the budget
+	{
+		const float SliceCosts[] = { 1.0f, 1.0f };
+		const FClassicBloomFrameSlicer Slicer(1.0f, SliceCosts, 0.7f);
+		TestEqual(TEXT("2 slices: period"), Slicer.GetPeriod(), 2);
+		TestTrue(TEXT("2 slices: one slice per frame"), GetSliceFrames(Slicer, 2) == TArray<int32>({ 0, 1 }));
+		TestEqual(TEXT("2 slices: peak"), Slicer.GetPeakFraction(), 2.0f / 3.0f, KINDA_SMALL_NUMBER);
+		TestTrue(TEXT("2 slices: schedule repeats"), Slicer.GetSliceMask(2) == Slicer.GetSliceMask(0));
+	}
+
+	// Unbalanced: the large slice gets a frame to itself, the small ones share the other
+	{
+		const float SliceCosts[] = { 1.0f, 4.0f, 1.0f, 1.0f, 1.0f };
+		const FClassicBloomFrameSlicer Slicer(0.0f, SliceCosts, 0.5f);
+		TestEqual(TEXT("Unbalanced: period"), Slicer.GetPeriod(), 2);
+		TestTrue(TEXT("Unbalanced: large slice alone"), GetSliceFrames(Slicer, 5) == TArray<int32>({ 1, 0, 1, 1, 1 }));
+		TestEqual(TEXT("Unbalanced: peak"), Slicer.GetPeakFraction(), 0.5f, KINDA_SMALL_NUMBER);
+	}
+
+	// Unbalanced past the budget: a longer period that cannot lower the peak is not taken
+	{
+		const float SliceCosts[] = { 6.0f, 1.0f, 1.0f };
+		const FClassicBloomFrameSlicer Slicer(0.0f, SliceCosts, 0.25f);
+		TestEqual(TEXT("Unreachable budget: period"), Slicer.GetPeriod(), 2);
+		TestTrue(TEXT("Unreachable budget: large slice alone"), GetSliceFrames(Slicer, 3) == TArray<int32>({ 0, 1, 1 }));
+		TestEqual(TEXT("Unreachable budget: lowest peak"), Slicer.GetPeakFraction(), 0.75f, KINDA_SMALL_NUMBER);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,43 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Separable Gaussian of a given sigma as 5, 9 or 13 symmetric taps. Adjacent taps on each side are merged
+ * into one bilinear fetch at their weighted position, so the kernel costs 3, 5 or 7 fetches. Taps are one
+ * texel apart, which makes the merge exact, unless the sigma needs them spread further to be covered.
+ * Shared by the blur shaders (BLUR_TAPS permutation) and the CPU kernels so both weight texels alike.
+ */
+struct CLASSICBLOOMCORE_API FClassicBloomBlurKernel
+{
+	static constexpr int32 MaxFetchPairs = 3;
+
+	/** Sigmas from the center to the outermost tap */
+	static constexpr float CoveredSigmas = 2.5f;
+
+	float CenterWeight = 1.0f;
+	float Offsets[MaxFetchPairs] = { 0.0f, 0.0f, 0.0f };  // Texels from the center, one fetch on each side
+	float Weights[MaxFetchPairs] = { 0.0f, 0.0f, 0.0f };
+	int32 NumFetchPairs = 1;
+	float TapSpacing = 1.0f;
+
+	/** Kernel for Sigma (texels) with NumTaps taps, rounded to the nearest of 5, 9 and 13 */
+	static FClassicBloomBlurKernel Build(float Sigma, int32 NumTaps);
+
+	/** The supported tap count nearest to NumTaps */
+	static int32 SnapTapCount(int32 NumTaps)
+	{
+		return NumTaps <= 7 ? 5 : (NumTaps <= 11 ? 9 : 13);
+	}
+
+	int32 GetNumTaps() const { return 4 * NumFetchPairs + 1; }
+
+	/** Texels one pass reads on each side of a texel, bilinear neighbor included */
+	int32 GetReach() const { return FMath::CeilToInt(Offsets[NumFetchPairs - 1]) + 1; }
+
+	/** Shader constants: x = center weight, yzw = weights (or offsets) of the fetch pairs */
+	FVector4f GetShaderWeights() const { return FVector4f(CenterWeight, Weights[0], Weights[1], Weights[2]); }
+	FVector4f GetShaderOffsets() const { return FVector4f(0.0f, Offsets[0], Offsets[1], Offsets[2]); }
+};
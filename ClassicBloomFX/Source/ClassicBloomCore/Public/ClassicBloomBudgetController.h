@@ -0,0 +1,135 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** The parameters a quality ladder lowers; each of them cuts GPU time as it falls */
+struct FClassicBloomQualityLevel
+{
+	int32 DownsampleDivisor = 2;
+	int32 BlurPasses = 1;
+	int32 KawaseMipCount = 5;
+	int32 GlareStreakCount = 6;
+
+	bool operator==(const FClassicBloomQualityLevel& Other) const
+	{
+		return DownsampleDivisor == Other.DownsampleDivisor && BlurPasses == Other.BlurPasses
+			&& KawaseMipCount == Other.KawaseMipCount && GlareStreakCount == Other.GlareStreakCount;
+	}
+};
+
+/** Which parameters of a quality level affect the cost of a bloom mode */
+enum class EClassicBloomQualityAxes : uint8
+{
+	None = 0,
+	DownsampleDivisor = 1 << 0,
+	BlurPasses = 1 << 1,
+	KawaseMipCount = 1 << 2,
+	GlareStreakCount = 1 << 3,
+};
+ENUM_CLASS_FLAGS(EClassicBloomQualityAxes);
+
+/**
+ * Quality levels from the authored parameters (level 0) down to the cheapest ones. Every level lowers one
+ * parameter by one step, taking the enabled axes in turn, so quality degrades evenly instead of exhausting one
+ * parameter first. Axes stop at their floor; the ladder ends when every enabled axis has reached it.
+ */
+class CLASSICBLOOMCORE_API FClassicBloomQualityLadder
+{
+public:
+	static constexpr int32 MaxLevels = 16;
+
+	static constexpr int32 MaxDownsampleDivisor = 8;
+	static constexpr int32 MinBlurPasses = 1;
+	static constexpr int32 MinKawaseMipCount = 3;
+	static constexpr int32 MinGlareStreakCount = 2;
+
+	/** The authored level only */
+	FClassicBloomQualityLadder() { Levels.Add(FClassicBloomQualityLevel()); }
+
+	FClassicBloomQualityLadder(const FClassicBloomQualityLevel& Authored, EClassicBloomQualityAxes Axes);
+
+	int32 Num() const { return Levels.Num(); }
+
+	/** Level clamped to the ladder, so a controller sized for a longer ladder still gets its cheapest level */
+	const FClassicBloomQualityLevel& GetLevel(int32 Level) const { return Levels[FMath::Clamp(Level, 0, Levels.Num() - 1)]; }
+
+private:
+	TArray<FClassicBloomQualityLevel, TInlineAllocator<MaxLevels>> Levels;
+};
+
+/** Tuning of FClassicBloomBudgetController; errors are relative to the target (0.5 = 50% over budget) */
+struct FClassicBloomBudgetControllerConfig
+{
+	float TargetMs = 1.0f;
+
+	float ProportionalGain = 1.0f;
+	float IntegralGain = 0.25f;
+	float DerivativeGain = 0.1f;
+
+	/** Controller output stepping one level down (over budget) or, negated, one level up */
+	float StepThreshold = 0.5f;
+
+	/** Samples ignored after a level change; timestamps read back a few frames late still measure the old level */
+	int32 SettleSamples = 4;
+
+	/** Share of each new sample in the smoothed time of the current level */
+	float SmoothingAlpha = 0.25f;
+};
+
+/**
+ * GPU time budget controller: turns measured frame times into a quality level (0 = authored quality, higher is
+ * cheaper). A PID on the relative error decides when to move, one level at a time, and integrates nothing while
+ * the timings in flight still belong to the previous level.
+ *
+ * Moving back up needs more than a negative error: the controller remembers how much each step it took down
+ * saved, and only returns to a level when the current time scaled by that saving fits the target. Without this a
+ * frame time between two levels' costs would flip between them forever.
+ *
+ * Works on the numbers it is fed only, so a synthetic timing trace always gives the same levels.
+ */
+class CLASSICBLOOMCORE_API FClassicBloomBudgetController
+{
+public:
+	static constexpr int32 MaxLevels = FClassicBloomQualityLadder::MaxLevels;
+
+	explicit FClassicBloomBudgetController(const FClassicBloomBudgetControllerConfig& InConfig = FClassicBloomBudgetControllerConfig());
+
+	/** A new target restarts the integral; the level and the learned step savings are kept */
+	void SetTargetMs(float TargetMs);
+
+	/** Levels available; the current level is clamped into them */
+	void SetNumLevels(int32 NumLevels);
+
+	/** Feed the GPU time of one frame, oldest first; returns the level to render at */
+	int32 AddSample(float GpuMs);
+
+	int32 GetLevel() const { return Level; }
+
+	/** Smoothed time of the current level (zero until it has settled) */
+	float GetSmoothedMs() const { return SmoothedMs; }
+
+	/** Back to level 0, forgetting everything learned (the number of levels is kept) */
+	void Reset();
+
+private:
+	void ChangeLevel(int32 NewLevel);
+
+	FClassicBloomBudgetControllerConfig Config;
+	int32 NumLevels = 1;
+	int32 Level = 0;
+
+	int32 SamplesSinceChange = 0;
+	float SmoothedMs = 0.0f;
+	float Integral = 0.0f;
+	float PreviousError = 0.0f;
+	bool bHasPreviousError = false;
+
+	// Cost of level i + 1 relative to level i, measured the last time the controller stepped from i to i + 1 (zero = unknown)
+	float StepCostRatios[MaxLevels] = {};
+
+	// Step down waiting for the new level to settle before its saving is measured
+	int32 PendingStepFrom = INDEX_NONE;
+	float PendingStepFromMs = 0.0f;
+};
@@ -0,0 +1,37 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClassicBloomBlurKernel.h"
+
+/**
+ * Tile and groupshared-memory limits of the compute blur (ClassicBloomBlurCompute.usf). The shader is compiled
+ * with these values, and the pass planner uses them to decide which blurs fit in one dispatch per axis.
+ */
+struct FClassicBloomComputeBlurLimits
+{
+	static constexpr int32 ThreadGroupSize = 64;
+	static constexpr int32 TileSize = 256;
+	static constexpr int32 MaxApron = 128; // Apron * Iterations per dispatch, bounds the groupshared cache
+
+	/** Texels one blur pass reaches on each side of a texel (outermost fetch plus its bilinear neighbor) */
+	static int32 GetApron(const FClassicBloomBlurKernel& Kernel)
+	{
+		return Kernel.GetReach();
+	}
+
+	/** Blur passes along one axis that fit in a single dispatch (0 when one pass does not fit) */
+	static int32 GetMaxIterations(const FClassicBloomBlurKernel& Kernel)
+	{
+		return MaxApron / GetApron(Kernel);
+	}
+};
+
+/** Limits of the single-dispatch Kawase downsample chain (ClassicBloomKawaseChain.usf) */
+struct FClassicBloomKawaseChainLimits
+{
+	static constexpr int32 MaxMips = 8;
+	static constexpr int32 TileSize = 8;
+	static constexpr int32 MaxWorkItems = 32; // Per-group tile stack: at most 1 + 3 per mip level
+};
@@ -0,0 +1,75 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClassicBloomImage.h"
+#include "ClassicBloomBlurKernel.h"
+
+/** Constants of CompositeBloomPS (same meaning and encoding as the shader parameters) */
+struct FClassicBloomCpuCompositeParams
+{
+	float BloomIntensity = 1.0f;
+	FVector4f BloomTint = FVector4f(1.0f, 1.0f, 1.0f, 1.0f); // Alpha: 1 = use scene color, 0 = use tint
+	int32 BlendMode = 0;                                     // 0=Screen, 1=Overlay, 2=SoftLight, 3=HardLight, 4=Lighten, 5=Multiply
+	float Saturation = 1.0f;
+	bool bProtectHighlights = false;
+	float HighlightProtection = 0.5f;
+	float SoftFocusIntensity = 0.0f;
+	FVector4f SoftFocusParams = FVector4f(0.5f, 0.33f, 0.4f, 0.25f);
+	bool bUseAdaptiveScaling = false;
+	bool bShowBloomOnly = false;
+	bool bShowGammaCompensation = false;
+	bool bIsGameWorld = true;
+	float GameModeBloomScale = 1.0f;
+};
+
+/**
+ * CPU versions of the ClassicBloom pixel shaders, one function per shader entry point (the FFT passes per compute entry point).
+ * Each output pixel is computed exactly as the shader computes it for SvPosition = pixel + 0.5, with a
+ * bilinear clamp sampler, so a pass plan replayed here matches the GPU up to render target precision.
+ * Pixels are processed one float4 SIMD register at a time and rows are split across worker threads.
+ * Outputs must already be sized; they play the role of the pass render target.
+ */
+struct CLASSICBLOOMCORE_API FClassicBloomCpuKernels
+{
+	/** BrightPassPS: SourceUV = (pixel + 0.5) * UVScale + UVBias */
+	static void BrightPass(const FClassicBloomImage& Source, FVector2f UVScale, FVector2f UVBias, float Threshold, FClassicBloomImage& Out);
+
+	/** GaussianBlurPS: the center and Kernel's bilinear fetch pairs along Direction */
+	static void GaussianBlur(const FClassicBloomImage& Source, FVector2f Direction, const FClassicBloomBlurKernel& Kernel, FClassicBloomImage& Out);
+
+	/** GlareStreakPS: 16 exponentially weighted samples each way along every axis (xy = direction, z = weight), added onto Out when bAdditive.
+	 *  The sample center is SourceUV = (dot(UVFromPositionU, (pixel + 0.5, 1)), dot(UVFromPositionV, (pixel + 0.5, 1))) */
+	static void GlareStreak(const FClassicBloomImage& Source, const FVector3f& UVFromPositionU, const FVector3f& UVFromPositionV, TConstArrayView<FVector4f> Axes, float Length, float Falloff, bool bAdditive, FClassicBloomImage& Out);
+
+	/** GlareStreakResolvePS for one streak buffer: bilinear sample at the same affine UV mapping, added onto Out when bAdditive */
+	static void GlareStreakResolve(const FClassicBloomImage& Buffer, const FVector3f& UVFromPositionU, const FVector3f& UVFromPositionV, bool bAdditive, FClassicBloomImage& Out);
+
+	/** GlareStreakStepPS: 4 taps at (TapStart + i) * Stride texels along Direction, added onto Out when bAdditive */
+	static void GlareStreakStep(const FClassicBloomImage& Source, FVector2f Direction, float Stride, float TapStart, const FVector4f& TapWeights, bool bAdditive, FClassicBloomImage& Out);
+
+	/** KawaseDownsamplePS: 13-tap filter; Karis average and threshold on mip 0 only */
+	static void KawaseDownsample(const FClassicBloomImage& Source, FVector2f UVScale, FVector2f UVBias, int32 MipLevel, float Threshold, float ThresholdKnee, FClassicBloomImage& Out);
+
+	/** KawaseUpsamplePS: tent filter of Source, added onto Out's contents when bAdditive (the in-place blend) */
+	static void KawaseUpsample(const FClassicBloomImage& Source, float FilterRadius, bool bAdditive, FClassicBloomImage& Out);
+
+	/** FFTForwardRowsCS on an image: row FFTs of Source's RGB zero padded to the spectrum width. SpectrumRG holds R and G
+	 *  as complex pairs, SpectrumB holds B; rows at or past Source's height are left alone (the columns pass reads zeros) */
+	static void FFTForwardRows(const FClassicBloomImage& Source, FClassicBloomImage& SpectrumRG, FClassicBloomImage& SpectrumB);
+
+	/** FFTForwardRowsCS on the kernel image: Kernel bilinear sampled KernelSizeInTexels spectrum texels wide, centered on
+	 *  texel (0, 0) with wrap-around and zero outside the image; every row of the spectrum is written */
+	static void FFTKernelRows(const FClassicBloomImage& Kernel, float KernelSizeInTexels, FClassicBloomImage& SpectrumRG, FClassicBloomImage& SpectrumB);
+
+	/** FFTColumnsCS in place: column FFTs of the first NumRows rows (the rest read as zero). With kernel spectra the columns
+	 *  are multiplied by the kernel, normalized by its DC term, and transformed back; only the first NumRows rows are written */
+	static void FFTColumns(int32 NumRows, const FClassicBloomImage* KernelRG, const FClassicBloomImage* KernelB, FClassicBloomImage& SpectrumRG, FClassicBloomImage& SpectrumB);
+
+	/** FFTInverseRowsCS: real part of the inverse row FFTs, clamped at zero, over Out's extent */
+	static void FFTInverseRows(const FClassicBloomImage& SpectrumRG, const FClassicBloomImage& SpectrumB, FClassicBloomImage& Out);
+
+	/** CompositeBloomPS over a whole image: Scene and Out share a size, Bloom is stretched over it */
+	static void Composite(const FClassicBloomImage& Scene, const FClassicBloomImage& Bloom, const FClassicBloomCpuCompositeParams& Params, FClassicBloomImage& Out);
+};
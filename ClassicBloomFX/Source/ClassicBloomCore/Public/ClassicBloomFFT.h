@@ -0,0 +1,19 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Radix-2 FFT with the butterflies of ClassicBloomFFT.usf: bit-reversed load, in place, unnormalized in both
+ * directions. The CPU convolution reference uses it so its spectra accumulate rounding like the GPU's.
+ */
+struct CLASSICBLOOMCORE_API FClassicBloomFFT
+{
+	/** Transform lengths the FFT_SIZE shader permutations cover */
+	static constexpr int32 MinSize = 64;
+	static constexpr int32 MaxSize = 1024;
+
+	/** Transform Line (power-of-two length, natural order, x = real, y = imaginary) in place */
+	static void Transform(TArrayView<FVector2f> Line, bool bInverse);
+};
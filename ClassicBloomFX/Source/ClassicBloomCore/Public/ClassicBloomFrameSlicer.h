@@ -0,0 +1,43 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Frame slicing policy: spreads work whose result may be reused for a few frames (slices) over a repeating
+ * period, so that no frame costs more than a fraction of the full chain. Works on relative costs only and has
+ * no state besides the schedule, so the same inputs always give the same frames.
+ *
+ * The period is the shortest one meeting the budget; slices are balanced over its frames largest first, each
+ * onto the cheapest frame so far (ties go to the earlier frame and the lower slice index). Without a period
+ * meeting the budget, the one with the lowest peak is used.
+ */
+class CLASSICBLOOMCORE_API FClassicBloomFrameSlicer
+{
+public:
+	/** Slices per schedule (bits of a frame mask) */
+	static constexpr int32 MaxSlices = 32;
+
+	/** Longest period; a slice's result is at most this many frames old */
+	static constexpr int32 MaxPeriod = 4;
+
+	/** Every slice on every frame */
+	FClassicBloomFrameSlicer() = default;
+
+	/** FixedCost runs every frame; SliceCosts[i] is the cost of slice i; MaxFrameFraction caps a frame relative to all of it */
+	FClassicBloomFrameSlicer(float FixedCost, TConstArrayView<float> SliceCosts, float MaxFrameFraction);
+
+	int32 GetPeriod() const { return Period; }
+
+	/** Bit i set: slice i runs on frame FrameIndex (frames count up from any start) */
+	uint32 GetSliceMask(uint32 FrameIndex) const { return FrameMasks[FrameIndex % (uint32)Period]; }
+
+	/** Cost of the most expensive frame of the period, as a fraction of running everything */
+	float GetPeakFraction() const { return PeakFraction; }
+
+private:
+	int32 Period = 1;
+	uint32 FrameMasks[MaxPeriod] = { ~0u, ~0u, ~0u, ~0u };
+	float PeakFraction = 1.0f;
+};
@@ -0,0 +1,32 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Linear float image used by the CPU bloom kernels.
+ * One RGBA float4 per pixel (alpha is carried but ignored) so each pixel fills one SIMD register.
+ */
+struct CLASSICBLOOMCORE_API FClassicBloomImage
+{
+	int32 Width = 0;
+	int32 Height = 0;
+	TArray<FVector4f> Pixels;
+
+	FClassicBloomImage() = default;
+	FClassicBloomImage(int32 InWidth, int32 InHeight) { Resize(InWidth, InHeight); }
+
+	/** Reallocate to the given size; contents are zeroed */
+	void Resize(int32 InWidth, int32 InHeight);
+
+	FIntPoint GetSize() const { return FIntPoint(Width, Height); }
+	bool IsEmpty() const { return Width <= 0 || Height <= 0; }
+
+	FVector4f& At(int32 X, int32 Y) { return Pixels[Y * Width + X]; }
+	const FVector4f& At(int32 X, int32 Y) const { return Pixels[Y * Width + X]; }
+
+	/** Copy from / to linear color arrays (Width * Height entries, row-major) */
+	void SetFromLinearColors(int32 InWidth, int32 InHeight, TConstArrayView<FLinearColor> Colors);
+	void ToLinearColors(TArray<FLinearColor>& OutColors) const;
+};
@@ -17,7 +17,8 @@ public class ClassicBloomFX : ModuleRules
 				"RenderCore",
 				"Renderer",
 				"RHI",
-				"Projects"
+				"Projects",
+				"ClassicBloomCore"
 			}
 		);
 
@@ -25,10 +26,19 @@ public class ClassicBloomFX : ModuleRules
 			new string[]
 			{
 				"Slate",
-				"SlateCore"
+				"SlateCore",
+				"ImageCore",
+				"Json",
+				"JsonUtilities"
 			}
 		);
 
+		// Kernel spectra are stored in the derived data cache in editor builds
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("DerivedDataCache");
+		}
+
 		// Access to private Renderer headers for FViewInfo
 		PrivateIncludePaths.AddRange(
 			new string[]
@@ -2,6 +2,8 @@
 
 #include "BloomFXComponent.h"
 #include "ClassicBloomSubsystem.h"
+#include "ClassicBloomRenderSettings.h"
+#include "ClassicBloomTrace.h"
 #include "Engine/World.h"
 
 UBloomFXComponent::UBloomFXComponent()
@@ -50,7 +52,7 @@ void UBloomFXComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAct
 		
 		if (bEnableDebugLogging)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("ClassicBloom: Manual viewport rect reinitialize triggered"));
+			UE_LOG(LogClassicBloom, Log, TEXT("Manual viewport rect reinitialize triggered"));
 		}
 	}
 	
@@ -69,7 +71,7 @@ void UBloomFXComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAct
 			
 			if (bEnableDebugLogging)
 			{
-				UE_LOG(LogTemp, Log, TEXT("ClassicBloom: Auto viewport rect reinitialize (interval: %.2f seconds)"), ReinitializeInterval);
+				UE_LOG(LogClassicBloom, Log, TEXT("Auto viewport rect reinitialize (interval: %.2f seconds)"), ReinitializeInterval);
 			}
 		}
 	}
@@ -80,8 +82,112 @@ void UBloomFXComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAct
 	}
 }
 
+void UBloomFXComponent::Activate(bool bReset)
+{
+	Super::Activate(bReset);
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UClassicBloomSubsystem* Subsystem = World->GetSubsystem<UClassicBloomSubsystem>())
+		{
+			Subsystem->NotifyBloomComponentChanged(this);
+		}
+	}
+}
+
+void UBloomFXComponent::Deactivate()
+{
+	Super::Deactivate();
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UClassicBloomSubsystem* Subsystem = World->GetSubsystem<UClassicBloomSubsystem>())
+		{
+			Subsystem->NotifyBloomComponentChanged(this);
+		}
+	}
+}
+
+void UBloomFXComponent::MarkBloomSettingsDirty()
+{
+	UpdateRenderSettings();
+}
+
+void UBloomFXComponent::BeginBloomSettingsBatch()
+{
+	++SettingsBatchDepth;
+}
+
+void UBloomFXComponent::EndBloomSettingsBatch()
+{
+	if (SettingsBatchDepth > 0 && --SettingsBatchDepth == 0)
+	{
+		UpdateRenderSettings();
+	}
+}
+
+void UBloomFXComponent::SetBloomIntensity(float NewIntensity)
+{
+	BloomIntensity = NewIntensity;
+	UpdateRenderSettings();
+}
+
+void UBloomFXComponent::SetBloomThreshold(float NewThreshold)
+{
+	BloomThreshold = NewThreshold;
+	UpdateRenderSettings();
+}
+
+void UBloomFXComponent::SetBloomSize(float NewSize)
+{
+	BloomSize = NewSize;
+	UpdateRenderSettings();
+}
+
+void UBloomFXComponent::SetBloomTint(FLinearColor NewTint)
+{
+	BloomTint = NewTint;
+	UpdateRenderSettings();
+}
+
+void UBloomFXComponent::SetBloomSaturation(float NewSaturation)
+{
+	BloomSaturation = NewSaturation;
+	UpdateRenderSettings();
+}
+
+void UBloomFXComponent::UpdateRenderSettings()
+{
+	// Edits inside a batch are pushed once when the batch ends
+	if (SettingsBatchDepth > 0)
+	{
+		return;
+	}
+
+	FClassicBloomRenderSettings NewSettings = FClassicBloomRenderSettings::FromComponent(*this);
+	if (RenderSettings.IsValid() && *RenderSettings == NewSettings)
+	{
+		return;
+	}
+
+	RenderSettings = MakeShared<const FClassicBloomRenderSettings, ESPMode::ThreadSafe>(MoveTemp(NewSettings));
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UClassicBloomSubsystem* Subsystem = World->GetSubsystem<UClassicBloomSubsystem>())
+		{
+			Subsystem->NotifyBloomComponentChanged(this);
+		}
+	}
+}
+
 void UBloomFXComponent::RegisterWithSubsystem()
 {
+	if (!RenderSettings.IsValid())
+	{
+		RenderSettings = MakeShared<const FClassicBloomRenderSettings, ESPMode::ThreadSafe>(FClassicBloomRenderSettings::FromComponent(*this));
+	}
+
 	if (UWorld* World = GetWorld())
 	{
 		if (UClassicBloomSubsystem* Subsystem = World->GetSubsystem<UClassicBloomSubsystem>())
@@ -115,5 +221,14 @@ void UBloomFXComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyCh
 			BloomBlendMode = EBloomBlendMode::Overlay;
 		}
 	}
+
+	// View target components are routed differently by the subsystem, so register again
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UBloomFXComponent, bOnlyAffectViewTarget))
+	{
+		UnregisterFromSubsystem();
+		RegisterWithSubsystem();
+	}
+
+	UpdateRenderSettings();
 }
 #endif
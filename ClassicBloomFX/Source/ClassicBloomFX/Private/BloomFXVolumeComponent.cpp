@@ -0,0 +1,54 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "BloomFXVolumeComponent.h"
+#include "ClassicBloomSubsystem.h"
+#include "Engine/World.h"
+
+UBloomFXVolumeComponent::UBloomFXVolumeComponent()
+{
+	// Transform updates are needed to keep the spatial index in sync
+	bWantsOnUpdateTransform = true;
+}
+
+void UBloomFXVolumeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (ReportedBoxExtent != BoxExtent ||
+		ReportedPriority != Priority ||
+		ReportedBlendRadius != BlendRadius ||
+		ReportedBlendWeight != BlendWeight)
+	{
+		NotifyVolumeChanged();
+	}
+}
+
+void UBloomFXVolumeComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+	NotifyVolumeChanged();
+}
+
+#if WITH_EDITOR
+void UBloomFXVolumeComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	NotifyVolumeChanged();
+}
+#endif
+
+void UBloomFXVolumeComponent::NotifyVolumeChanged()
+{
+	ReportedBoxExtent = BoxExtent;
+	ReportedPriority = Priority;
+	ReportedBlendRadius = BlendRadius;
+	ReportedBlendWeight = BlendWeight;
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UClassicBloomSubsystem* Subsystem = World->GetSubsystem<UClassicBloomSubsystem>())
+		{
+			Subsystem->NotifyBloomComponentChanged(this);
+		}
+	}
+}
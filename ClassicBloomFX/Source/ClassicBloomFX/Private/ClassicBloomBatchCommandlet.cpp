@@ -0,0 +1,426 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomBatchCommandlet.h"
+#include "BloomFXComponent.h"
+#include "ClassicBloomCpuRenderer.h"
+#include "ClassicBloomRenderSettings.h"
+#include "ClassicBloomTrace.h"
+#include "Async/Async.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "ImageCore.h"
+#include "ImageUtils.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/Package.h"
+#include <atomic>
+
+// ============================================================================
+// Pipeline plumbing
+// ============================================================================
+
+/**
+ * Blocking FIFO with a fixed capacity: producers wait while it is full, consumers while it is empty.
+ * Close() wakes every consumer once the producers are done.
+ * Each condition has a manual-reset event that is only set or reset under the lock, so it is
+ * signaled exactly while the condition holds and every waiter wakes to check it again.
+ */
+template <typename ItemType>
+class TClassicBloomBoundedQueue
+{
+public:
+	explicit TClassicBloomBoundedQueue(int32 InCapacity)
+		: Capacity(FMath::Max(1, InCapacity))
+		, NotEmpty(FPlatformProcess::GetSynchEventFromPool(true))
+		, NotFull(FPlatformProcess::GetSynchEventFromPool(true))
+	{
+		NotFull->Trigger();
+	}
+
+	~TClassicBloomBoundedQueue()
+	{
+		FPlatformProcess::ReturnSynchEventToPool(NotEmpty);
+		FPlatformProcess::ReturnSynchEventToPool(NotFull);
+	}
+
+	void Push(ItemType&& Item)
+	{
+		for (;;)
+		{
+			{
+				FScopeLock Lock(&CriticalSection);
+				if (Items.Num() < Capacity)
+				{
+					Items.Add(MoveTemp(Item));
+					NotEmpty->Trigger();
+					if (Items.Num() == Capacity)
+					{
+						NotFull->Reset();
+					}
+					return;
+				}
+			}
+			NotFull->Wait();
+		}
+	}
+
+	/** False once the queue is closed and drained */
+	bool Pop(ItemType& OutItem)
+	{
+		for (;;)
+		{
+			{
+				FScopeLock Lock(&CriticalSection);
+				if (Items.Num() > 0)
+				{
+					OutItem = MoveTemp(Items[0]);
+					Items.RemoveAt(0, EAllowShrinking::No);
+					NotFull->Trigger();
+					if (Items.Num() == 0 && !bClosed)
+					{
+						NotEmpty->Reset();
+					}
+					return true;
+				}
+				if (bClosed)
+				{
+					return false;
+				}
+			}
+			NotEmpty->Wait();
+		}
+	}
+
+	void Close()
+	{
+		FScopeLock Lock(&CriticalSection);
+		bClosed = true;
+		NotEmpty->Trigger();
+	}
+
+private:
+	const int32 Capacity;
+	FCriticalSection CriticalSection;
+	TArray<ItemType> Items;
+	bool bClosed = false;
+	FEvent* NotEmpty;  // Set while there are items or the queue is closed
+	FEvent* NotFull;   // Set while there is room for another item
+};
+
+struct FClassicBloomBatchFrame
+{
+	FString Name;
+	FClassicBloomImage Image;
+};
+
+/** Time a pipeline stage spent working (not waiting on its queues), summed over its threads */
+struct FClassicBloomBatchStage
+{
+	const TCHAR* Name = TEXT("");
+	int32 NumThreads = 1;
+	std::atomic<uint64> BusyCycles{ 0 };
+	std::atomic<int32> NumFailed{ 0 };
+
+	double GetUtilization(double WallSeconds) const
+	{
+		return WallSeconds > 0.0 ? FPlatformTime::ToSeconds64(BusyCycles.load()) / (WallSeconds * NumThreads) : 0.0;
+	}
+};
+
+// ============================================================================
+// Frame I/O
+// ============================================================================
+
+static bool DecodeFrame(const FString& Path, FClassicBloomImage& OutImage)
+{
+	FImage Image;
+	if (!FImageUtils::LoadImage(*Path, Image))
+	{
+		return false;
+	}
+
+	// PNG frames are sRGB; the bloom math runs on linear values like the scene color it expects
+	Image.ChangeFormat(ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+	const TArrayView64<FLinearColor> Colors = Image.AsRGBA32F();
+	OutImage.SetFromLinearColors(Image.SizeX, Image.SizeY, TConstArrayView<FLinearColor>(Colors.GetData(), (int32)Colors.Num()));
+	return true;
+}
+
+static bool EncodeFrame(const FString& Path, const FClassicBloomImage& Image)
+{
+	FImage Output(Image.Width, Image.Height, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+	TArrayView64<FLinearColor> Colors = Output.AsRGBA32F();
+	for (int32 Index = 0; Index < Image.Pixels.Num(); ++Index)
+	{
+		const FVector4f& Pixel = Image.Pixels[Index];
+		Colors[Index] = FLinearColor(Pixel.X, Pixel.Y, Pixel.Z, 1.0f);
+	}
+
+	// Converted to the pixel format and gamma the extension's encoder supports
+	return FImageUtils::SaveImageByExtension(*Path, Output);
+}
+
+// ============================================================================
+// Settings
+// ============================================================================
+
+// A bloom component template: the object itself, or the first one an actor class (native or Blueprint) creates
+static const UBloomFXComponent* FindPresetComponent(const FString& ObjectPath)
+{
+	UObject* Object = StaticLoadObject(UObject::StaticClass(), nullptr, *ObjectPath);
+	if (const UBloomFXComponent* Component = Cast<UBloomFXComponent>(Object))
+	{
+		return Component;
+	}
+
+	const UClass* Class = Cast<UClass>(Object);
+	if (!Class)
+	{
+		return nullptr;
+	}
+
+	if (const AActor* DefaultActor = Cast<AActor>(Class->GetDefaultObject()))
+	{
+		if (const UBloomFXComponent* Component = DefaultActor->FindComponentByClass<UBloomFXComponent>())
+		{
+			return Component;
+		}
+	}
+
+	for (const UBlueprintGeneratedClass* BlueprintClass = Cast<UBlueprintGeneratedClass>(Class); BlueprintClass; BlueprintClass = Cast<UBlueprintGeneratedClass>(BlueprintClass->GetSuperClass()))
+	{
+		if (BlueprintClass->SimpleConstructionScript)
+		{
+			for (const USCS_Node* Node : BlueprintClass->SimpleConstructionScript->GetAllNodes())
+			{
+				if (const UBloomFXComponent* Component = Cast<UBloomFXComponent>(Node->ComponentTemplate))
+				{
+					return Component;
+				}
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+// Editable UBloomFXComponent properties by name, e.g. { "BloomMode": "Kawase", "BloomIntensity": 1.5 }
+static bool LoadSettingsFromJson(const FString& Path, UBloomFXComponent& Component)
+{
+	FString JsonText;
+	if (!FFileHelper::LoadFileToString(JsonText, *Path))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> JsonObject;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		return false;
+	}
+
+	return FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), UBloomFXComponent::StaticClass(), &Component, CPF_Edit, 0);
+}
+
+// ============================================================================
+// UClassicBloomBatchCommandlet
+// ============================================================================
+
+UClassicBloomBatchCommandlet::UClassicBloomBatchCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Apply ClassicBloom to a folder of EXR/PNG frames on the CPU");
+	HelpUsage = TEXT("-run=ClassicBloomBatch -Input=<Dir> -Output=<Dir> [-Preset=<ObjectPath> | -Settings=<File.json>] [-Format=exr|png] [-DecodeThreads=N] [-EncodeThreads=N] [-QueueDepth=N]");
+}
+
+int32 UClassicBloomBatchCommandlet::Main(const FString& Params)
+{
+	FString InputDir;
+	FString OutputDir;
+	if (!FParse::Value(*Params, TEXT("Input="), InputDir) || !FParse::Value(*Params, TEXT("Output="), OutputDir))
+	{
+		UE_LOG(LogClassicBloom, Error, TEXT("Usage: %s"), *HelpUsage);
+		return 1;
+	}
+
+	FString OutputFormat;
+	FParse::Value(*Params, TEXT("Format="), OutputFormat);
+
+	int32 NumDecodeThreads = 2;
+	int32 NumEncodeThreads = 2;
+	int32 QueueDepth = 4;
+	FParse::Value(*Params, TEXT("DecodeThreads="), NumDecodeThreads);
+	FParse::Value(*Params, TEXT("EncodeThreads="), NumEncodeThreads);
+	FParse::Value(*Params, TEXT("QueueDepth="), QueueDepth);
+	NumDecodeThreads = FMath::Max(1, NumDecodeThreads);
+	NumEncodeThreads = FMath::Max(1, NumEncodeThreads);
+
+	// Settings: component preset, JSON file, or the component defaults
+	UBloomFXComponent* SettingsComponent = NewObject<UBloomFXComponent>(GetTransientPackage());
+	const UBloomFXComponent* SourceComponent = SettingsComponent;
+
+	FString PresetPath;
+	FString SettingsPath;
+	if (FParse::Value(*Params, TEXT("Preset="), PresetPath))
+	{
+		SourceComponent = FindPresetComponent(PresetPath);
+		if (!SourceComponent)
+		{
+			UE_LOG(LogClassicBloom, Error, TEXT("No BloomFXComponent found in preset '%s'"), *PresetPath);
+			return 1;
+		}
+	}
+	else if (FParse::Value(*Params, TEXT("Settings="), SettingsPath) && !LoadSettingsFromJson(SettingsPath, *SettingsComponent))
+	{
+		UE_LOG(LogClassicBloom, Error, TEXT("Could not read bloom settings from '%s'"), *SettingsPath);
+		return 1;
+	}
+
+	const FClassicBloomRenderSettings Settings = FClassicBloomRenderSettings::FromComponent(*SourceComponent);
+
+	// The CPU path reads the convolution kernel from the texture's source art once, up front
+	FClassicBloomImage ConvolutionKernel;
+	if (Settings.BloomMode == EBloomMode::Convolution &&
+		(!SourceComponent->ConvolutionKernel || !FClassicBloomCpuRenderer::LoadConvolutionKernel(*SourceComponent->ConvolutionKernel, ConvolutionKernel)))
+	{
+		UE_LOG(LogClassicBloom, Error, TEXT("FFT Convolution mode needs a ConvolutionKernel texture with source data"));
+		return 1;
+	}
+
+	TArray<FString> FrameNames;
+	IFileManager::Get().FindFiles(FrameNames, *FPaths::Combine(InputDir, TEXT("*.exr")), true, false);
+	TArray<FString> PngNames;
+	IFileManager::Get().FindFiles(PngNames, *FPaths::Combine(InputDir, TEXT("*.png")), true, false);
+	FrameNames.Append(PngNames);
+	FrameNames.Sort();
+
+	if (FrameNames.Num() == 0)
+	{
+		UE_LOG(LogClassicBloom, Warning, TEXT("No EXR or PNG frames in '%s'"), *InputDir);
+		return 0;
+	}
+
+	IFileManager::Get().MakeDirectory(*OutputDir, true);
+	UE_LOG(LogClassicBloom, Display, TEXT("Blooming %d frames from '%s' into '%s'"), FrameNames.Num(), *InputDir, *OutputDir);
+
+	TClassicBloomBoundedQueue<FClassicBloomBatchFrame> DecodedFrames(QueueDepth);
+	TClassicBloomBoundedQueue<FClassicBloomBatchFrame> BloomedFrames(QueueDepth);
+
+	FClassicBloomBatchStage DecodeStage;
+	DecodeStage.Name = TEXT("Decode");
+	DecodeStage.NumThreads = NumDecodeThreads;
+	FClassicBloomBatchStage BloomStage;
+	BloomStage.Name = TEXT("Bloom");
+	FClassicBloomBatchStage EncodeStage;
+	EncodeStage.Name = TEXT("Encode");
+	EncodeStage.NumThreads = NumEncodeThreads;
+
+	std::atomic<int32> NextFrame{ 0 };
+	std::atomic<int32> ActiveDecoders{ NumDecodeThreads };
+	std::atomic<int32> NumWritten{ 0 };
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<TFuture<void>> Workers;
+
+	// Decode: pull the next file name, push the linear image (blocks while the bloom stage is behind)
+	for (int32 Thread = 0; Thread < NumDecodeThreads; ++Thread)
+	{
+		Workers.Add(Async(EAsyncExecution::Thread, [&]()
+		{
+			for (int32 Index = NextFrame++; Index < FrameNames.Num(); Index = NextFrame++)
+			{
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				FClassicBloomBatchFrame Frame;
+				Frame.Name = FrameNames[Index];
+				const bool bDecoded = DecodeFrame(FPaths::Combine(InputDir, Frame.Name), Frame.Image);
+				DecodeStage.BusyCycles += FPlatformTime::Cycles64() - StartCycles;
+
+				if (!bDecoded)
+				{
+					UE_LOG(LogClassicBloom, Error, TEXT("Could not decode '%s'"), *Frame.Name);
+					++DecodeStage.NumFailed;
+					continue;
+				}
+				DecodedFrames.Push(MoveTemp(Frame));
+			}
+
+			if (--ActiveDecoders == 0)
+			{
+				DecodedFrames.Close();
+			}
+		}));
+	}
+
+	// Bloom: one frame at a time, each already spread across every core by the CPU kernels
+	Workers.Add(Async(EAsyncExecution::Thread, [&]()
+	{
+		FClassicBloomBatchFrame Frame;
+		while (DecodedFrames.Pop(Frame))
+		{
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			FClassicBloomBatchFrame Bloomed;
+			Bloomed.Name = MoveTemp(Frame.Name);
+			FClassicBloomCpuRenderer::Render(Settings, Frame.Image, Bloomed.Image, true, &ConvolutionKernel);
+			BloomStage.BusyCycles += FPlatformTime::Cycles64() - StartCycles;
+
+			BloomedFrames.Push(MoveTemp(Bloomed));
+		}
+		BloomedFrames.Close();
+	}));
+
+	// Encode: same base name, optionally in another format
+	for (int32 Thread = 0; Thread < NumEncodeThreads; ++Thread)
+	{
+		Workers.Add(Async(EAsyncExecution::Thread, [&]()
+		{
+			FClassicBloomBatchFrame Frame;
+			while (BloomedFrames.Pop(Frame))
+			{
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				const FString OutputName = OutputFormat.IsEmpty() ? Frame.Name : FPaths::SetExtension(Frame.Name, OutputFormat);
+				const bool bEncoded = EncodeFrame(FPaths::Combine(OutputDir, OutputName), Frame.Image);
+				EncodeStage.BusyCycles += FPlatformTime::Cycles64() - StartCycles;
+
+				if (bEncoded)
+				{
+					++NumWritten;
+				}
+				else
+				{
+					UE_LOG(LogClassicBloom, Error, TEXT("Could not encode '%s'"), *OutputName);
+					++EncodeStage.NumFailed;
+				}
+			}
+		}));
+	}
+
+	for (TFuture<void>& Worker : Workers)
+	{
+		Worker.Wait();
+	}
+
+	const double WallSeconds = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogClassicBloom, Display, TEXT("Wrote %d of %d frames in %.2f s (%.2f fps)"),
+		NumWritten.load(), FrameNames.Num(), WallSeconds, WallSeconds > 0.0 ? NumWritten.load() / WallSeconds : 0.0);
+
+	for (const FClassicBloomBatchStage* Stage : { &DecodeStage, &BloomStage, &EncodeStage })
+	{
+		UE_LOG(LogClassicBloom, Display, TEXT("  %-6s %d thread(s), %5.1f%% busy, %d failed"),
+			Stage->Name, Stage->NumThreads, Stage->GetUtilization(WallSeconds) * 100.0, Stage->NumFailed.load());
+	}
+
+	return (DecodeStage.NumFailed.load() + EncodeStage.NumFailed.load()) > 0 ? 1 : 0;
+}
@@ -0,0 +1,105 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomCVars.h"
+#include "ClassicBloomBlurKernel.h"
+#include "HAL/IConsoleManager.h"
+#include "RenderingThread.h"
+
+static TAutoConsoleVariable<int32> CVarClassicBloomEnable(
+	TEXT("r.ClassicBloom.Enable"),
+	1,
+	TEXT("0: ClassicBloom does not subscribe to any post-process pass, whatever components are active.\n")
+	TEXT("1: Bloom as set up by components and volumes (default)."),
+	ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarClassicBloomMinDownsampleDivisor(
+	TEXT("r.ClassicBloom.MinDownsampleDivisor"),
+	0,
+	TEXT("Lowest downsample divisor of the bloom buffers (2 = half resolution, up to 8); views authored finer are coarsened to it.\n")
+	TEXT("0: as authored (default)."),
+	ECVF_Scalability | ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarClassicBloomMaxBlurPasses(
+	TEXT("r.ClassicBloom.MaxBlurPasses"),
+	0,
+	TEXT("Most blur passes of Standard and Soft Focus bloom.\n")
+	TEXT("0: as authored (default)."),
+	ECVF_Scalability | ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarClassicBloomMaxBlurSamples(
+	TEXT("r.ClassicBloom.MaxBlurSamples"),
+	0,
+	TEXT("Most Gaussian taps per blur axis (5, 9 or 13; other values use the nearest).\n")
+	TEXT("0: as authored (default)."),
+	ECVF_Scalability | ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarClassicBloomMaxKawaseMips(
+	TEXT("r.ClassicBloom.MaxKawaseMips"),
+	0,
+	TEXT("Most mips of the Kawase pyramid.\n")
+	TEXT("0: as authored (default)."),
+	ECVF_Scalability | ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarClassicBloomMaxGlareStreaks(
+	TEXT("r.ClassicBloom.MaxGlareStreaks"),
+	0,
+	TEXT("Most streaks of Directional Glare bloom (at least 2).\n")
+	TEXT("0: as authored (default)."),
+	ECVF_Scalability | ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarClassicBloomModeFallback(
+	TEXT("r.ClassicBloom.ModeFallback"),
+	0,
+	TEXT("0: every bloom mode renders as authored (default).\n")
+	TEXT("1: FFT Convolution renders as Standard bloom.\n")
+	TEXT("2: FFT Convolution and Directional Glare render as Standard bloom."),
+	ECVF_Scalability | ECVF_RenderThreadSafe);
+
+FClassicBloomCVarOverrides FClassicBloomCVarOverrides::Get_RenderThread()
+{
+	check(IsInRenderingThread());
+
+	FClassicBloomCVarOverrides Overrides;
+	Overrides.MinDownsampleDivisor = FMath::Clamp(CVarClassicBloomMinDownsampleDivisor.GetValueOnRenderThread(), 0, 8);
+	Overrides.MaxBlurPasses = FMath::Max(CVarClassicBloomMaxBlurPasses.GetValueOnRenderThread(), 0);
+	Overrides.MaxBlurSamples = FMath::Max(CVarClassicBloomMaxBlurSamples.GetValueOnRenderThread(), 0);
+	Overrides.MaxKawaseMipCount = FMath::Max(CVarClassicBloomMaxKawaseMips.GetValueOnRenderThread(), 0);
+	Overrides.MaxGlareStreakCount = FMath::Max(CVarClassicBloomMaxGlareStreaks.GetValueOnRenderThread(), 0);
+	Overrides.ModeFallback = FMath::Clamp(CVarClassicBloomModeFallback.GetValueOnRenderThread(), 0, 2);
+	return Overrides;
+}
+
+bool FClassicBloomCVarOverrides::IsBloomEnabled()
+{
+	return CVarClassicBloomEnable.GetValueOnAnyThread() != 0;
+}
+
+void FClassicBloomCVarOverrides::Apply(FClassicBloomRenderSettings& Settings) const
+{
+	if ((ModeFallback >= 1 && Settings.BloomMode == EBloomMode::Convolution)
+		|| (ModeFallback >= 2 && Settings.BloomMode == EBloomMode::DirectionalGlare))
+	{
+		Settings.BloomMode = EBloomMode::Standard;
+	}
+
+	if (MinDownsampleDivisor > 0 && Settings.GetDownsampleDivisor() < MinDownsampleDivisor)
+	{
+		Settings.DownsampleScale = 2.0f / (float)MinDownsampleDivisor;
+	}
+	if (MaxBlurPasses > 0)
+	{
+		Settings.BlurPasses = FMath::Min(Settings.BlurPasses, MaxBlurPasses);
+	}
+	if (MaxBlurSamples > 0)
+	{
+		Settings.BlurSamples = FMath::Min(Settings.BlurSamples, FClassicBloomBlurKernel::SnapTapCount(MaxBlurSamples));
+	}
+	if (MaxKawaseMipCount > 0)
+	{
+		Settings.KawaseMipCount = FMath::Min(Settings.KawaseMipCount, MaxKawaseMipCount);
+	}
+	if (MaxGlareStreakCount > 0)
+	{
+		Settings.GlareStreakCount = FMath::Min(Settings.GlareStreakCount, FMath::Max(MaxGlareStreakCount, 2));
+	}
+}
@@ -0,0 +1,122 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomComponentRegistry.h"
+#include "BloomFXComponent.h"
+#include "RenderingThread.h"
+#include "Algo/BinarySearch.h"
+
+FClassicBloomComponentRegistry::~FClassicBloomComponentRegistry()
+{
+	PublishedSettings.store(nullptr, std::memory_order_release);
+}
+
+void FClassicBloomComponentRegistry::Register(UBloomFXComponent* Component)
+{
+	check(IsInGameThread());
+
+	if (!Component || Serials.Contains(Component))
+	{
+		return;
+	}
+
+	const uint64 Serial = NextSerial++;
+	Serials.Add(Component, Serial);
+	Components.Add(Component);
+
+	if (Component->IsActive() && SetActiveEntry(Serial, Component->GetRenderSettings()))
+	{
+		Publish();
+	}
+}
+
+void FClassicBloomComponentRegistry::Unregister(UBloomFXComponent* Component)
+{
+	check(IsInGameThread());
+
+	uint64 Serial = 0;
+	if (!Component || !Serials.RemoveAndCopyValue(Component, Serial))
+	{
+		return;
+	}
+
+	Components.Remove(Component);
+
+	if (RemoveActiveEntry(Serial))
+	{
+		Publish();
+	}
+}
+
+void FClassicBloomComponentRegistry::Update(UBloomFXComponent* Component)
+{
+	check(IsInGameThread());
+
+	const uint64* Serial = Component ? Serials.Find(Component) : nullptr;
+	if (!Serial)
+	{
+		return;
+	}
+
+	const bool bHeadChanged = Component->IsActive()
+		? SetActiveEntry(*Serial, Component->GetRenderSettings())
+		: RemoveActiveEntry(*Serial);
+
+	if (bHeadChanged)
+	{
+		Publish();
+	}
+}
+
+bool FClassicBloomComponentRegistry::SetActiveEntry(uint64 Serial, FClassicBloomRenderSettingsPtr Settings)
+{
+	const int32 Index = Algo::LowerBoundBy(ActiveEntries, Serial, &FActiveEntry::Serial);
+	if (ActiveEntries.IsValidIndex(Index) && ActiveEntries[Index].Serial == Serial)
+	{
+		if (ActiveEntries[Index].Settings == Settings)
+		{
+			return false;
+		}
+		ActiveEntries[Index].Settings = MoveTemp(Settings);
+	}
+	else
+	{
+		ActiveEntries.Insert(FActiveEntry{ Serial, MoveTemp(Settings) }, Index);
+	}
+
+	return Index == 0;
+}
+
+bool FClassicBloomComponentRegistry::RemoveActiveEntry(uint64 Serial)
+{
+	const int32 Index = Algo::BinarySearchBy(ActiveEntries, Serial, &FActiveEntry::Serial);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	ActiveEntries.RemoveAt(Index, 1, EAllowShrinking::No);
+	return Index == 0;
+}
+
+void FClassicBloomComponentRegistry::Publish()
+{
+	FClassicBloomRenderSettingsPtr NewSettings = ActiveEntries.Num() > 0 ? ActiveEntries[0].Settings : nullptr;
+	if (NewSettings == PublishedOwner)
+	{
+		return;
+	}
+
+	FClassicBloomRenderSettingsPtr Retired = MoveTemp(PublishedOwner);
+	PublishedOwner = MoveTemp(NewSettings);
+	PublishedSettings.store(PublishedOwner.Get(), std::memory_order_release);
+
+	// Render commands already queued may still be reading the old pointer; release it after them
+	if (Retired.IsValid())
+	{
+		ENQUEUE_RENDER_COMMAND(ClassicBloomRetireSettings)(
+			[Retired = MoveTemp(Retired)](FRHICommandListImmediate& RHICmdList) mutable
+			{
+				Retired.Reset();
+			});
+	}
+}
@@ -0,0 +1,203 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomCpuRenderer.h"
+#include "ClassicBloomCpuKernels.h"
+#include "ClassicBloomDerivedParams.h"
+#include "ClassicBloomPassPlan.h"
+#include "Engine/Texture2D.h"
+#include "ImageCore.h"
+
+bool FClassicBloomCpuRenderer::LoadConvolutionKernel(UTexture2D& Texture, FClassicBloomImage& OutKernel)
+{
+	check(IsInGameThread());
+
+#if WITH_EDITORONLY_DATA
+	FImage Image;
+	if (!Texture.Source.IsValid() || !Texture.Source.GetMipImage(Image, 0, 0, 0))
+	{
+		return false;
+	}
+
+	// The GPU samples sRGB kernels linearized, so convert the same way
+	Image.ChangeFormat(ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+	const TArrayView64<FLinearColor> Colors = Image.AsRGBA32F();
+	OutKernel.SetFromLinearColors(Image.SizeX, Image.SizeY, TConstArrayView<FLinearColor>(Colors.GetData(), (int32)Colors.Num()));
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool FClassicBloomCpuRenderer::Render(const FClassicBloomRenderSettings& Settings, const FClassicBloomImage& SceneColor, FClassicBloomImage& OutColor, bool bIsGameWorld, const FClassicBloomImage* ConvolutionKernel)
+{
+	OutColor = SceneColor;
+	if (SceneColor.IsEmpty() || Settings.BloomIntensity <= 0.0f)
+	{
+		return false;
+	}
+	if (Settings.BloomMode == EBloomMode::Convolution && (!ConvolutionKernel || ConvolutionKernel->IsEmpty()))
+	{
+		return false;
+	}
+
+	// A single image has no history to reconstruct into or slice over, so every stage runs in full at the bloom resolution
+	FClassicBloomRenderSettings StageSettings = Settings;
+	StageSettings.bTemporalReuse = false;
+	StageSettings.bFrameSlicing = false;
+
+	const FClassicBloomDerivedParams Derived = FClassicBloomDerivedParams::Compute(StageSettings);
+	const FIntRect ViewRect(FIntPoint::ZeroValue, SceneColor.GetSize());
+	// Planned formats only matter on the GPU; every CPU image is float RGBA
+	const FClassicBloomPassPlan Plan = FClassicBloomPassPlan::Build(StageSettings, Derived, SceneColor.GetSize(), ViewRect, ERHIFeatureLevel::SM5, false);
+	if (!Plan.IsValid())
+	{
+		return false;
+	}
+
+	// One image per mip and array slice of every planned texture (slice-major: Slice * NumMips + Mip)
+	TArray<TArray<FClassicBloomImage, TInlineAllocator<1>>> Textures;
+	Textures.Reserve(Plan.Textures.Num());
+	for (const FClassicBloomPlannedTexture& PlannedTexture : Plan.Textures)
+	{
+		TArray<FClassicBloomImage, TInlineAllocator<1>>& Mips = Textures.AddDefaulted_GetRef();
+		for (int32 Slice = 0; Slice < PlannedTexture.ArraySize; ++Slice)
+		{
+			for (int32 Mip = 0; Mip < PlannedTexture.NumMips; ++Mip)
+			{
+				const FIntPoint MipExtent = PlannedTexture.GetMipExtent(Mip);
+				Mips.Emplace(MipExtent.X, MipExtent.Y);
+			}
+		}
+	}
+
+	auto GetInput = [&Textures, &SceneColor, ConvolutionKernel](const FClassicBloomPlannedPass& Pass, int32 Slot) -> const FClassicBloomImage&
+	{
+		const int32 Input = Pass.Inputs[Slot];
+		if (Input == FClassicBloomPlannedPass::ConvolutionKernelInput)
+		{
+			return *ConvolutionKernel;
+		}
+		return Input == FClassicBloomPlannedPass::SceneColorInput ? SceneColor : Textures[Input][Pass.InputMips[Slot]];
+	};
+
+	for (const FClassicBloomPlannedPass& Pass : Plan.Passes)
+	{
+		FClassicBloomImage& Output = Textures[Pass.Output][Pass.OutputMip];
+
+		switch (Pass.Type)
+		{
+			case EClassicBloomPassType::BrightPass:
+				FClassicBloomCpuKernels::BrightPass(GetInput(Pass, 0), Pass.SvPositionToSourceUV.Scale, Pass.SvPositionToSourceUV.Bias, Pass.Threshold, Output);
+				break;
+
+			case EClassicBloomPassType::GlareStreak:
+				FClassicBloomCpuKernels::GlareStreak(GetInput(Pass, 0), Pass.InputTransforms[0].U, Pass.InputTransforms[0].V, MakeArrayView(Pass.StreakAxes, Pass.NumStreakAxes), Pass.Radius, Pass.Falloff, Pass.bAdditive, Output);
+				break;
+
+			case EClassicBloomPassType::GlareStreakResolve:
+				for (int32 Slot = 0; Slot < Pass.NumInputs; ++Slot)
+				{
+					FClassicBloomCpuKernels::GlareStreakResolve(GetInput(Pass, Slot), Pass.InputTransforms[Slot].U, Pass.InputTransforms[Slot].V, Pass.bAdditive || Slot > 0, Output);
+				}
+				break;
+
+			case EClassicBloomPassType::GlareStreakStep:
+				FClassicBloomCpuKernels::GlareStreakStep(GetInput(Pass, 0), Pass.Direction, Pass.Radius, Pass.TapStart, Pass.TapWeights, Pass.bAdditive, Output);
+				break;
+
+			case EClassicBloomPassType::Blur:
+				FClassicBloomCpuKernels::GaussianBlur(GetInput(Pass, 0), Pass.Direction, Pass.BlurKernel, Output);
+				break;
+
+			case EClassicBloomPassType::BlurCompute:
+			{
+				// Same result as Iterations pixel passes along the axis
+				FClassicBloomImage Scratch[2];
+				const FClassicBloomImage* Source = &GetInput(Pass, 0);
+				for (int32 Iteration = 0; Iteration < Pass.Iterations; ++Iteration)
+				{
+					FClassicBloomImage& Target = (Iteration == Pass.Iterations - 1) ? Output : Scratch[Iteration & 1];
+					if (&Target != &Output)
+					{
+						Target.Resize(Output.Width, Output.Height);
+					}
+					FClassicBloomCpuKernels::GaussianBlur(*Source, Pass.Direction, Pass.BlurKernel, Target);
+					Source = &Target;
+				}
+				break;
+			}
+
+			case EClassicBloomPassType::KawaseDownsample:
+				FClassicBloomCpuKernels::KawaseDownsample(GetInput(Pass, 0), Pass.SvPositionToSourceUV.Scale, Pass.SvPositionToSourceUV.Bias, Pass.MipLevel, Pass.Threshold, Pass.ThresholdKnee, Output);
+				break;
+
+			case EClassicBloomPassType::KawaseDownsampleChain:
+			{
+				// The per-mip passes the dispatch replaces
+				FClassicBloomUVTransform SourceUV = Pass.SvPositionToSourceUV;
+				const FClassicBloomImage* Source = &GetInput(Pass, 0);
+				for (int32 Mip = 0; Mip < Pass.NumOutputMips; ++Mip)
+				{
+					FClassicBloomImage& Target = Textures[Pass.Output][Pass.OutputMip + Mip];
+					FClassicBloomCpuKernels::KawaseDownsample(*Source, SourceUV.Scale, SourceUV.Bias, Mip, Pass.Threshold, Pass.ThresholdKnee, Target);
+					if (Mip + 1 < Pass.NumOutputMips)
+					{
+						const FIntPoint TargetExtent = Target.GetSize();
+						const FIntPoint NextExtent = Plan.Textures[Pass.Output].GetMipExtent(Pass.OutputMip + Mip + 1);
+						SourceUV = FClassicBloomUVTransform::TexelToSourceUV(NextExtent, TargetExtent, FIntRect(FIntPoint::ZeroValue, TargetExtent));
+					}
+					Source = &Target;
+				}
+				break;
+			}
+
+			case EClassicBloomPassType::KawaseUpsample:
+				FClassicBloomCpuKernels::KawaseUpsample(GetInput(Pass, 0), Pass.Radius, Pass.bAdditive, Output);
+				break;
+
+			// Spectra are two-slice arrays: slice 0 = (R, G), slice 1 = (B, 0)
+			case EClassicBloomPassType::FFTForwardRows:
+				if (Pass.Inputs[0] == FClassicBloomPlannedPass::ConvolutionKernelInput)
+				{
+					FClassicBloomCpuKernels::FFTKernelRows(GetInput(Pass, 0), Pass.Radius, Textures[Pass.Output][0], Textures[Pass.Output][1]);
+				}
+				else
+				{
+					FClassicBloomCpuKernels::FFTForwardRows(GetInput(Pass, 0), Textures[Pass.Output][0], Textures[Pass.Output][1]);
+				}
+				break;
+
+			case EClassicBloomPassType::FFTColumns:
+			{
+				const bool bConvolve = Pass.NumInputs > 1;
+				FClassicBloomCpuKernels::FFTColumns(Pass.SourceExtent.Y,
+					bConvolve ? &Textures[Pass.Inputs[1]][0] : nullptr, bConvolve ? &Textures[Pass.Inputs[1]][1] : nullptr,
+					Textures[Pass.Output][0], Textures[Pass.Output][1]);
+				break;
+			}
+
+			case EClassicBloomPassType::FFTInverseRows:
+				FClassicBloomCpuKernels::FFTInverseRows(Textures[Pass.Inputs[0]][0], Textures[Pass.Inputs[0]][1], Output);
+				break;
+		}
+	}
+
+	// Same constants the composite pass binds in PostProcessPass_RenderThread
+	FClassicBloomCpuCompositeParams CompositeParams;
+	CompositeParams.BloomIntensity = Derived.CompositeBloomIntensity;
+	CompositeParams.BloomTint = Derived.BloomTint;
+	CompositeParams.BlendMode = (int32)Settings.BloomBlendMode;
+	CompositeParams.Saturation = Settings.BloomSaturation;
+	CompositeParams.bProtectHighlights = Settings.bProtectHighlights;
+	CompositeParams.HighlightProtection = Settings.HighlightProtection;
+	CompositeParams.SoftFocusIntensity = Derived.SoftFocusIntensity;
+	CompositeParams.SoftFocusParams = Settings.SoftFocusParams;
+	CompositeParams.bUseAdaptiveScaling = Settings.bUseAdaptiveBrightnessScaling;
+	CompositeParams.bShowBloomOnly = Settings.bShowBloomOnly;
+	CompositeParams.bShowGammaCompensation = Settings.bShowGammaCompensation;
+	CompositeParams.bIsGameWorld = bIsGameWorld;
+	CompositeParams.GameModeBloomScale = Settings.GameModeBloomScale;
+
+	FClassicBloomCpuKernels::Composite(SceneColor, Textures[Plan.BloomTexture][0], CompositeParams, OutColor);
+	return true;
+}
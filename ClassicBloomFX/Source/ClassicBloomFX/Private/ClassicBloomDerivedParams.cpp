@@ -0,0 +1,120 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomDerivedParams.h"
+#include "RenderingThread.h"
+
+// ============================================================================
+// FClassicBloomDerivedParams
+// ============================================================================
+
+FClassicBloomDerivedParams FClassicBloomDerivedParams::Compute(const FClassicBloomRenderSettings& Settings)
+{
+	FClassicBloomDerivedParams Params;
+
+	const bool bSoftFocus = (Settings.BloomMode == EBloomMode::SoftFocus);
+
+	// Soft focus needs the entire scene, so use a very low threshold
+	Params.BrightPassThreshold = bSoftFocus ? 0.01f : Settings.BloomThreshold;
+
+	if (Settings.BloomMode == EBloomMode::DirectionalGlare)
+	{
+		const float AngleStep = 360.0f / (float)Settings.GlareStreakCount;
+		const float StreakWeight = 1.0f / (float)Settings.GlareStreakCount;
+		TArray<float, TInlineAllocator<16>> AxisAngles;
+
+		for (int32 Index = 0; Index < Settings.GlareStreakCount; ++Index)
+		{
+			const float Angle = AngleStep * (float)Index + Settings.GlareRotationOffset;
+
+			// A streak at Angle + 180 degrees samples the same texels as the one at Angle: fold it into that axis
+			float AxisAngle = FMath::Fmod(Angle, 180.0f);
+			AxisAngle += (AxisAngle < 0.0f) ? 180.0f : 0.0f;
+			const int32 Axis = AxisAngles.IndexOfByPredicate([AxisAngle](float Other)
+			{
+				const float Delta = FMath::Abs(Other - AxisAngle);
+				return FMath::Min(Delta, 180.0f - Delta) < 0.01f;
+			});
+
+			if (Axis != INDEX_NONE)
+			{
+				Params.StreakWeights[Axis] += StreakWeight;
+				continue;
+			}
+
+			const float RadAngle = FMath::DegreesToRadians(Angle);
+			AxisAngles.Add(AxisAngle);
+			Params.StreakDirections.Add(FVector2f(FMath::Cos(RadAngle), FMath::Sin(RadAngle)));
+			Params.StreakWeights.Add(StreakWeight);
+		}
+	}
+
+	// Sigma in downsampled texels; matches the spread of the original fixed 9-tap kernel (about 1.75 taps of BloomSize * 0.1 texels).
+	// Temporal reuse runs the stages on coarser texels, so the same screen-space spread takes fewer of them.
+	const float TexelScale = Settings.UsesTemporalReuse() ? 1.0f / (float)FClassicBloomRenderSettings::TemporalDownsampleFactor : 1.0f;
+	const float BlurSigma = Settings.BloomSize * 0.18f * TexelScale;
+	Params.BlurKernel = FClassicBloomBlurKernel::Build(BlurSigma, Settings.BlurSamples);
+	Params.BlurIterations = Settings.BlurPasses;
+
+	// N Gaussian passes of sigma are one pass of sigma * sqrt(N). While that kernel still has a tap on every
+	// texel it is the same convolution, so the passes collapse into one.
+	if (Settings.BlurPasses > 1)
+	{
+		const FClassicBloomBlurKernel Collapsed = FClassicBloomBlurKernel::Build(BlurSigma * FMath::Sqrt((float)Settings.BlurPasses), Settings.BlurSamples);
+		if (Collapsed.TapSpacing <= 1.0f)
+		{
+			Params.BlurKernel = Collapsed;
+			Params.BlurIterations = 1;
+		}
+	}
+
+	Params.GlareBlurKernel = FClassicBloomBlurKernel::Build(Settings.BloomSize * 0.09f * TexelScale, 9); // Lighter blur for glare
+
+	Params.CompositeBloomIntensity = bSoftFocus ? 0.0f : Settings.BloomIntensity;
+	Params.SoftFocusIntensity = bSoftFocus ? Settings.BloomIntensity : 0.0f;
+	Params.BloomTint = FVector4f(Settings.BloomTint.R, Settings.BloomTint.G, Settings.BloomTint.B, Settings.bUseSceneColor ? 1.0f : 0.0f);
+
+	return Params;
+}
+
+// ============================================================================
+// FClassicBloomDerivedParamsCache
+// ============================================================================
+
+const FClassicBloomDerivedParams& FClassicBloomDerivedParamsCache::FindOrCompute(const FClassicBloomRenderSettings& Settings)
+{
+	check(IsInRenderingThread());
+
+	const uint32 FrameNumber = GFrameCounterRenderThread;
+	const uint32 Hash = GetTypeHash(Settings);
+
+	for (FEntry& Entry : Entries)
+	{
+		if (Entry.Hash == Hash && Entry.Settings == Settings)
+		{
+			Entry.LastUsedFrame = FrameNumber;
+			return *Entry.Params;
+		}
+	}
+
+	// Evict stale entries, then the least recently used one if still full
+	Entries.RemoveAllSwap([FrameNumber](const FEntry& Entry) { return FrameNumber - Entry.LastUsedFrame > MaxAge; }, EAllowShrinking::No);
+	if (Entries.Num() >= MaxEntries)
+	{
+		int32 OldestIndex = 0;
+		for (int32 Index = 1; Index < Entries.Num(); ++Index)
+		{
+			if (Entries[Index].LastUsedFrame < Entries[OldestIndex].LastUsedFrame)
+			{
+				OldestIndex = Index;
+			}
+		}
+		Entries.RemoveAtSwap(OldestIndex, 1, EAllowShrinking::No);
+	}
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Hash = Hash;
+	Entry.Settings = Settings;
+	Entry.Params = MakeUnique<FClassicBloomDerivedParams>(FClassicBloomDerivedParams::Compute(Settings));
+	Entry.LastUsedFrame = FrameNumber;
+	return *Entry.Params;
+}
@@ -1,12 +1,32 @@
 // Licensed under the MIT License. See LICENSE file in the project root.
 
 #include "ClassicBloomFX.h"
+#include "ClassicBloomStats.h"
+#include "ClassicBloomTrace.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/Paths.h"
 #include "ShaderCore.h"
 
 #define LOCTEXT_NAMESPACE "FClassicBloomFXModule"
 
+DEFINE_STAT(STAT_ClassicBloom_ResolveSettings);
+DEFINE_STAT(STAT_ClassicBloom_Subscribe);
+DEFINE_STAT(STAT_ClassicBloom_GraphSetup);
+DEFINE_STAT(STAT_ClassicBloom_BuildPlan);
+DEFINE_STAT(STAT_ClassicBloom_Passes);
+DEFINE_STAT(STAT_ClassicBloom_TransientTextureBytes);
+DEFINE_STAT(STAT_ClassicBloom_KernelSpectrumHits);
+DEFINE_STAT(STAT_ClassicBloom_KernelSpectrumMisses);
+DEFINE_STAT(STAT_ClassicBloom_KernelSpectrumDDCHits);
+DEFINE_STAT(STAT_ClassicBloom_KernelSpectrumDDCMisses);
+DEFINE_STAT(STAT_ClassicBloom_BudgetGpuTime);
+DEFINE_STAT(STAT_ClassicBloom_BudgetLevel);
+
+CSV_DEFINE_CATEGORY_MODULE(CLASSICBLOOMFX_API, ClassicBloom, true);
+
+DEFINE_LOG_CATEGORY(LogClassicBloom);
+UE_TRACE_CHANNEL_DEFINE(ClassicBloomChannel);
+
 void FClassicBloomFXModule::StartupModule()
 {
 	// Register shader directory
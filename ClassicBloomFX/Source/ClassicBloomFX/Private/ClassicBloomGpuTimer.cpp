@@ -0,0 +1,106 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomGpuTimer.h"
+#include "RenderGraphBuilder.h"
+#include "RenderingThread.h"
+#include "RHI.h"
+
+bool FClassicBloomGpuTimer::IsSupported()
+{
+	return GSupportsTimestampRenderQueries;
+}
+
+void FClassicBloomGpuTimer::AddTimestampPass(FRDGBuilder& GraphBuilder, FRHIPooledRenderQuery& OutQuery)
+{
+	if (!QueryPool.IsValid())
+	{
+		QueryPool = RHICreateRenderQueryPool(RQT_AbsoluteTime);
+	}
+
+	// The pooled query outlives the graph: it is only released once its result was read back
+	OutQuery = QueryPool->AllocateQuery();
+	FRHIRenderQuery* Query = OutQuery.GetQuery();
+	GraphBuilder.AddPass(RDG_EVENT_NAME("Timestamp"), ERDGPassFlags::NeverCull, [Query](FRHICommandListImmediate& RHICmdList)
+	{
+		RHICmdList.EndRenderQuery(Query);
+	});
+}
+
+void FClassicBloomGpuTimer::AddBeginPass(FRDGBuilder& GraphBuilder)
+{
+	check(IsInRenderingThread());
+
+	if (PendingBegin.IsValid())
+	{
+		PendingBegin.ReleaseQuery();
+	}
+	AddTimestampPass(GraphBuilder, PendingBegin);
+}
+
+void FClassicBloomGpuTimer::AddEndPass(FRDGBuilder& GraphBuilder)
+{
+	check(IsInRenderingThread());
+
+	if (!PendingBegin.IsValid())
+	{
+		return;
+	}
+
+	FRHIPooledRenderQuery End;
+	AddTimestampPass(GraphBuilder, End);
+
+	const uint32 FrameNumber = GFrameCounterRenderThread;
+	if (Frames.Num() == 0 || Frames.Last().FrameNumber != FrameNumber)
+	{
+		Frames.AddDefaulted_GetRef().FrameNumber = FrameNumber;
+	}
+	Frames.Last().Views.Emplace(MoveTemp(PendingBegin), MoveTemp(End));
+}
+
+bool FClassicBloomGpuTimer::ReadBack(float& OutMilliseconds)
+{
+	check(IsInRenderingThread());
+
+	// The current frame may still get views
+	const uint32 FrameNumber = GFrameCounterRenderThread;
+	while (Frames.Num() > 0 && Frames[0].FrameNumber != FrameNumber)
+	{
+		uint64 TotalMicroseconds = 0;
+		bool bLanded = true;
+		for (const TPair<FRHIPooledRenderQuery, FRHIPooledRenderQuery>& View : Frames[0].Views)
+		{
+			uint64 Begin = 0;
+			uint64 End = 0;
+			if (!RHIGetRenderQueryResult(View.Key.GetQuery(), Begin, false) || !RHIGetRenderQueryResult(View.Value.GetQuery(), End, false))
+			{
+				bLanded = false;
+				break;
+			}
+			TotalMicroseconds += End > Begin ? End - Begin : 0;
+		}
+
+		if (bLanded)
+		{
+			Frames.RemoveAt(0);
+			OutMilliseconds = (float)((double)TotalMicroseconds / 1000.0);
+			return true;
+		}
+		if (FrameNumber - Frames[0].FrameNumber <= MaxLatency)
+		{
+			return false;
+		}
+		Frames.RemoveAt(0);
+	}
+	return false;
+}
+
+void FClassicBloomGpuTimer::Reset()
+{
+	check(IsInRenderingThread());
+
+	Frames.Reset();
+	if (PendingBegin.IsValid())
+	{
+		PendingBegin.ReleaseQuery();
+	}
+}
@@ -0,0 +1,290 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomKernelSpectrumCache.h"
+#include "ClassicBloomPassPlan.h"
+#include "ClassicBloomStats.h"
+#include "RenderGraphBuilder.h"
+#include "RenderingThread.h"
+#include "RHIResources.h"
+#include "Engine/Texture2D.h"
+#include "Misc/ScopeLock.h"
+
+#if WITH_EDITOR
+#include "ClassicBloomCpuKernels.h"
+#include "ClassicBloomCpuRenderer.h"
+#include "ClassicBloomImage.h"
+#include "DerivedDataCacheInterface.h"
+#include "Async/Async.h"
+
+// Change whenever the spectrum layout or the transform changes, to invalidate every stored spectrum
+static const TCHAR* KernelSpectrumDerivedDataVersion = TEXT("6F1B0C2E9A3D4E57B8C6D0A1E2F3B4C5");
+
+static FString GetDerivedDataKey(const FClassicBloomKernelSpectrumKey& Key)
+{
+	const FString Suffix = FString::Printf(TEXT("%s_%d_%.4f_%s"), *Key.KernelId.ToString(), Key.FFTSize, Key.KernelTexels, GPixelFormats[Key.Format].Name);
+	return FDerivedDataCacheInterface::BuildCacheKey(TEXT("CLASSICBLOOM_KSPEC"), KernelSpectrumDerivedDataVersion, *Suffix);
+}
+
+// CPU version of the plan's FFTKernelRows and FFTKernelColumns passes, slice 0 then slice 1
+static TArray<uint8> BuildKernelSpectrum(const FClassicBloomKernelSpectrumKey& Key, const FClassicBloomImage& Kernel)
+{
+	check(GPixelFormats[Key.Format].BlockBytes == sizeof(FVector4f));
+
+	FClassicBloomImage SpectrumRG(Key.FFTSize, Key.FFTSize);
+	FClassicBloomImage SpectrumB(Key.FFTSize, Key.FFTSize);
+	FClassicBloomCpuKernels::FFTKernelRows(Kernel, Key.KernelTexels, SpectrumRG, SpectrumB);
+	FClassicBloomCpuKernels::FFTColumns(Key.FFTSize, nullptr, nullptr, SpectrumRG, SpectrumB);
+
+	TArray<uint8> Data;
+	Data.Reserve((int32)Key.GetSpectrumBytes());
+	Data.Append(reinterpret_cast<const uint8*>(SpectrumRG.Pixels.GetData()), SpectrumRG.Pixels.Num() * sizeof(FVector4f));
+	Data.Append(reinterpret_cast<const uint8*>(SpectrumB.Pixels.GetData()), SpectrumB.Pixels.Num() * sizeof(FVector4f));
+	return Data;
+}
+#endif
+
+// Initial contents of a texture created by the RHI
+class FClassicBloomSpectrumBulkData : public FResourceBulkDataInterface
+{
+public:
+	explicit FClassicBloomSpectrumBulkData(TArray<uint8>&& InData) : Data(MoveTemp(InData)) {}
+
+	virtual const void* GetResourceBulkData() const override { return Data.GetData(); }
+	virtual uint32 GetResourceBulkDataSize() const override { return (uint32)Data.Num(); }
+	virtual void Discard() override { Data.Empty(); }
+
+private:
+	TArray<uint8> Data;
+};
+
+static TRefCountPtr<IPooledRenderTarget> CreateSpectrumTexture(const FClassicBloomKernelSpectrumKey& Key, TArray<uint8>&& Data)
+{
+	FClassicBloomSpectrumBulkData BulkData(MoveTemp(Data));
+	const FRHITextureCreateDesc Desc = FRHITextureCreateDesc::Create2DArray(TEXT("ClassicBloom.KernelSpectrum"), Key.FFTSize, Key.FFTSize, FClassicBloomConvolutionLayout::SpectrumSlices, Key.Format)
+		.SetFlags(ETextureCreateFlags::ShaderResource)
+		.SetInitialState(ERHIAccess::SRVMask)
+		.SetBulkData(&BulkData);
+	return CreateRenderTarget(RHICreateTexture(Desc), Desc.DebugName);
+}
+
+// ============================================================================
+// FClassicBloomKernelSpectrumKey
+// ============================================================================
+
+FClassicBloomKernelSpectrumKey FClassicBloomKernelSpectrumKey::Make(const FClassicBloomRenderSettings& Settings)
+{
+	FClassicBloomKernelSpectrumKey Key;
+	if (Settings.BloomMode == EBloomMode::Convolution && Settings.ConvolutionKernelId.IsValid())
+	{
+		const FClassicBloomConvolutionLayout Layout = FClassicBloomConvolutionLayout::Make(Settings);
+		Key.KernelId = Settings.ConvolutionKernelId;
+		Key.FFTSize = Layout.FFTSize;
+		Key.KernelTexels = Layout.KernelTexels;
+		Key.Format = FClassicBloomConvolutionLayout::SpectrumFormat;
+	}
+	return Key;
+}
+
+uint64 FClassicBloomKernelSpectrumKey::GetSpectrumBytes() const
+{
+	return (uint64)FFTSize * FFTSize * GPixelFormats[Format].BlockBytes * FClassicBloomConvolutionLayout::SpectrumSlices;
+}
+
+// ============================================================================
+// FClassicBloomKernelSpectrumCache
+// ============================================================================
+
+void FClassicBloomKernelSpectrumCache::Prefetch(const FClassicBloomRenderSettings& Settings)
+{
+	check(IsInGameThread());
+
+#if WITH_EDITOR
+	const FClassicBloomKernelSpectrumKey Key = FClassicBloomKernelSpectrumKey::Make(Settings);
+	const UTexture2D* KernelTexture = Settings.ConvolutionKernel.Get();
+	if (!Key.IsValid() || !KernelTexture)
+	{
+		return;
+	}
+	{
+		FScopeLock Lock(&PrefetchedKeysLock);
+		bool bAlreadyPrefetched = false;
+		PrefetchedKeys.Add(Key, &bAlreadyPrefetched);
+		if (bAlreadyPrefetched)
+		{
+			return;
+		}
+	}
+
+	// Source art can only be read here; skip decoding it when the derived data cache will most likely supply the spectrum
+	const FString DerivedDataKey = GetDerivedDataKey(Key);
+	const FString DebugContext = KernelTexture->GetPathName();
+	FClassicBloomImage Kernel;
+	if (!GetDerivedDataCacheRef().CachedDataProbablyExists(*DerivedDataKey))
+	{
+		FClassicBloomCpuRenderer::LoadConvolutionKernel(const_cast<UTexture2D&>(*KernelTexture), Kernel);
+	}
+
+	Async(EAsyncExecution::ThreadPool, [Cache = AsShared(), Key, DerivedDataKey, DebugContext, Kernel = MoveTemp(Kernel)]()
+	{
+		TArray<uint8> Data;
+		if (GetDerivedDataCacheRef().GetSynchronous(*DerivedDataKey, Data, DebugContext) && (uint64)Data.Num() == Key.GetSpectrumBytes())
+		{
+			++Cache->DerivedDataHits;
+			INC_DWORD_STAT(STAT_ClassicBloom_KernelSpectrumDDCHits);
+		}
+		else
+		{
+			++Cache->DerivedDataMisses;
+			INC_DWORD_STAT(STAT_ClassicBloom_KernelSpectrumDDCMisses);
+
+			// No source art: leave the spectrum to the renderer's kernel passes
+			if (Kernel.IsEmpty())
+			{
+				Cache->ForgetPrefetchedKey(Key);
+				return;
+			}
+			Data = BuildKernelSpectrum(Key, Kernel);
+			GetDerivedDataCacheRef().Put(*DerivedDataKey, Data, DebugContext);
+		}
+
+		ENQUEUE_RENDER_COMMAND(ClassicBloomKernelSpectrum)([Cache, Key, Data = MoveTemp(Data)](FRHICommandListImmediate& RHICmdList) mutable
+		{
+			Cache->AddPrefetched(Key, MoveTemp(Data));
+		});
+	});
+#endif
+}
+
+FRDGTextureRef FClassicBloomKernelSpectrumCache::Find(FRDGBuilder& GraphBuilder, const FClassicBloomKernelSpectrumKey& Key)
+{
+	check(IsInRenderingThread());
+
+	// Release spectra no view asked for in a while. A prefetched spectrum not uploaded yet is kept: its view may
+	// only start convolving later, and the prefetch does not run again for the same key
+	const uint32 FrameNumber = GFrameCounterRenderThread;
+	for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+	{
+		if (FrameNumber - Entries[Index]->LastUsedFrame > MaxAge && Entries[Index]->PrefetchedData.Num() == 0)
+		{
+			RemoveEntry(Index);
+		}
+	}
+
+	FEntry* Entry = FindEntry(Key);
+	if (Entry && !Entry->Texture && Entry->PrefetchedData.Num() > 0)
+	{
+		Entry->Texture = CreateSpectrumTexture(Key, MoveTemp(Entry->PrefetchedData));
+		Entry->PrefetchedData.Empty();
+	}
+	if (!Entry || !Entry->Texture)
+	{
+		return nullptr;
+	}
+
+	++Hits;
+	INC_DWORD_STAT(STAT_ClassicBloom_KernelSpectrumHits);
+	Entry->LastUsedFrame = FrameNumber;
+	return GraphBuilder.RegisterExternalTexture(Entry->Texture);
+}
+
+void FClassicBloomKernelSpectrumCache::Add(FRDGBuilder& GraphBuilder, const FClassicBloomKernelSpectrumKey& Key, FRDGTextureRef Spectrum)
+{
+	check(IsInRenderingThread());
+
+	++Misses;
+	INC_DWORD_STAT(STAT_ClassicBloom_KernelSpectrumMisses);
+
+	FEntry* Entry = FindEntry(Key);
+	if (!Entry)
+	{
+		Entry = AddEntry(Key);
+	}
+	if (Entry)
+	{
+		Entry->LastUsedFrame = GFrameCounterRenderThread;
+		GraphBuilder.QueueTextureExtraction(Spectrum, &Entry->Texture);
+	}
+}
+
+FClassicBloomKernelSpectrumCacheStats FClassicBloomKernelSpectrumCache::GetStats() const
+{
+	FClassicBloomKernelSpectrumCacheStats Stats;
+	Stats.Hits = Hits.load(std::memory_order_relaxed);
+	Stats.Misses = Misses.load(std::memory_order_relaxed);
+	Stats.DerivedDataHits = DerivedDataHits.load(std::memory_order_relaxed);
+	Stats.DerivedDataMisses = DerivedDataMisses.load(std::memory_order_relaxed);
+	return Stats;
+}
+
+FClassicBloomKernelSpectrumCache::FEntry* FClassicBloomKernelSpectrumCache::FindEntry(const FClassicBloomKernelSpectrumKey& Key)
+{
+	for (const TUniquePtr<FEntry>& Entry : Entries)
+	{
+		if (Entry->Key == Key)
+		{
+			return Entry.Get();
+		}
+	}
+	return nullptr;
+}
+
+FClassicBloomKernelSpectrumCache::FEntry* FClassicBloomKernelSpectrumCache::AddEntry(const FClassicBloomKernelSpectrumKey& Key)
+{
+	if (Entries.Num() >= MaxEntries)
+	{
+		// An entry used this frame may still be the target of a pending texture extraction
+		const uint32 FrameNumber = GFrameCounterRenderThread;
+		int32 OldestIndex = INDEX_NONE;
+		for (int32 Index = 0; Index < Entries.Num(); ++Index)
+		{
+			if (Entries[Index]->LastUsedFrame != FrameNumber
+				&& (OldestIndex == INDEX_NONE || Entries[Index]->LastUsedFrame < Entries[OldestIndex]->LastUsedFrame))
+			{
+				OldestIndex = Index;
+			}
+		}
+		if (OldestIndex == INDEX_NONE)
+		{
+			return nullptr;
+		}
+		RemoveEntry(OldestIndex);
+	}
+
+	TUniquePtr<FEntry>& Entry = Entries.Add_GetRef(MakeUnique<FEntry>());
+	Entry->Key = Key;
+	Entry->LastUsedFrame = GFrameCounterRenderThread;
+	return Entry.Get();
+}
+
+void FClassicBloomKernelSpectrumCache::RemoveEntry(int32 Index)
+{
+	// A later Prefetch of the key loads the spectrum again
+	ForgetPrefetchedKey(Entries[Index]->Key);
+	Entries.RemoveAtSwap(Index);
+}
+
+void FClassicBloomKernelSpectrumCache::ForgetPrefetchedKey(const FClassicBloomKernelSpectrumKey& Key)
+{
+	FScopeLock Lock(&PrefetchedKeysLock);
+	PrefetchedKeys.Remove(Key);
+}
+
+void FClassicBloomKernelSpectrumCache::AddPrefetched(const FClassicBloomKernelSpectrumKey& Key, TArray<uint8>&& Data)
+{
+	check(IsInRenderingThread());
+
+	// The renderer may have computed the spectrum while the prefetch was running
+	FEntry* Entry = FindEntry(Key);
+	if (!Entry)
+	{
+		Entry = AddEntry(Key);
+	}
+	if (!Entry)
+	{
+		ForgetPrefetchedKey(Key);
+	}
+	else if (!Entry->Texture)
+	{
+		Entry->PrefetchedData = MoveTemp(Data);
+	}
+}
@@ -0,0 +1,813 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomPassPlan.h"
+#include "ClassicBloomDerivedParams.h"
+#include "ClassicBloomComputeLimits.h"
+#include "ClassicBloomStats.h"
+#include "ClassicBloomFFT.h"
+#include "ClassicBloomTrace.h"
+#include "RenderingThread.h"
+
+// ============================================================================
+// FClassicBloomUVTransform
+// ============================================================================
+
+FClassicBloomUVTransform FClassicBloomUVTransform::TexelToSourceUV(FIntPoint OutputSize, FIntPoint SourceExtent, const FIntRect& SourceRect)
+{
+	// TexelPosition -> ViewportUV of the output, then ViewportUV -> TextureUV of the source rect
+	FClassicBloomUVTransform Transform;
+	Transform.Scale = FVector2f(
+		(float)SourceRect.Width() / ((float)OutputSize.X * SourceExtent.X),
+		(float)SourceRect.Height() / ((float)OutputSize.Y * SourceExtent.Y));
+	Transform.Bias = FVector2f(
+		(float)SourceRect.Min.X / SourceExtent.X,
+		(float)SourceRect.Min.Y / SourceExtent.Y);
+	return Transform;
+}
+
+// ============================================================================
+// FClassicBloomAffineUVTransform
+// ============================================================================
+
+FClassicBloomAffineUVTransform FClassicBloomAffineUVTransform::PixelToSourceUV(const FVector3f& X, const FVector3f& Y, FIntPoint SourceExtent)
+{
+	FClassicBloomAffineUVTransform Transform;
+	Transform.U = X / (float)SourceExtent.X;
+	Transform.V = Y / (float)SourceExtent.Y;
+	return Transform;
+}
+
+// ============================================================================
+// FClassicBloomPlannedTexture
+// ============================================================================
+
+uint64 FClassicBloomPlannedTexture::GetMemorySize() const
+{
+	uint64 Bytes = 0;
+	for (int32 Mip = 0; Mip < NumMips; ++Mip)
+	{
+		const FIntPoint MipExtent = GetMipExtent(Mip);
+		Bytes += (uint64)MipExtent.X * MipExtent.Y * GPixelFormats[Format].BlockBytes;
+	}
+	return Bytes * ArraySize;
+}
+
+// ============================================================================
+// FClassicBloomConvolutionLayout
+// ============================================================================
+
+FClassicBloomConvolutionLayout FClassicBloomConvolutionLayout::Make(const FClassicBloomRenderSettings& Settings)
+{
+	// The image plus half the kernel's width fits the configured transform size; the padded size can come out smaller
+	FClassicBloomConvolutionLayout Layout;
+	Layout.ImageLongSide = FMath::FloorToInt((float)Settings.ConvolutionFFTSize / (1.0f + 0.5f * Settings.ConvolutionKernelSize));
+	Layout.KernelTexels = Settings.ConvolutionKernelSize * Layout.ImageLongSide;
+	const int32 Reach = FMath::CeilToInt(0.5f * Layout.KernelTexels);
+	Layout.FFTSize = FMath::Clamp((int32)FMath::RoundUpToPowerOfTwo(Layout.ImageLongSide + Reach), FClassicBloomFFT::MinSize, FClassicBloomFFT::MaxSize);
+	return Layout;
+}
+
+FIntPoint FClassicBloomConvolutionLayout::GetImageExtent(FIntPoint ViewSize) const
+{
+	if (ViewSize.X >= ViewSize.Y)
+	{
+		return FIntPoint(ImageLongSide, FMath::Clamp(FMath::RoundToInt((float)ImageLongSide * ViewSize.Y / ViewSize.X), 1, ImageLongSide));
+	}
+	return FIntPoint(FMath::Clamp(FMath::RoundToInt((float)ImageLongSide * ViewSize.X / ViewSize.Y), 1, ImageLongSide), ImageLongSide);
+}
+
+// ============================================================================
+// FClassicBloomPassPlan
+// ============================================================================
+
+// Samples on each side of a glare streak (STREAK_SAMPLES)
+static constexpr int32 ClassicBloomStreakSamples = 16;
+
+// Relative GPU cost of a pass for the frame slicer's budget: texels written times texture fetches per texel
+static float GetPassCost(const FClassicBloomPassPlan& Plan, const FClassicBloomPlannedPass& Pass)
+{
+	const FClassicBloomPlannedTexture& Output = Plan.Textures[Pass.Output];
+	float Texels = 0.0f;
+	for (int32 Mip = Pass.OutputMip; Mip < Pass.OutputMip + Pass.NumOutputMips; ++Mip)
+	{
+		const FIntPoint MipExtent = Output.GetMipExtent(Mip);
+		Texels += (float)MipExtent.X * MipExtent.Y * Output.ArraySize;
+	}
+
+	float Fetches = 1.0f;
+	switch (Pass.Type)
+	{
+		case EClassicBloomPassType::BrightPass: Fetches = 1.0f; break;
+		case EClassicBloomPassType::GlareStreak: Fetches = 1.0f + 2.0f * ClassicBloomStreakSamples * Pass.NumStreakAxes; break;
+		case EClassicBloomPassType::GlareStreakStep: Fetches = 4.0f; break;
+		case EClassicBloomPassType::GlareStreakResolve: Fetches = (float)Pass.NumInputs; break;
+		case EClassicBloomPassType::Blur: Fetches = 2.0f * Pass.BlurKernel.NumFetchPairs + 1.0f; break;
+		case EClassicBloomPassType::BlurCompute: Fetches = (2.0f * Pass.BlurKernel.NumFetchPairs + 1.0f) * Pass.Iterations; break;
+		case EClassicBloomPassType::KawaseDownsample: Fetches = 13.0f; break;
+		case EClassicBloomPassType::KawaseDownsampleChain: Fetches = 13.0f; break;
+		case EClassicBloomPassType::KawaseUpsample: Fetches = 9.0f; break;
+		case EClassicBloomPassType::FFTForwardRows:
+		case EClassicBloomPassType::FFTColumns:
+		case EClassicBloomPassType::FFTInverseRows: Fetches = (float)FMath::CeilLogTwo((uint32)FMath::Max(Output.Extent.X, Output.Extent.Y)); break;
+	}
+	return Texels * Fetches;
+}
+
+FClassicBloomPassPlan FClassicBloomPassPlan::Build(
+	const FClassicBloomRenderSettings& Settings,
+	const FClassicBloomDerivedParams& Derived,
+	FIntPoint SceneColorExtent,
+	const FIntRect& ViewRect,
+	ERHIFeatureLevel::Type FeatureLevel,
+	bool bR11G11B10SupportsUAV)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ClassicBloom_BuildPlan);
+
+	FClassicBloomPassPlan Plan;
+
+	// The bloom shaders are only compiled for SM5 and above
+	if (FeatureLevel < ERHIFeatureLevel::SM5 || ViewRect.Width() <= 0 || ViewRect.Height() <= 0 || SceneColorExtent.X <= 0 || SceneColorExtent.Y <= 0)
+	{
+		return Plan;
+	}
+
+	// Every stage works at the view size (not the padded texture extent) so UVs map 1:1; the FFT convolution
+	// sizes its image from the settings instead so the kernel spectrum does not depend on the view.
+	// Temporal reuse runs every stage at a coarser divisor and leaves the bloom resolution to the history.
+	const bool bTemporal = Settings.UsesTemporalReuse();
+	const int32 Divisor = Settings.GetDownsampleDivisor() * (bTemporal ? FClassicBloomRenderSettings::TemporalDownsampleFactor : 1);
+	const bool bConvolution = Settings.BloomMode == EBloomMode::Convolution;
+	if (bConvolution && !Settings.ConvolutionKernelId.IsValid())
+	{
+		return Plan;
+	}
+	const FClassicBloomConvolutionLayout ConvolutionLayout = bConvolution ? FClassicBloomConvolutionLayout::Make(Settings) : FClassicBloomConvolutionLayout();
+	const bool bSliced = Settings.UsesFrameSlicing();
+	const FIntPoint DownsampledExtent = bConvolution
+		? ConvolutionLayout.GetImageExtent(ViewRect.Size())
+		: FIntPoint::DivideAndRoundUp(ViewRect.Size(), Divisor);
+	if (DownsampledExtent.X <= 0 || DownsampledExtent.Y <= 0)
+	{
+		return Plan;
+	}
+	Plan.DownsampledExtent = DownsampledExtent;
+	if (bTemporal)
+	{
+		Plan.TemporalExtent = FIntPoint::DivideAndRoundUp(ViewRect.Size(), Settings.GetDownsampleDivisor());
+	}
+
+	auto AddTexture = [&Plan](FIntPoint Extent, const TCHAR* Name)
+	{
+		FClassicBloomPlannedTexture& Texture = Plan.Textures.AddDefaulted_GetRef();
+		Texture.Extent = Extent;
+		Texture.Name = Name;
+		return Plan.Textures.Num() - 1;
+	};
+
+	auto AddPass = [&Plan](EClassicBloomPassType Type, const TCHAR* Name, int32 Output, std::initializer_list<int32> Inputs) -> FClassicBloomPlannedPass&
+	{
+		check(Inputs.size() <= FClassicBloomPlannedPass::MaxInputs);
+		FClassicBloomPlannedPass& Pass = Plan.Passes.AddDefaulted_GetRef();
+		Pass.Type = Type;
+		Pass.Name = Name;
+		Pass.Output = Output;
+		for (int32 Input : Inputs)
+		{
+			Pass.Inputs[Pass.NumInputs++] = Input;
+		}
+		return Pass;
+	};
+
+	auto AddSlice = [&Plan](std::initializer_list<int32> PersistentTextures)
+	{
+		FClassicBloomPlannedSlice& Slice = Plan.Slices.AddDefaulted_GetRef();
+		Slice.PersistentTextures.Append(PersistentTextures);
+		return Plan.Slices.Num() - 1;
+	};
+
+	// Compute targets need typed UAV stores; fall back to half float where R11G11B10 has none
+	const EPixelFormat ComputeFormat = bR11G11B10SupportsUAV ? PF_FloatR11G11B10 : PF_FloatRGBA;
+
+	// Iterations x (horizontal, vertical) separable Gaussian from Source into Output, using Temp in between
+	auto AddBlur = [&](int32 Source, int32 Temp, int32 Output, const FClassicBloomBlurKernel& Kernel, int32 Iterations, const TCHAR* NameH, const TCHAR* NameV)
+	{
+		// The axes commute, so H V H V is planned as H H, V V: one groupshared-memory dispatch per axis
+		if (Settings.bComputeBlur && FClassicBloomComputeBlurLimits::GetMaxIterations(Kernel) >= Iterations)
+		{
+			for (int32 Texture : { Temp, Output })
+			{
+				Plan.Textures[Texture].Format = ComputeFormat;
+				Plan.Textures[Texture].bUAV = true;
+			}
+
+			FClassicBloomPlannedPass& Horizontal = AddPass(EClassicBloomPassType::BlurCompute, NameH, Temp, { Source });
+			Horizontal.Direction = FVector2f(1.0f, 0.0f);
+			Horizontal.BlurKernel = Kernel;
+			Horizontal.Iterations = Iterations;
+
+			FClassicBloomPlannedPass& Vertical = AddPass(EClassicBloomPassType::BlurCompute, NameV, Output, { Temp });
+			Vertical.Direction = FVector2f(0.0f, 1.0f);
+			Vertical.BlurKernel = Kernel;
+			Vertical.Iterations = Iterations;
+			return;
+		}
+
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			FClassicBloomPlannedPass& Horizontal = AddPass(EClassicBloomPassType::Blur, NameH, Temp, { Iteration == 0 ? Source : Output });
+			Horizontal.Direction = FVector2f(1.0f, 0.0f);
+			Horizontal.BlurKernel = Kernel;
+
+			FClassicBloomPlannedPass& Vertical = AddPass(EClassicBloomPassType::Blur, NameV, Output, { Temp });
+			Vertical.Direction = FVector2f(0.0f, 1.0f);
+			Vertical.BlurKernel = Kernel;
+		}
+	};
+
+	// Step 1: bright pass (removed again below when the chosen mode does not read it)
+	const int32 BrightPass = AddTexture(DownsampledExtent, TEXT("ClassicBloom.BrightPass"));
+	{
+		FClassicBloomPlannedPass& Pass = AddPass(EClassicBloomPassType::BrightPass, TEXT("BrightPass"), BrightPass, { FClassicBloomPlannedPass::SceneColorInput });
+		Pass.SvPositionToSourceUV = FClassicBloomUVTransform::TexelToSourceUV(DownsampledExtent, SceneColorExtent, ViewRect);
+		Pass.SourceExtent = SceneColorExtent;
+		Pass.Threshold = Derived.BrightPassThreshold;
+	}
+
+	// Steps 2 & 3: mode specific blur
+	if (Settings.BloomMode == EBloomMode::DirectionalGlare && Derived.StreakDirections.Num() > 0)
+	{
+		// One streak per distinct axis, sampled from the bright pass and blended additively into a single
+		// target with the axis' share of the average, so memory does not grow with the streak count
+		const int32 NumAxes = Derived.StreakDirections.Num();
+		const float StreakLength = Settings.GlareStreakLength / (float)Divisor; // Streak length in downsampled pixels
+		const int32 Accum = AddTexture(DownsampledExtent, TEXT("ClassicBloom.GlareAccum"));
+		const FClassicBloomAffineUVTransform IdentityTransform = FClassicBloomAffineUVTransform::PixelToSourceUV(
+			FVector3f(1.0f, 0.0f, 0.0f), FVector3f(0.0f, 1.0f, 0.0f), DownsampledExtent);
+
+		// Frame slicing splits the axes into consecutive groups, one slice each; a slice's streaks are summed
+		// into a buffer of their own that the frames in between reuse
+		const int32 NumGroups = bSliced ? FMath::Min(NumAxes, (int32)FClassicBloomPlannedPass::MaxInputs) : 1;
+		auto GetAxisGroup = [NumAxes, NumGroups](int32 Axis) { return Axis * NumGroups / NumAxes; };
+		int32 GroupTargets[FClassicBloomPlannedPass::MaxInputs] = { Accum, Accum, Accum, Accum };
+		if (bSliced)
+		{
+			for (int32 Group = 0; Group < NumGroups; ++Group)
+			{
+				GroupTargets[Group] = AddTexture(DownsampledExtent, TEXT("ClassicBloom.GlareSlice"));
+			}
+		}
+
+		// Sum the group buffers into Accum
+		auto AddGroupResolve = [&]()
+		{
+			FClassicBloomPlannedPass& Resolve = AddPass(EClassicBloomPassType::GlareStreakResolve, TEXT("GlareSliceResolve"), Accum, {});
+			for (int32 Group = 0; Group < NumGroups; ++Group)
+			{
+				Resolve.Inputs[Group] = GroupTargets[Group];
+				Resolve.InputTransforms[Group] = IdentityTransform;
+			}
+			Resolve.NumInputs = NumGroups;
+		};
+
+		if (Settings.bLogGlareStreaks)
+		{
+			// Each half of a streak is a chain of 4-tap steps with stride 1, 4, 16, ...; weights are the
+			// per-texel attenuation matching exp(-Distance * Falloff). Steps stop once the chain covers the
+			// streak length, or earlier once the next stride's taps would all be below 0.001.
+			const float Attenuation = FMath::Exp(-Settings.GlareFalloff / StreakLength);
+			const float Reach = FMath::Min(StreakLength, FMath::Loge(1000.0f) * StreakLength / Settings.GlareFalloff);
+			const int32 NumSteps = FMath::Max(1, FMath::CeilToInt(FMath::LogX(4.0f, Reach)));
+
+			int32 StepTargets[2] = { INDEX_NONE, INDEX_NONE };
+			if (NumSteps > 1)
+			{
+				StepTargets[0] = AddTexture(DownsampledExtent, TEXT("ClassicBloom.StreakStep"));
+				StepTargets[1] = AddTexture(DownsampledExtent, TEXT("ClassicBloom.StreakStep"));
+			}
+
+			int32 Slice = INDEX_NONE;
+			for (int32 Index = 0; Index < NumAxes; ++Index)
+			{
+				const int32 Group = GetAxisGroup(Index);
+				const bool bFirstInTarget = bSliced ? (Index == 0 || GetAxisGroup(Index - 1) != Group) : Index == 0;
+				if (bSliced && bFirstInTarget)
+				{
+					Slice = AddSlice({ GroupTargets[Group] });
+				}
+
+				// The forward half covers texels 0 .. 4^Steps - 1, the backward half 1 .. 4^Steps, so every
+				// texel is sampled once; the backward half's total weight is Attenuation times the forward one
+				for (int32 Half = 0; Half < 2; ++Half)
+				{
+					const float HalfWeight = (Half == 0 ? 1.0f : Attenuation) / (1.0f + Attenuation) * Derived.StreakWeights[Index];
+					int32 Source = BrightPass;
+					float Stride = 1.0f;
+
+					for (int32 Step = 0; Step < NumSteps; ++Step)
+					{
+						const bool bLastStep = Step == NumSteps - 1;
+						const int32 Target = bLastStep ? GroupTargets[Group] : StepTargets[Step & 1];
+						FClassicBloomPlannedPass& Pass = AddPass(EClassicBloomPassType::GlareStreakStep, TEXT("GlareStreakStep"), Target, { Source });
+						Pass.NameIndex = Index;
+						Pass.Slice = Slice;
+						Pass.bAdditive = bLastStep && (!bFirstInTarget || Half > 0);
+						Pass.Direction = Derived.StreakDirections[Index] * (Half == 0 ? 1.0f : -1.0f);
+						Pass.Radius = Stride;
+						Pass.TapStart = (Step == 0 && Half == 1) ? 1.0f : 0.0f;
+
+						const float TapAttenuation = FMath::Pow(Attenuation, Stride);
+						const FVector4f Weights(1.0f, TapAttenuation, FMath::Square(TapAttenuation), FMath::Pow(TapAttenuation, 3.0f));
+						Pass.TapWeights = Weights * ((bLastStep ? HalfWeight : 1.0f) / (Weights.X + Weights.Y + Weights.Z + Weights.W));
+
+						Source = Target;
+						Stride *= 4.0f;
+					}
+				}
+			}
+
+			if (bSliced)
+			{
+				AddGroupResolve();
+			}
+		}
+		else
+		{
+			// Streak passes sample the bright pass at full size; the anisotropic path renders each axis smaller
+			auto AddStreakPass = [&](int32 Output, int32 FirstAxis, int32 NumPassAxes, const FClassicBloomAffineUVTransform& SvPositionToSourceUV) -> FClassicBloomPlannedPass&
+			{
+				FClassicBloomPlannedPass& Pass = AddPass(EClassicBloomPassType::GlareStreak, TEXT("GlareStreak"), Output, { BrightPass });
+				Pass.InputTransforms[0] = SvPositionToSourceUV;
+				Pass.SourceExtent = DownsampledExtent;
+				Pass.Radius = StreakLength;
+				Pass.Falloff = Settings.GlareFalloff;
+				Pass.NumStreakAxes = NumPassAxes;
+				for (int32 Axis = 0; Axis < FClassicBloomPlannedPass::MaxStreakAxes; ++Axis)
+				{
+					const bool bUsed = Axis < NumPassAxes;
+					const FVector2f Direction = bUsed ? Derived.StreakDirections[FirstAxis + Axis] : FVector2f::ZeroVector;
+					Pass.StreakAxes[Axis] = FVector4f(Direction.X, Direction.Y, bUsed ? Derived.StreakWeights[FirstAxis + Axis] : 0.0f, 0.0f);
+				}
+				return Pass;
+			};
+
+			if (Settings.GlareStreakDownsample > 1)
+			{
+				// Each axis renders into its own buffer, downsampled along the axis' major component and sheared
+				// so the streak runs exactly along buffer rows (or columns): the blur direction loses resolution,
+				// the cross direction keeps it. Resolve passes stretch the buffers back and sum them into Accum.
+				const float Factor = (float)Settings.GlareStreakDownsample;
+				const FVector2f Extent(DownsampledExtent);
+				int32 Buffers[FClassicBloomPlannedPass::MaxInputs];
+				FClassicBloomAffineUVTransform BufferTransforms[FClassicBloomPlannedPass::MaxInputs];
+				int32 NumBuffers = 0;
+				int32 NumResolves = 0;
+
+				// Sliced, every group keeps the buffers of its axes
+				TArray<int32, TInlineAllocator<FClassicBloomPlannedPass::MaxInputs>> GroupSlices;
+				for (int32 Group = 0; Group < (bSliced ? NumGroups : 0); ++Group)
+				{
+					GroupSlices.Add(AddSlice({}));
+				}
+
+				for (int32 Axis = 0; Axis < NumAxes; ++Axis)
+				{
+					// Buffer pixel from a source pixel (ToBuffer) and back (ToSource), as rows of 2x3 matrices
+					const FVector2f Direction = Derived.StreakDirections[Axis];
+					FVector3f ToBufferX, ToBufferY, ToSourceX, ToSourceY;
+					FIntPoint BufferExtent;
+					if (FMath::Abs(Direction.X) >= FMath::Abs(Direction.Y))
+					{
+						const float Shear = Direction.Y / Direction.X;
+						const float Offset = FMath::Max(0.0f, Shear * Extent.X);
+						ToBufferX = FVector3f(1.0f / Factor, 0.0f, 0.0f);
+						ToBufferY = FVector3f(-Shear, 1.0f, Offset);
+						ToSourceX = FVector3f(Factor, 0.0f, 0.0f);
+						ToSourceY = FVector3f(Shear * Factor, 1.0f, -Offset);
+						BufferExtent = FIntPoint(FMath::CeilToInt(Extent.X / Factor), FMath::CeilToInt(Extent.Y + FMath::Abs(Shear) * Extent.X));
+					}
+					else
+					{
+						const float Shear = Direction.X / Direction.Y;
+						const float Offset = FMath::Max(0.0f, Shear * Extent.Y);
+						ToBufferX = FVector3f(1.0f, -Shear, Offset);
+						ToBufferY = FVector3f(0.0f, 1.0f / Factor, 0.0f);
+						ToSourceX = FVector3f(1.0f, Shear * Factor, -Offset);
+						ToSourceY = FVector3f(0.0f, Factor, 0.0f);
+						BufferExtent = FIntPoint(FMath::CeilToInt(Extent.X + FMath::Abs(Shear) * Extent.Y), FMath::CeilToInt(Extent.Y / Factor));
+					}
+
+					const int32 Buffer = AddTexture(BufferExtent, TEXT("ClassicBloom.StreakBuffer"));
+					FClassicBloomPlannedPass& StreakPass = AddStreakPass(Buffer, Axis, 1, FClassicBloomAffineUVTransform::PixelToSourceUV(ToSourceX, ToSourceY, DownsampledExtent));
+					StreakPass.NameIndex = Axis;
+					if (bSliced)
+					{
+						StreakPass.Slice = GroupSlices[GetAxisGroup(Axis)];
+						Plan.Slices[StreakPass.Slice].PersistentTextures.Add(Buffer);
+					}
+					Buffers[NumBuffers] = Buffer;
+					BufferTransforms[NumBuffers] = FClassicBloomAffineUVTransform::PixelToSourceUV(ToBufferX, ToBufferY, BufferExtent);
+					++NumBuffers;
+
+					if (NumBuffers == FClassicBloomPlannedPass::MaxInputs || Axis == NumAxes - 1)
+					{
+						FClassicBloomPlannedPass& Resolve = AddPass(EClassicBloomPassType::GlareStreakResolve, TEXT("GlareStreakResolve"), Accum, {});
+						Resolve.NameIndex = NumResolves;
+						Resolve.bAdditive = NumResolves > 0;
+						for (int32 Slot = 0; Slot < NumBuffers; ++Slot)
+						{
+							Resolve.Inputs[Slot] = Buffers[Slot];
+							Resolve.InputTransforms[Slot] = BufferTransforms[Slot];
+						}
+						Resolve.NumInputs = NumBuffers;
+						NumBuffers = 0;
+						++NumResolves;
+					}
+				}
+			}
+			else
+			{
+				// Up to MaxStreakAxes axes per pass share the center fetch and the tap weights
+				if (bSliced)
+				{
+					for (int32 Group = 0, FirstAxis = 0; Group < NumGroups; ++Group)
+					{
+						int32 EndAxis = FirstAxis;
+						while (EndAxis < NumAxes && GetAxisGroup(EndAxis) == Group)
+						{
+							++EndAxis;
+						}
+						FClassicBloomPlannedPass& Pass = AddStreakPass(GroupTargets[Group], FirstAxis, EndAxis - FirstAxis, IdentityTransform);
+						Pass.NameIndex = Group;
+						Pass.Slice = AddSlice({ GroupTargets[Group] });
+						FirstAxis = EndAxis;
+					}
+					AddGroupResolve();
+				}
+				else
+				{
+					for (int32 FirstAxis = 0; FirstAxis < NumAxes; FirstAxis += FClassicBloomPlannedPass::MaxStreakAxes)
+					{
+						FClassicBloomPlannedPass& Pass = AddStreakPass(Accum, FirstAxis, FMath::Min(NumAxes - FirstAxis, FClassicBloomPlannedPass::MaxStreakAxes), IdentityTransform);
+						Pass.NameIndex = FirstAxis / FClassicBloomPlannedPass::MaxStreakAxes;
+						Pass.bAdditive = FirstAxis > 0;
+					}
+				}
+			}
+		}
+
+		// Light Gaussian blur to smooth the glare
+		const int32 GlareBlurTemp = AddTexture(DownsampledExtent, TEXT("ClassicBloom.GlareBlurTemp"));
+		Plan.BloomTexture = AddTexture(DownsampledExtent, TEXT("ClassicBloom.GlareBlurred"));
+		AddBlur(Accum, GlareBlurTemp, Plan.BloomTexture, Derived.GlareBlurKernel, 1, TEXT("GlareBlurH"), TEXT("GlareBlurV"));
+	}
+	else if (Settings.BloomMode == EBloomMode::Kawase && Settings.KawaseMipCount > 0)
+	{
+		// The whole pyramid is one mipped texture: mip 0 is the bloom target at the downsampled resolution,
+		// mips 1..MipCount the Kawase levels, each half the previous. Upsampling accumulates back into
+		// the same mips, so the pyramid needs no separate upsample targets.
+		const int32 MaxMipCount = FMath::FloorLog2((uint32)FMath::Max(DownsampledExtent.X, DownsampledExtent.Y));
+		// With temporal reuse mip 0 is already one level coarser, so one mip less reaches as far
+		const int32 MipCount = FMath::Min(FMath::Max(Settings.KawaseMipCount - (bTemporal ? 1 : 0), 1), MaxMipCount);
+		if (MipCount <= 0)
+		{
+			return FClassicBloomPassPlan();
+		}
+
+		const int32 Pyramid = AddTexture(DownsampledExtent, TEXT("ClassicBloom.KawasePyramid"));
+		Plan.Textures[Pyramid].NumMips = MipCount + 1;
+		Plan.BloomTexture = Pyramid;
+		const FClassicBloomPlannedTexture FullPyramid = Plan.Textures[Pyramid];
+
+		// Frame slicing moves levels DeepLevel.. out of the pyramid, one slice per level so the schedule can spread
+		// them. A deep level keeps its downsample and its accumulated upsample in textures of its own: its slice
+		// reads the downsample of the level above and the accumulated level below, which the frames in between
+		// reuse, and never an in-place sum the downsample chain would feed back into.
+		const int32 DeepLevel = (bSliced && MipCount >= 3) ? 2 : MipCount + 1;
+		TArray<int32, TInlineAllocator<8>> DeepDown;
+		TArray<int32, TInlineAllocator<8>> DeepUp;
+		TArray<int32, TInlineAllocator<8>> DeepSlices;
+		if (DeepLevel <= MipCount)
+		{
+			Plan.Textures[Pyramid].NumMips = DeepLevel;
+			for (int32 Level = DeepLevel; Level <= MipCount; ++Level)
+			{
+				const FIntPoint LevelExtent = FullPyramid.GetMipExtent(Level);
+				DeepDown.Add(AddTexture(LevelExtent, TEXT("ClassicBloom.KawaseDeepDown")));
+				DeepUp.Add(Level < MipCount ? AddTexture(LevelExtent, TEXT("ClassicBloom.KawaseDeepUp")) : DeepDown.Last());
+				DeepSlices.Add(Level < MipCount ? AddSlice({ DeepDown.Last(), DeepUp.Last() }) : AddSlice({ DeepDown.Last() }));
+			}
+		}
+		auto GetLevelTexture = [&](int32 Level) { return Level < DeepLevel ? Pyramid : DeepDown[Level - DeepLevel]; };
+		auto GetAccumulatedTexture = [&](int32 Level) { return Level < DeepLevel ? Pyramid : DeepUp[Level - DeepLevel]; };
+		auto GetLevelMip = [&](int32 Level) { return Level < DeepLevel ? Level : 0; };
+		auto GetLevelSlice = [&](int32 Level) { return Level < DeepLevel ? INDEX_NONE : DeepSlices[Level - DeepLevel]; };
+
+		// Downsample: the first level reads scene color directly and applies the threshold
+		const int32 ChainMips = FMath::Min(MipCount, DeepLevel - 1);
+		int32 FirstPassMip = 0;
+		if (Settings.bKawaseSinglePassDownsample && ChainMips <= FClassicBloomKawaseChainLimits::MaxMips)
+		{
+			Plan.Textures[Pyramid].Format = ComputeFormat;
+			Plan.Textures[Pyramid].bUAV = true;
+
+			// Same filter per mip, but one dispatch writes every level
+			FClassicBloomPlannedPass& Pass = AddPass(EClassicBloomPassType::KawaseDownsampleChain, TEXT("KawaseDownsampleChain"), Pyramid, { FClassicBloomPlannedPass::SceneColorInput });
+			Pass.OutputMip = 1;
+			Pass.NumOutputMips = ChainMips;
+			Pass.SvPositionToSourceUV = FClassicBloomUVTransform::TexelToSourceUV(FullPyramid.GetMipExtent(1), SceneColorExtent, ViewRect);
+			Pass.SourceExtent = SceneColorExtent;
+			Pass.Threshold = Settings.BloomThreshold;
+			Pass.ThresholdKnee = Settings.KawaseThresholdKnee;
+			FirstPassMip = ChainMips;
+		}
+
+		// One pass per remaining level (the deep levels always, as the chain cannot write other textures)
+		for (int32 Mip = FirstPassMip; Mip < MipCount; ++Mip)
+		{
+			const FIntPoint MipExtent = FullPyramid.GetMipExtent(Mip + 1);
+			const FIntPoint SourceExtent = Mip == 0 ? SceneColorExtent : FullPyramid.GetMipExtent(Mip);
+			const FIntRect SourceRect = Mip == 0 ? ViewRect : FIntRect(FIntPoint::ZeroValue, SourceExtent);
+			const int32 Source = Mip == 0 ? FClassicBloomPlannedPass::SceneColorInput : GetLevelTexture(Mip);
+			FClassicBloomPlannedPass& Pass = AddPass(EClassicBloomPassType::KawaseDownsample, TEXT("KawaseDownsample_Mip"), GetLevelTexture(Mip + 1), { Source });
+			Pass.NameIndex = Mip;
+			Pass.Slice = GetLevelSlice(Mip + 1);
+			Pass.OutputMip = GetLevelMip(Mip + 1);
+			Pass.InputMips[0] = GetLevelMip(Mip);
+			Pass.SvPositionToSourceUV = FClassicBloomUVTransform::TexelToSourceUV(MipExtent, SourceExtent, SourceRect);
+			Pass.SourceExtent = SourceExtent;
+			Pass.Threshold = Settings.BloomThreshold;
+			Pass.ThresholdKnee = Settings.KawaseThresholdKnee;
+			Pass.MipLevel = Mip;
+		}
+
+		// The final upsample adds the thresholded first level (bilinear); copy it into the bloom mip before
+		// the upsample below accumulates into that level. A zero filter radius makes the tent filter bilinear.
+		{
+			FClassicBloomPlannedPass& Pass = AddPass(EClassicBloomPassType::KawaseUpsample, TEXT("KawaseUpsample_Base"), Pyramid, { Pyramid });
+			Pass.InputMips[0] = 1;
+			Pass.Radius = 0.0f;
+		}
+
+		// Progressive upsample with additive blend, in place: D += blur(E), C += blur(D), ...
+		for (int32 Mip = MipCount - 2; Mip >= 0; --Mip)
+		{
+			// A deep level first copies its downsample into its accumulation target (same size, zero radius)
+			if (Mip + 1 >= DeepLevel)
+			{
+				FClassicBloomPlannedPass& Copy = AddPass(EClassicBloomPassType::KawaseUpsample, TEXT("KawaseUpsample_Copy"), GetAccumulatedTexture(Mip + 1), { GetLevelTexture(Mip + 1) });
+				Copy.NameIndex = Mip;
+				Copy.Slice = GetLevelSlice(Mip + 1);
+				Copy.Radius = 0.0f;
+			}
+
+			FClassicBloomPlannedPass& Pass = AddPass(EClassicBloomPassType::KawaseUpsample, TEXT("KawaseUpsample_Mip"), GetAccumulatedTexture(Mip + 1), { GetAccumulatedTexture(Mip + 2) });
+			Pass.NameIndex = Mip;
+			Pass.Slice = GetLevelSlice(Mip + 1);
+			Pass.OutputMip = GetLevelMip(Mip + 1);
+			Pass.InputMips[0] = GetLevelMip(Mip + 2);
+			Pass.bAdditive = true;
+			Pass.Radius = Settings.KawaseFilterRadius;
+		}
+
+		// Final upsample back to the bloom resolution
+		if (MipCount > 1)
+		{
+			FClassicBloomPlannedPass& Pass = AddPass(EClassicBloomPassType::KawaseUpsample, TEXT("KawaseUpsample_Final"), Pyramid, { Pyramid });
+			Pass.InputMips[0] = 1;
+			Pass.bAdditive = true;
+			Pass.Radius = Settings.KawaseFilterRadius;
+		}
+	}
+	else if (bConvolution)
+	{
+		// Bright pass * kernel as a product of spectra. Both are zero padded to a square power-of-two size with
+		// room for the kernel's reach; only the first rows of the image hold data, so its row passes skip the rest
+		// and the column pass reads them as zero. The kernel image is centered on texel (0, 0) with wrap-around.
+		const float KernelTexels = ConvolutionLayout.KernelTexels;
+		const FIntPoint FFTSize(ConvolutionLayout.FFTSize, ConvolutionLayout.FFTSize);
+
+		auto AddSpectrum = [&](const TCHAR* Name)
+		{
+			const int32 Spectrum = AddTexture(FFTSize, Name);
+			Plan.Textures[Spectrum].Format = FClassicBloomConvolutionLayout::SpectrumFormat;
+			Plan.Textures[Spectrum].ArraySize = FClassicBloomConvolutionLayout::SpectrumSlices;
+			Plan.Textures[Spectrum].bUAV = true;
+			return Spectrum;
+		};
+		const int32 KernelSpectrum = AddSpectrum(TEXT("ClassicBloom.KernelSpectrum"));
+		const int32 Spectrum = AddSpectrum(TEXT("ClassicBloom.Spectrum"));
+		Plan.BloomTexture = AddTexture(DownsampledExtent, TEXT("ClassicBloom.Convolved"));
+		Plan.Textures[Plan.BloomTexture].Format = ComputeFormat;
+		Plan.Textures[Plan.BloomTexture].bUAV = true;
+		Plan.KernelSpectrumTexture = KernelSpectrum;
+
+		{
+			FClassicBloomPlannedPass& Pass = AddPass(EClassicBloomPassType::FFTForwardRows, TEXT("FFTKernelRows"), KernelSpectrum, { FClassicBloomPlannedPass::ConvolutionKernelInput });
+			Pass.SourceExtent = FFTSize;
+			Pass.Radius = KernelTexels;
+		}
+		AddPass(EClassicBloomPassType::FFTColumns, TEXT("FFTKernelColumns"), KernelSpectrum, { KernelSpectrum }).SourceExtent = FFTSize;
+
+		// Image: forward rows, then per column forward * kernel -> inverse in one dispatch, then inverse rows
+		AddPass(EClassicBloomPassType::FFTForwardRows, TEXT("FFTRows"), Spectrum, { BrightPass }).SourceExtent = DownsampledExtent;
+		AddPass(EClassicBloomPassType::FFTColumns, TEXT("FFTConvolveColumns"), Spectrum, { Spectrum, KernelSpectrum }).SourceExtent = DownsampledExtent;
+		AddPass(EClassicBloomPassType::FFTInverseRows, TEXT("FFTInverseRows"), Plan.BloomTexture, { Spectrum }).SourceExtent = DownsampledExtent;
+	}
+	else
+	{
+		// Standard and soft focus: separable Gaussian, ping-ponging through a temp target
+		const int32 BlurTemp = AddTexture(DownsampledExtent, TEXT("ClassicBloom.BlurTemp"));
+		Plan.BloomTexture = AddTexture(DownsampledExtent, TEXT("ClassicBloom.Blurred"));
+		AddBlur(BrightPass, BlurTemp, Plan.BloomTexture, Derived.BlurKernel, Derived.BlurIterations, TEXT("BlurHorizontal"), TEXT("BlurVertical"));
+	}
+
+	Plan.RemoveDeadPasses();
+
+	for (const FClassicBloomPlannedTexture& Texture : Plan.Textures)
+	{
+		Plan.TransientTextureBytes += Texture.GetMemorySize();
+	}
+	for (const FClassicBloomPlannedPass& Pass : Plan.Passes)
+	{
+		Plan.NumKernelSpectrumPasses += (Pass.Output == Plan.KernelSpectrumTexture) ? 1 : 0;
+	}
+
+	if (Plan.Slices.Num() > 0)
+	{
+		float FixedCost = 0.0f;
+		for (const FClassicBloomPlannedPass& Pass : Plan.Passes)
+		{
+			const float Cost = GetPassCost(Plan, Pass);
+			if (Pass.Slice != INDEX_NONE)
+			{
+				Plan.Slices[Pass.Slice].Cost += Cost;
+				++Plan.Slices[Pass.Slice].NumPasses;
+			}
+			else
+			{
+				FixedCost += Cost;
+			}
+		}
+
+		TArray<float, TInlineAllocator<FClassicBloomFrameSlicer::MaxSlices>> SliceCosts;
+		for (const FClassicBloomPlannedSlice& Slice : Plan.Slices)
+		{
+			SliceCosts.Add(Slice.Cost);
+		}
+		Plan.SliceSchedule = FClassicBloomFrameSlicer(FixedCost, SliceCosts, Settings.FrameSliceMaxCost);
+	}
+
+	return Plan;
+}
+
+void FClassicBloomPassPlan::RemoveDeadPasses()
+{
+	// Walk backwards from the bloom texture; every pass clears its output, so a write ends the need for older contents
+	TBitArray<> Needed(false, Textures.Num());
+	TBitArray<> Referenced(false, Textures.Num());
+	TBitArray<> Live(false, Passes.Num());
+	Needed[BloomTexture] = true;
+	Referenced[BloomTexture] = true;
+
+	for (int32 PassIndex = Passes.Num() - 1; PassIndex >= 0; --PassIndex)
+	{
+		const FClassicBloomPlannedPass& Pass = Passes[PassIndex];
+		if (!Needed[Pass.Output])
+		{
+			continue;
+		}
+
+		// Additive passes and passes writing only some mips keep the older contents needed
+		Live[PassIndex] = true;
+		if (!Pass.bAdditive && Pass.OutputMip == 0 && Pass.NumOutputMips == Textures[Pass.Output].NumMips)
+		{
+			Needed[Pass.Output] = false;
+		}
+		for (int32 InputIndex = 0; InputIndex < Pass.NumInputs; ++InputIndex)
+		{
+			if (Pass.Inputs[InputIndex] >= 0)
+			{
+				Needed[Pass.Inputs[InputIndex]] = true;
+				Referenced[Pass.Inputs[InputIndex]] = true;
+			}
+		}
+	}
+
+	// Compact passes, then textures, remapping indices
+	TArray<FClassicBloomPlannedPass> LivePasses;
+	LivePasses.Reserve(Passes.Num());
+	for (int32 PassIndex = 0; PassIndex < Passes.Num(); ++PassIndex)
+	{
+		if (Live[PassIndex])
+		{
+			LivePasses.Add(Passes[PassIndex]);
+		}
+	}
+	Passes = MoveTemp(LivePasses);
+
+	TArray<int32> Remap;
+	Remap.Init(INDEX_NONE, Textures.Num());
+	TArray<FClassicBloomPlannedTexture> LiveTextures;
+	for (int32 TextureIndex = 0; TextureIndex < Textures.Num(); ++TextureIndex)
+	{
+		if (Referenced[TextureIndex])
+		{
+			Remap[TextureIndex] = LiveTextures.Add(Textures[TextureIndex]);
+		}
+	}
+	Textures = MoveTemp(LiveTextures);
+
+	for (FClassicBloomPlannedPass& Pass : Passes)
+	{
+		Pass.Output = Remap[Pass.Output];
+		for (int32 InputIndex = 0; InputIndex < Pass.NumInputs; ++InputIndex)
+		{
+			if (Pass.Inputs[InputIndex] >= 0)
+			{
+				Pass.Inputs[InputIndex] = Remap[Pass.Inputs[InputIndex]];
+			}
+		}
+	}
+	BloomTexture = Remap[BloomTexture];
+	KernelSpectrumTexture = KernelSpectrumTexture != INDEX_NONE ? Remap[KernelSpectrumTexture] : INDEX_NONE;
+	for (FClassicBloomPlannedSlice& Slice : Slices)
+	{
+		for (int32& Texture : Slice.PersistentTextures)
+		{
+			Texture = Remap[Texture];
+		}
+	}
+}
+
+// ============================================================================
+// FClassicBloomPassPlanCache
+// ============================================================================
+
+const FClassicBloomPassPlan& FClassicBloomPassPlanCache::FindOrBuild(
+	const FClassicBloomRenderSettings& Settings,
+	const FClassicBloomDerivedParams& Derived,
+	FIntPoint SceneColorExtent,
+	const FIntRect& ViewRect,
+	ERHIFeatureLevel::Type FeatureLevel,
+	bool bR11G11B10SupportsUAV)
+{
+	check(IsInRenderingThread());
+
+	const uint32 FrameNumber = GFrameCounterRenderThread;
+	uint32 Hash = GetTypeHash(Settings);
+	Hash = HashCombineFast(Hash, GetTypeHash(SceneColorExtent));
+	Hash = HashCombineFast(Hash, GetTypeHash(ViewRect.Min));
+	Hash = HashCombineFast(Hash, GetTypeHash(ViewRect.Max));
+	Hash = HashCombineFast(Hash, GetTypeHash((int32)FeatureLevel));
+	Hash = HashCombineFast(Hash, GetTypeHash(bR11G11B10SupportsUAV));
+
+	for (FEntry& Entry : Entries)
+	{
+		if (Entry.Hash == Hash && Entry.FeatureLevel == FeatureLevel && Entry.bR11G11B10SupportsUAV == bR11G11B10SupportsUAV && Entry.ViewRect == ViewRect &&
+			Entry.SceneColorExtent == SceneColorExtent && Entry.Settings == Settings)
+		{
+			Entry.LastUsedFrame = FrameNumber;
+			return *Entry.Plan;
+		}
+	}
+
+	// Evict stale entries, then the least recently used one if still full
+	Entries.RemoveAllSwap([FrameNumber](const FEntry& Entry) { return FrameNumber - Entry.LastUsedFrame > MaxAge; }, EAllowShrinking::No);
+	if (Entries.Num() >= MaxEntries)
+	{
+		int32 OldestIndex = 0;
+		for (int32 Index = 1; Index < Entries.Num(); ++Index)
+		{
+			if (Entries[Index].LastUsedFrame < Entries[OldestIndex].LastUsedFrame)
+			{
+				OldestIndex = Index;
+			}
+		}
+		Entries.RemoveAtSwap(OldestIndex, 1, EAllowShrinking::No);
+	}
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Hash = Hash;
+	Entry.Settings = Settings;
+	Entry.SceneColorExtent = SceneColorExtent;
+	Entry.ViewRect = ViewRect;
+	Entry.FeatureLevel = FeatureLevel;
+	Entry.bR11G11B10SupportsUAV = bR11G11B10SupportsUAV;
+	Entry.Plan = MakeUnique<FClassicBloomPassPlan>(FClassicBloomPassPlan::Build(Settings, Derived, SceneColorExtent, ViewRect, FeatureLevel, bR11G11B10SupportsUAV));
+	Entry.LastUsedFrame = FrameNumber;
+
+	// Plans are only rebuilt when settings or view sizes change, so this is cheap to leave on
+	if (Settings.bEnableDebugLogging)
+	{
+		UE_LOG(LogClassicBloom, Log, TEXT("Built pass plan: mode %d, view %dx%d, bloom %dx%d, %d passes, %d textures (%llu KB)"),
+			(int32)Settings.BloomMode, ViewRect.Width(), ViewRect.Height(),
+			Entry.Plan->DownsampledExtent.X, Entry.Plan->DownsampledExtent.Y,
+			Entry.Plan->Passes.Num(), Entry.Plan->Textures.Num(), Entry.Plan->TransientTextureBytes / 1024);
+		if (Entry.Plan->Slices.Num() > 0)
+		{
+			UE_LOG(LogClassicBloom, Log, TEXT("Frame slicing: %d slices over %d frames, peak frame %.0f%% of the full chain"),
+				Entry.Plan->Slices.Num(), Entry.Plan->SliceSchedule.GetPeriod(), Entry.Plan->SliceSchedule.GetPeakFraction() * 100.0f);
+		}
+	}
+	return *Entry.Plan;
+}
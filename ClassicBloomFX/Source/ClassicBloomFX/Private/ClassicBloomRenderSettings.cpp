@@ -0,0 +1,309 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomRenderSettings.h"
+#include "ClassicBloomBlurKernel.h"
+#include "Engine/Texture2D.h"
+
+FClassicBloomRenderSettings FClassicBloomRenderSettings::FromComponent(const UBloomFXComponent& Component)
+{
+	check(IsInGameThread());
+
+	FClassicBloomRenderSettings Settings;
+
+	Settings.BloomMode = Component.BloomMode;
+
+	Settings.BloomIntensity = Component.BloomIntensity;
+	Settings.BloomThreshold = Component.BloomThreshold;
+	Settings.BloomSize = Component.BloomSize;
+	Settings.bUseSceneColor = Component.bUseSceneColor;
+	Settings.BloomTint = Component.BloomTint;
+	Settings.BloomBlendMode = Component.BloomBlendMode;
+	Settings.BloomSaturation = Component.BloomSaturation;
+	Settings.bProtectHighlights = Component.bProtectHighlights;
+	Settings.HighlightProtection = Component.HighlightProtection;
+
+	Settings.DownsampleScale = FMath::Clamp(Component.DownsampleScale, 0.25f, 2.0f);
+	Settings.BlurPasses = FMath::Clamp(Component.BlurPasses, 1, 4);
+	Settings.BlurSamples = FClassicBloomBlurKernel::SnapTapCount(Component.BlurSamples);
+	Settings.bHighQualityUpsampling = Component.bHighQualityUpsampling;
+	Settings.bComputeBlur = Component.bComputeBlur;
+
+	Settings.GlareStreakCount = FMath::Clamp(Component.GlareStreakCount, 2, 16);
+	Settings.GlareStreakLength = FMath::Clamp((float)Component.GlareStreakLength, 5.0f, 200.0f);
+	Settings.GlareRotationOffset = Component.GlareRotationOffset;
+	Settings.GlareFalloff = FMath::Clamp(Component.GlareFalloff, 0.5f, 10.0f);
+	Settings.bLogGlareStreaks = Component.bLogGlareStreaks;
+	Settings.GlareStreakDownsample = FMath::Clamp(Component.GlareStreakDownsample, 1, 8);
+
+	Settings.KawaseMipCount = FMath::Clamp(Component.KawaseMipCount, 3, 8);
+	Settings.KawaseFilterRadius = FMath::Clamp(Component.KawaseFilterRadius, 0.0001f, 0.01f);
+	Settings.bKawaseSoftThreshold = Component.bKawaseSoftThreshold;
+	Settings.KawaseThresholdKnee = Component.bKawaseSoftThreshold ? FMath::Clamp(Component.KawaseThresholdKnee, 0.0f, 1.0f) : 0.0f;
+	Settings.bKawaseSinglePassDownsample = Component.bKawaseSinglePassDownsample;
+
+	if (const UTexture2D* Kernel = Component.ConvolutionKernel)
+	{
+		Settings.ConvolutionKernel = Kernel;
+		Settings.ConvolutionKernelTexture = Kernel->TextureReference.TextureReferenceRHI;
+
+		// Editor builds hash the source art, so a reimport gets a new id; cooked builds and textures without source
+		// art only have the lighting GUID
+#if WITH_EDITORONLY_DATA
+		Settings.ConvolutionKernelId = Kernel->Source.GetId();
+#endif
+		if (!Settings.ConvolutionKernelId.IsValid())
+		{
+			Settings.ConvolutionKernelId = Kernel->GetLightingGuid();
+		}
+	}
+	Settings.ConvolutionKernelSize = FMath::Clamp(Component.ConvolutionKernelSize, 0.05f, 1.0f);
+	Settings.ConvolutionFFTSize = FMath::Clamp((int32)FMath::RoundUpToPowerOfTwo(FMath::Max(Component.ConvolutionFFTSize, 1)), 256, 1024);
+
+	Settings.SoftFocusParams = FVector4f(
+		Component.SoftFocusOverlayMultiplier,
+		Component.SoftFocusBlendStrength,
+		Component.SoftFocusSoftLightMultiplier,
+		Component.SoftFocusFinalBlend);
+
+	Settings.PostProcessPass = Component.PostProcessPass;
+	Settings.bUseAdaptiveBrightnessScaling = Component.bUseAdaptiveBrightnessScaling;
+	Settings.GameModeBloomScale = Component.GameModeBloomScale;
+	Settings.bBatchMultiView = Component.bBatchMultiView;
+	Settings.bTemporalReuse = Component.bTemporalReuse;
+	Settings.TemporalHistoryWeight = FMath::Clamp(Component.TemporalHistoryWeight, 0.0f, 0.98f);
+	Settings.bFrameSlicing = Component.bFrameSlicing;
+	Settings.FrameSliceMaxCost = FMath::Clamp(Component.FrameSliceMaxCost, 0.25f, 1.0f);
+	Settings.bGpuBudget = Component.bGpuBudget;
+	Settings.GpuBudgetMs = FMath::Clamp(Component.GpuBudgetMs, 0.1f, 10.0f);
+
+	Settings.bEnableDebugLogging = Component.bEnableDebugLogging;
+	Settings.bShowBloomOnly = Component.bShowBloomOnly;
+	Settings.bShowGammaCompensation = Component.bShowGammaCompensation;
+
+	return Settings;
+}
+
+void FClassicBloomRenderSettings::BlendContinuousFrom(const FClassicBloomRenderSettings& Other, float Alpha)
+{
+	BloomIntensity = FMath::Lerp(BloomIntensity, Other.BloomIntensity, Alpha);
+	BloomThreshold = FMath::Lerp(BloomThreshold, Other.BloomThreshold, Alpha);
+	BloomSize = FMath::Lerp(BloomSize, Other.BloomSize, Alpha);
+	BloomTint = FMath::Lerp(BloomTint, Other.BloomTint, Alpha);
+	BloomSaturation = FMath::Lerp(BloomSaturation, Other.BloomSaturation, Alpha);
+	HighlightProtection = FMath::Lerp(HighlightProtection, Other.HighlightProtection, Alpha);
+
+	DownsampleScale = FMath::Lerp(DownsampleScale, Other.DownsampleScale, Alpha);
+
+	GlareStreakLength = FMath::Lerp(GlareStreakLength, Other.GlareStreakLength, Alpha);
+	GlareRotationOffset = FMath::Lerp(GlareRotationOffset, Other.GlareRotationOffset, Alpha);
+	GlareFalloff = FMath::Lerp(GlareFalloff, Other.GlareFalloff, Alpha);
+
+	KawaseFilterRadius = FMath::Lerp(KawaseFilterRadius, Other.KawaseFilterRadius, Alpha);
+	KawaseThresholdKnee = FMath::Lerp(KawaseThresholdKnee, Other.KawaseThresholdKnee, Alpha);
+
+	ConvolutionKernelSize = FMath::Lerp(ConvolutionKernelSize, Other.ConvolutionKernelSize, Alpha);
+
+	SoftFocusParams = FMath::Lerp(SoftFocusParams, Other.SoftFocusParams, Alpha);
+
+	GameModeBloomScale = FMath::Lerp(GameModeBloomScale, Other.GameModeBloomScale, Alpha);
+	TemporalHistoryWeight = FMath::Lerp(TemporalHistoryWeight, Other.TemporalHistoryWeight, Alpha);
+	FrameSliceMaxCost = FMath::Lerp(FrameSliceMaxCost, Other.FrameSliceMaxCost, Alpha);
+	GpuBudgetMs = FMath::Lerp(GpuBudgetMs, Other.GpuBudgetMs, Alpha);
+}
+
+void FClassicBloomRenderSettings::CopyDiscreteFrom(const FClassicBloomRenderSettings& Other)
+{
+	BloomMode = Other.BloomMode;
+	bUseSceneColor = Other.bUseSceneColor;
+	BloomBlendMode = Other.BloomBlendMode;
+	bProtectHighlights = Other.bProtectHighlights;
+
+	BlurPasses = Other.BlurPasses;
+	BlurSamples = Other.BlurSamples;
+	bHighQualityUpsampling = Other.bHighQualityUpsampling;
+	bComputeBlur = Other.bComputeBlur;
+
+	GlareStreakCount = Other.GlareStreakCount;
+	bLogGlareStreaks = Other.bLogGlareStreaks;
+	GlareStreakDownsample = Other.GlareStreakDownsample;
+
+	KawaseMipCount = Other.KawaseMipCount;
+	bKawaseSoftThreshold = Other.bKawaseSoftThreshold;
+	bKawaseSinglePassDownsample = Other.bKawaseSinglePassDownsample;
+	if (!bKawaseSoftThreshold)
+	{
+		KawaseThresholdKnee = 0.0f;
+	}
+
+	ConvolutionKernel = Other.ConvolutionKernel;
+	ConvolutionKernelTexture = Other.ConvolutionKernelTexture;
+	ConvolutionKernelId = Other.ConvolutionKernelId;
+	ConvolutionFFTSize = Other.ConvolutionFFTSize;
+
+	PostProcessPass = Other.PostProcessPass;
+	bUseAdaptiveBrightnessScaling = Other.bUseAdaptiveBrightnessScaling;
+	bBatchMultiView = Other.bBatchMultiView;
+	bTemporalReuse = Other.bTemporalReuse;
+	bFrameSlicing = Other.bFrameSlicing;
+	bGpuBudget = Other.bGpuBudget;
+
+	bEnableDebugLogging = Other.bEnableDebugLogging;
+	bShowBloomOnly = Other.bShowBloomOnly;
+	bShowGammaCompensation = Other.bShowGammaCompensation;
+}
+
+bool FClassicBloomRenderSettings::IsBatchCompatible(const FClassicBloomRenderSettings& Other) const
+{
+	// Only what feeds the shared stages; composite parameters may differ per view. The derived bright pass
+	// threshold and blur kernel follow from the mode, threshold, size, samples and passes. bComputeBlur and
+	// bKawaseSinglePassDownsample only pick how the per-view path dispatches the same filters, and
+	// bKawaseSoftThreshold is already folded into KawaseThresholdKnee. Views at another hook would read another
+	// scene color input.
+	return bBatchMultiView && Other.bBatchMultiView
+		&& PostProcessPass == Other.PostProcessPass
+		&& BloomMode == Other.BloomMode
+		&& BloomThreshold == Other.BloomThreshold
+		&& BloomSize == Other.BloomSize
+		&& DownsampleScale == Other.DownsampleScale
+		&& BlurPasses == Other.BlurPasses
+		&& BlurSamples == Other.BlurSamples
+		&& KawaseMipCount == Other.KawaseMipCount
+		&& KawaseFilterRadius == Other.KawaseFilterRadius
+		&& KawaseThresholdKnee == Other.KawaseThresholdKnee
+		&& !UsesTemporalReuse() && !Other.UsesTemporalReuse()
+		&& !UsesFrameSlicing() && !Other.UsesFrameSlicing();
+}
+
+FClassicBloomQualityLevel FClassicBloomRenderSettings::GetQualityLevel() const
+{
+	FClassicBloomQualityLevel Level;
+	Level.DownsampleDivisor = GetDownsampleDivisor();
+	Level.BlurPasses = BlurPasses;
+	Level.KawaseMipCount = KawaseMipCount;
+	Level.GlareStreakCount = GlareStreakCount;
+	return Level;
+}
+
+EClassicBloomQualityAxes FClassicBloomRenderSettings::GetQualityAxes() const
+{
+	switch (BloomMode)
+	{
+	case EBloomMode::Standard:
+	case EBloomMode::SoftFocus:
+		return EClassicBloomQualityAxes::DownsampleDivisor | EClassicBloomQualityAxes::BlurPasses;
+	case EBloomMode::DirectionalGlare:
+		return EClassicBloomQualityAxes::DownsampleDivisor | EClassicBloomQualityAxes::GlareStreakCount;
+	case EBloomMode::Kawase:
+		return EClassicBloomQualityAxes::DownsampleDivisor | EClassicBloomQualityAxes::KawaseMipCount;
+	default:
+		// FFT convolution is sized by the FFT, not the divisor
+		return EClassicBloomQualityAxes::None;
+	}
+}
+
+void FClassicBloomRenderSettings::ApplyQualityLevel(const FClassicBloomQualityLevel& Level)
+{
+	// Leave the authored scale alone when it already gives this divisor, so level 0 keeps the same settings value
+	if (Level.DownsampleDivisor != GetDownsampleDivisor())
+	{
+		DownsampleScale = 2.0f / (float)FMath::Max(Level.DownsampleDivisor, 1);
+	}
+	BlurPasses = Level.BlurPasses;
+	KawaseMipCount = Level.KawaseMipCount;
+	GlareStreakCount = Level.GlareStreakCount;
+}
+
+bool FClassicBloomRenderSettings::operator==(const FClassicBloomRenderSettings& Other) const
+{
+	return BloomMode == Other.BloomMode
+		&& BloomIntensity == Other.BloomIntensity
+		&& BloomThreshold == Other.BloomThreshold
+		&& BloomSize == Other.BloomSize
+		&& bUseSceneColor == Other.bUseSceneColor
+		&& BloomTint == Other.BloomTint
+		&& BloomBlendMode == Other.BloomBlendMode
+		&& BloomSaturation == Other.BloomSaturation
+		&& bProtectHighlights == Other.bProtectHighlights
+		&& HighlightProtection == Other.HighlightProtection
+		&& DownsampleScale == Other.DownsampleScale
+		&& BlurPasses == Other.BlurPasses
+		&& BlurSamples == Other.BlurSamples
+		&& bHighQualityUpsampling == Other.bHighQualityUpsampling
+		&& bComputeBlur == Other.bComputeBlur
+		&& GlareStreakCount == Other.GlareStreakCount
+		&& GlareStreakLength == Other.GlareStreakLength
+		&& GlareRotationOffset == Other.GlareRotationOffset
+		&& GlareFalloff == Other.GlareFalloff
+		&& bLogGlareStreaks == Other.bLogGlareStreaks
+		&& GlareStreakDownsample == Other.GlareStreakDownsample
+		&& KawaseMipCount == Other.KawaseMipCount
+		&& KawaseFilterRadius == Other.KawaseFilterRadius
+		&& bKawaseSoftThreshold == Other.bKawaseSoftThreshold
+		&& KawaseThresholdKnee == Other.KawaseThresholdKnee
+		&& bKawaseSinglePassDownsample == Other.bKawaseSinglePassDownsample
+		&& ConvolutionKernelId == Other.ConvolutionKernelId
+		&& ConvolutionKernelSize == Other.ConvolutionKernelSize
+		&& ConvolutionFFTSize == Other.ConvolutionFFTSize
+		&& SoftFocusParams == Other.SoftFocusParams
+		&& PostProcessPass == Other.PostProcessPass
+		&& bUseAdaptiveBrightnessScaling == Other.bUseAdaptiveBrightnessScaling
+		&& GameModeBloomScale == Other.GameModeBloomScale
+		&& bBatchMultiView == Other.bBatchMultiView
+		&& bTemporalReuse == Other.bTemporalReuse
+		&& TemporalHistoryWeight == Other.TemporalHistoryWeight
+		&& bFrameSlicing == Other.bFrameSlicing
+		&& FrameSliceMaxCost == Other.FrameSliceMaxCost
+		&& bGpuBudget == Other.bGpuBudget
+		&& GpuBudgetMs == Other.GpuBudgetMs
+		&& bEnableDebugLogging == Other.bEnableDebugLogging
+		&& bShowBloomOnly == Other.bShowBloomOnly
+		&& bShowGammaCompensation == Other.bShowGammaCompensation;
+}
+
+uint32 GetTypeHash(const FClassicBloomRenderSettings& Settings)
+{
+	uint32 Hash = GetTypeHash(Settings.BloomMode);
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.BloomIntensity));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.BloomThreshold));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.BloomSize));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.bUseSceneColor));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.BloomTint));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.BloomBlendMode));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.BloomSaturation));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.bProtectHighlights));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.HighlightProtection));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.DownsampleScale));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.BlurPasses));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.BlurSamples));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.bHighQualityUpsampling));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.bComputeBlur));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.GlareStreakCount));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.GlareStreakLength));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.GlareRotationOffset));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.GlareFalloff));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.bLogGlareStreaks));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.GlareStreakDownsample));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.KawaseMipCount));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.KawaseFilterRadius));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.bKawaseSoftThreshold));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.KawaseThresholdKnee));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.bKawaseSinglePassDownsample));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.ConvolutionKernelId));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.ConvolutionKernelSize));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.ConvolutionFFTSize));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.SoftFocusParams));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.PostProcessPass));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.bUseAdaptiveBrightnessScaling));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.GameModeBloomScale));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.bBatchMultiView));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.bTemporalReuse));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.TemporalHistoryWeight));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.bFrameSlicing));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.FrameSliceMaxCost));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.bGpuBudget));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.GpuBudgetMs));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.bEnableDebugLogging));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.bShowBloomOnly));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings.bShowGammaCompensation));
+	return Hash;
+}
@@ -2,14 +2,56 @@
 
 #include "ClassicBloomShaders.h"
 #include "ShaderParameterUtils.h"
+#include "RenderUtils.h"
+
+bool FClassicBloomCompositePS::ShouldCompileComposite(const FPermutationDomain& PermutationVector, EShaderPlatform Platform)
+{
+	if (!IsFeatureLevelSupported(Platform, ERHIFeatureLevel::SM5) || RemapPermutation(PermutationVector) != PermutationVector)
+	{
+		return false;
+	}
+
+	// Debug views are stripped from cooks that do not allow debug view modes (Shipping content)
+	return PermutationVector.Get<FDebugViewDim>() == 0 || AllowDebugViewmodes(Platform);
+}
+
+int32 FClassicBloomCompositePS::GetNumCompiledPermutations(EShaderPlatform Platform)
+{
+	int32 NumCompiled = 0;
+	for (int32 PermutationId = 0; PermutationId < FPermutationDomain::PermutationCount; ++PermutationId)
+	{
+		if (ShouldCompileComposite(FPermutationDomain(PermutationId), Platform))
+		{
+			++NumCompiled;
+		}
+	}
+	return NumCompiled;
+}
 
 // Implement the pixel shaders
 IMPLEMENT_GLOBAL_SHADER(FClassicBloomBrightPassPS, "/Plugin/ClassicBloomFX/Private/ClassicBloomShaders.usf", "BrightPassPS", SF_Pixel);
 IMPLEMENT_GLOBAL_SHADER(FClassicBloomBlurPS, "/Plugin/ClassicBloomFX/Private/ClassicBloomBlur.usf", "GaussianBlurPS", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FClassicBloomBlurCS, "/Plugin/ClassicBloomFX/Private/ClassicBloomBlurCompute.usf", "GaussianBlurCS", SF_Compute);
 IMPLEMENT_GLOBAL_SHADER(FClassicBloomCompositePS, "/Plugin/ClassicBloomFX/Private/ClassicBloomComposite.usf", "CompositeBloomPS", SF_Pixel);
 IMPLEMENT_GLOBAL_SHADER(FClassicBloomGlareStreakPS, "/Plugin/ClassicBloomFX/Private/ClassicBloomGlare.usf", "GlareStreakPS", SF_Pixel);
-IMPLEMENT_GLOBAL_SHADER(FClassicBloomGlareAccumulatePS, "/Plugin/ClassicBloomFX/Private/ClassicBloomGlare.usf", "GlareAccumulatePS", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FClassicBloomGlareStreakResolvePS, "/Plugin/ClassicBloomFX/Private/ClassicBloomGlare.usf", "GlareStreakResolvePS", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FClassicBloomGlareStreakStepPS, "/Plugin/ClassicBloomFX/Private/ClassicBloomGlare.usf", "GlareStreakStepPS", SF_Pixel);
 
 // Kawase bloom shaders
 IMPLEMENT_GLOBAL_SHADER(FClassicBloomKawaseDownsamplePS, "/Plugin/ClassicBloomFX/Private/ClassicBloomKawase.usf", "KawaseDownsamplePS", SF_Pixel);
 IMPLEMENT_GLOBAL_SHADER(FClassicBloomKawaseUpsamplePS, "/Plugin/ClassicBloomFX/Private/ClassicBloomKawase.usf", "KawaseUpsamplePS", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FClassicBloomKawaseDownsampleChainCS, "/Plugin/ClassicBloomFX/Private/ClassicBloomKawaseChain.usf", "KawaseDownsampleChainCS", SF_Compute);
+
+// FFT convolution shaders
+IMPLEMENT_GLOBAL_SHADER(FClassicBloomFFTForwardRowsCS, "/Plugin/ClassicBloomFX/Private/ClassicBloomFFT.usf", "FFTForwardRowsCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FClassicBloomFFTColumnsCS, "/Plugin/ClassicBloomFX/Private/ClassicBloomFFT.usf", "FFTColumnsCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FClassicBloomFFTInverseRowsCS, "/Plugin/ClassicBloomFX/Private/ClassicBloomFFT.usf", "FFTInverseRowsCS", SF_Compute);
+
+// Temporal reuse shaders
+IMPLEMENT_GLOBAL_SHADER(FClassicBloomTemporalResolvePS, "/Plugin/ClassicBloomFX/Private/ClassicBloomTemporal.usf", "TemporalResolvePS", SF_Pixel);
+
+// Batched multi-view shaders
+IMPLEMENT_GLOBAL_SHADER(FClassicBloomBatchedBrightPassCS, "/Plugin/ClassicBloomFX/Private/ClassicBloomBatched.usf", "BatchedBrightPassCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FClassicBloomBatchedBlurCS, "/Plugin/ClassicBloomFX/Private/ClassicBloomBatched.usf", "BatchedBlurCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FClassicBloomBatchedKawaseDownsampleCS, "/Plugin/ClassicBloomFX/Private/ClassicBloomBatched.usf", "BatchedKawaseDownsampleCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FClassicBloomBatchedKawaseUpsampleCS, "/Plugin/ClassicBloomFX/Private/ClassicBloomBatched.usf", "BatchedKawaseUpsampleCS", SF_Compute);
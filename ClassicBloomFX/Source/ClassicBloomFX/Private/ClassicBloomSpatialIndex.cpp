@@ -0,0 +1,273 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomSpatialIndex.h"
+#include "BloomFXVolumeComponent.h"
+#include "Algo/Sort.h"
+
+// Boxes per leaf; small volume counts end up as a single leaf
+static constexpr int32 ClassicBloomMaxItemsPerLeaf = 4;
+
+// ============================================================================
+// FClassicBloomBoundsTree
+// ============================================================================
+
+void FClassicBloomBoundsTree::Reset()
+{
+	Nodes.Reset();
+	Items.Reset();
+}
+
+void FClassicBloomBoundsTree::Build(TConstArrayView<FBox> Bounds)
+{
+	Reset();
+
+	if (Bounds.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FVector> Centers;
+	Centers.Reserve(Bounds.Num());
+	Items.Reserve(Bounds.Num());
+	for (int32 Index = 0; Index < Bounds.Num(); ++Index)
+	{
+		Centers.Add(Bounds[Index].GetCenter());
+		Items.Add(Index);
+	}
+
+	// A binary tree with small leaves has at most 2n nodes
+	Nodes.Reserve(2 * Bounds.Num());
+	BuildNode(Bounds, Centers, 0, Bounds.Num());
+}
+
+void FClassicBloomBoundsTree::BuildNode(TConstArrayView<FBox> Bounds, const TArray<FVector>& Centers, int32 Begin, int32 End)
+{
+	const int32 NodeIndex = Nodes.AddDefaulted();
+
+	FBox NodeBounds(ForceInit);
+	FBox CenterBounds(ForceInit);
+	for (int32 ItemIndex = Begin; ItemIndex < End; ++ItemIndex)
+	{
+		NodeBounds += Bounds[Items[ItemIndex]];
+		CenterBounds += Centers[Items[ItemIndex]];
+	}
+	Nodes[NodeIndex].Bounds = NodeBounds;
+
+	if (End - Begin <= ClassicBloomMaxItemsPerLeaf)
+	{
+		Nodes[NodeIndex].FirstItem = Begin;
+		Nodes[NodeIndex].NumItems = End - Begin;
+		return;
+	}
+
+	// Median split along the longest axis of the item centers
+	const FVector CenterSize = CenterBounds.GetSize();
+	const int32 Axis = (CenterSize.X >= CenterSize.Y && CenterSize.X >= CenterSize.Z) ? 0 : (CenterSize.Y >= CenterSize.Z ? 1 : 2);
+	Algo::Sort(MakeArrayView(Items.GetData() + Begin, End - Begin), [&Centers, Axis](int32 A, int32 B)
+	{
+		return Centers[A][Axis] < Centers[B][Axis];
+	});
+
+	const int32 Mid = Begin + (End - Begin) / 2;
+	BuildNode(Bounds, Centers, Begin, Mid);
+	Nodes[NodeIndex].RightChild = Nodes.Num();
+	BuildNode(Bounds, Centers, Mid, End);
+}
+
+void FClassicBloomBoundsTree::QueryPoint(const FVector& Point, TArray<int32, TInlineAllocator<16>>& OutItems) const
+{
+	if (Nodes.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<int32, TInlineAllocator<32>> Stack;
+	Stack.Add(0);
+
+	while (Stack.Num() > 0)
+	{
+		const FNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+		if (!Node.Bounds.IsInsideOrOn(Point))
+		{
+			continue;
+		}
+
+		if (Node.NumItems > 0)
+		{
+			for (int32 ItemIndex = Node.FirstItem; ItemIndex < Node.FirstItem + Node.NumItems; ++ItemIndex)
+			{
+				OutItems.Add(Items[ItemIndex]);
+			}
+		}
+		else
+		{
+			const int32 NodeIndex = UE_PTRDIFF_TO_INT32(&Node - Nodes.GetData());
+			Stack.Add(Node.RightChild);
+			Stack.Add(NodeIndex + 1);
+		}
+	}
+}
+
+// ============================================================================
+// FClassicBloomVolumeProxy
+// ============================================================================
+
+FBox FClassicBloomVolumeProxy::GetInfluenceBounds() const
+{
+	return FBox(-BoxExtent, BoxExtent).TransformBy(ComponentToWorld).ExpandBy(BlendRadius);
+}
+
+float FClassicBloomVolumeProxy::GetWeightAt(const FVector& Location) const
+{
+	// Closest point on the (possibly rotated and scaled) box, measured in world units
+	const FVector LocalLocation = ComponentToWorld.InverseTransformPosition(Location);
+	const FVector LocalClosest = LocalLocation.BoundToBox(-BoxExtent, BoxExtent);
+	if (LocalClosest.Equals(LocalLocation))
+	{
+		return BlendWeight;
+	}
+
+	if (BlendRadius <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	const float Distance = FVector::Dist(ComponentToWorld.TransformPosition(LocalClosest), Location);
+	return BlendWeight * FMath::Clamp(1.0f - Distance / BlendRadius, 0.0f, 1.0f);
+}
+
+// ============================================================================
+// FClassicBloomVolumeIndex
+// ============================================================================
+
+void FClassicBloomVolumeIndex::Add(UBloomFXVolumeComponent* Volume)
+{
+	if (Volume)
+	{
+		Volumes.AddUnique(Volume);
+		bDirty = true;
+	}
+}
+
+void FClassicBloomVolumeIndex::Remove(UBloomFXVolumeComponent* Volume)
+{
+	if (Volume && Volumes.Remove(Volume) > 0)
+	{
+		bDirty = true;
+	}
+}
+
+bool FClassicBloomVolumeIndex::Contains(const UBloomFXVolumeComponent* Volume) const
+{
+	return Volumes.Contains(Volume);
+}
+
+bool FClassicBloomVolumeIndex::HasActiveVolumes()
+{
+	if (bDirty)
+	{
+		Rebuild();
+	}
+	return Proxies.Num() > 0;
+}
+
+void FClassicBloomVolumeIndex::Rebuild()
+{
+	check(IsInGameThread());
+
+	bDirty = false;
+	Proxies.Reset();
+
+	TArray<FBox> Bounds;
+	Bounds.Reserve(Volumes.Num());
+
+	for (const TWeakObjectPtr<UBloomFXVolumeComponent>& VolumePtr : Volumes)
+	{
+		const UBloomFXVolumeComponent* Volume = VolumePtr.Get();
+		if (!Volume || !Volume->IsActive() || !Volume->GetRenderSettings().IsValid() || Volume->BlendWeight <= 0.0f)
+		{
+			continue;
+		}
+
+		FClassicBloomVolumeProxy& Proxy = Proxies.AddDefaulted_GetRef();
+		Proxy.Settings = Volume->GetRenderSettings();
+		Proxy.ComponentToWorld = Volume->GetComponentTransform();
+		Proxy.BoxExtent = Volume->BoxExtent.ComponentMax(FVector::ZeroVector);
+		Proxy.Priority = Volume->Priority;
+		Proxy.BlendRadius = FMath::Max(Volume->BlendRadius, 0.0f);
+		Proxy.BlendWeight = FMath::Clamp(Volume->BlendWeight, 0.0f, 1.0f);
+		Bounds.Add(Proxy.GetInfluenceBounds());
+	}
+
+	Tree.Build(Bounds);
+}
+
+FClassicBloomRenderSettingsPtr FClassicBloomVolumeIndex::Resolve(const FVector& Location, const FClassicBloomRenderSettingsPtr& BaseSettings)
+{
+	if (bDirty)
+	{
+		Rebuild();
+	}
+
+	TArray<int32, TInlineAllocator<16>> Candidates;
+	Tree.QueryPoint(Location, Candidates);
+
+	struct FContribution
+	{
+		const FClassicBloomVolumeProxy* Proxy;
+		float Weight;
+	};
+
+	TArray<FContribution, TInlineAllocator<16>> Contributions;
+	for (int32 ProxyIndex : Candidates)
+	{
+		const FClassicBloomVolumeProxy& Proxy = Proxies[ProxyIndex];
+		const float Weight = Proxy.GetWeightAt(Location);
+		if (Weight > 0.0f)
+		{
+			Contributions.Add({ &Proxy, Weight });
+		}
+	}
+
+	if (Contributions.Num() == 0)
+	{
+		return BaseSettings;
+	}
+
+	// Lowest priority first, so higher priority volumes are blended on top
+	Algo::StableSortBy(Contributions, [](const FContribution& Contribution) { return Contribution.Proxy->Priority; });
+
+	// Without a global component, fade the lowest priority volume in from zero intensity
+	FClassicBloomRenderSettings Result = BaseSettings.IsValid() ? *BaseSettings : *Contributions[0].Proxy->Settings;
+	if (!BaseSettings.IsValid())
+	{
+		Result.BloomIntensity = 0.0f;
+	}
+
+	// Effective weight of each source after everything above it has been blended in
+	float BaseWeight = 1.0f;
+	float BestWeight = 0.0f;
+	const FClassicBloomRenderSettings* BestSettings = nullptr;
+	for (int32 Index = Contributions.Num() - 1; Index >= 0; --Index)
+	{
+		const float EffectiveWeight = Contributions[Index].Weight * BaseWeight;
+		if (EffectiveWeight > BestWeight)
+		{
+			BestWeight = EffectiveWeight;
+			BestSettings = Contributions[Index].Proxy->Settings.Get();
+		}
+		BaseWeight *= 1.0f - Contributions[Index].Weight;
+	}
+
+	for (const FContribution& Contribution : Contributions)
+	{
+		Result.BlendContinuousFrom(*Contribution.Proxy->Settings, Contribution.Weight);
+	}
+
+	if (BestSettings && BestWeight > BaseWeight)
+	{
+		Result.CopyDiscreteFrom(*BestSettings);
+	}
+
+	return MakeShared<const FClassicBloomRenderSettings, ESPMode::ThreadSafe>(MoveTemp(Result));
+}
@@ -2,31 +2,230 @@
 
 #include "ClassicBloomSubsystem.h"
 #include "BloomFXComponent.h"
+#include "BloomFXVolumeComponent.h"
 #include "ClassicBloomShaders.h"
+#include "ClassicBloomDerivedParams.h"
+#include "ClassicBloomPassPlan.h"
+#include "ClassicBloomStats.h"
+#include "ClassicBloomCVars.h"
+#include "ClassicBloomTrace.h"
 #include "SceneView.h"
 #include "SceneRendering.h"
+#include "SceneRenderTargetParameters.h"
 #include "ScreenPass.h"
 #include "PostProcess/PostProcessMaterialInputs.h"
 #include "RenderGraphUtils.h"
 #include "PixelShaderUtils.h"
+#include "RenderUtils.h"
+#include "SystemTextures.h"
+#include "Math/Halton.h"
+#include "Misc/ScopeExit.h"
+#include "Engine/Texture2D.h"
+#include "TextureResource.h"
+#include "GameFramework/PlayerController.h"
+
+// GPU timings per bloom stage (stat gpu, ProfileGPU, CSV GPU captures)
+DECLARE_GPU_STAT_NAMED(ClassicBloomBrightPass, TEXT("ClassicBloom: Bright Pass"));
+DECLARE_GPU_STAT_NAMED(ClassicBloomBlur, TEXT("ClassicBloom: Blur"));
+DECLARE_GPU_STAT_NAMED(ClassicBloomGlareStreak, TEXT("ClassicBloom: Glare Streaks"));
+DECLARE_GPU_STAT_NAMED(ClassicBloomKawaseDown, TEXT("ClassicBloom: Kawase Downsample"));
+DECLARE_GPU_STAT_NAMED(ClassicBloomKawaseUp, TEXT("ClassicBloom: Kawase Upsample"));
+DECLARE_GPU_STAT_NAMED(ClassicBloomConvolution, TEXT("ClassicBloom: FFT Convolution"));
+DECLARE_GPU_STAT_NAMED(ClassicBloomTemporal, TEXT("ClassicBloom: Temporal Resolve"));
+DECLARE_GPU_STAT_NAMED(ClassicBloomComposite, TEXT("ClassicBloom: Composite"));
+
+// GPU stat plus exclusive CSV timing for one bloom stage
+#define CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, Stage) \
+	RDG_GPU_STAT_SCOPE(GraphBuilder, Stage); \
+	RDG_CSV_STAT_EXCLUSIVE_SCOPE(GraphBuilder, Stage)
+
+// Per-view bloom summary for Unreal Insights
+UE_TRACE_EVENT_BEGIN(ClassicBloom, ViewFrame)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, SetupCycles)
+	UE_TRACE_EVENT_FIELD(uint32, FrameNumber)
+	UE_TRACE_EVENT_FIELD(uint32, ViewKey)
+	UE_TRACE_EVENT_FIELD(uint32, SettingsHash)
+	UE_TRACE_EVENT_FIELD(uint16, ViewWidth)
+	UE_TRACE_EVENT_FIELD(uint16, ViewHeight)
+	UE_TRACE_EVENT_FIELD(uint16, BloomWidth)
+	UE_TRACE_EVENT_FIELD(uint16, BloomHeight)
+	UE_TRACE_EVENT_FIELD(uint16, PassCount)
+	UE_TRACE_EVENT_FIELD(uint8, Mode)
+	UE_TRACE_EVENT_FIELD(int8, BatchedSlice)
+UE_TRACE_EVENT_END()
+
+// Add to the per-frame pass and transient memory counters (stat ClassicBloom and CSV)
+static void AccountBloomPasses(int32 NumPasses, uint64 TransientTextureBytes)
+{
+	INC_DWORD_STAT_BY(STAT_ClassicBloom_Passes, NumPasses);
+	INC_DWORD_STAT_BY(STAT_ClassicBloom_TransientTextureBytes, (uint32)TransientTextureBytes);
+	CSV_CUSTOM_STAT(ClassicBloom, Passes, NumPasses, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(ClassicBloom, TransientTextureMB, (float)((double)TransientTextureBytes / (1024.0 * 1024.0)), ECsvCustomStatOp::Accumulate);
+}
+
+// Per-view settings not refreshed for this many frames are dropped on the render thread
+static constexpr uint32 ClassicBloomViewSettingsMaxAge = 8;
+
+// Convert our custom enum to engine enum
+static EPostProcessingPass GetEnginePostProcessPass(EBloomPostProcessPass Pass)
+{
+	switch (Pass)
+	{
+		case EBloomPostProcessPass::Tonemap:
+			return EPostProcessingPass::Tonemap;
+		case EBloomPostProcessPass::MotionBlur:
+			return EPostProcessingPass::MotionBlur;
+		case EBloomPostProcessPass::FXAA:
+			return EPostProcessingPass::FXAA;
+		case EBloomPostProcessPass::VisualizeDepthOfField:
+			return EPostProcessingPass::VisualizeDepthOfField;
+		default:
+			return EPostProcessingPass::MotionBlur;
+	}
+}
 
 // ============================================================================
 // FClassicBloomSceneViewExtension Implementation
 // ============================================================================
 
-FClassicBloomSceneViewExtension::FClassicBloomSceneViewExtension(const FAutoRegister& AutoRegister, UClassicBloomSubsystem* InSubsystem)
+FClassicBloomSceneViewExtension::FClassicBloomSceneViewExtension(const FAutoRegister& AutoRegister, UClassicBloomSubsystem* InSubsystem, TSharedRef<FClassicBloomComponentRegistry, ESPMode::ThreadSafe> InRegistry,
+	TSharedRef<FClassicBloomKernelSpectrumCache, ESPMode::ThreadSafe> InKernelSpectrumCache)
 	: FSceneViewExtensionBase(AutoRegister)
 	, WeakSubsystem(InSubsystem)
+	, Registry(MoveTemp(InRegistry))
+	, KernelSpectrumCache(MoveTemp(InKernelSpectrumCache))
 {
 }
 
 void FClassicBloomSceneViewExtension::SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView)
 {
-	// now do rendering in the PostProcessPass_RenderThread instead
+	// Rendering happens in PostProcessPass_RenderThread; here only resolve the settings for the view,
+	// once per view per frame (view target component or player override, then bloom volumes)
+	UClassicBloomSubsystem* Subsystem = WeakSubsystem.Get();
+	const uint32 ViewKey = InView.GetViewKey();
+	if (!Subsystem || ViewKey == 0 || !Subsystem->NeedsPerViewSettings())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ClassicBloom_ResolveSettings);
+
+	FClassicBloomRenderSettingsPtr Resolved = Subsystem->ResolveSettingsForView(InView);
+
+	// Keep handing out the same snapshot while the blend result does not change
+	FViewSettingsEntry& Previous = ViewSettings_GameThread.FindOrAdd(ViewKey);
+	if (!(Previous.Settings.IsValid() && Resolved.IsValid() && *Previous.Settings == *Resolved))
+	{
+		Previous.Settings = MoveTemp(Resolved);
+	}
+	Previous.LastUsedFrame = (uint32)GFrameCounter;
+
+	PendingViewSettings.Emplace(ViewKey, Previous.Settings);
+}
+
+void FClassicBloomSceneViewExtension::BeginRenderViewFamily(FSceneViewFamily& InViewFamily)
+{
+	// With no volumes or overrides left, drop every per-view entry once so views fall back to the global settings
+	if (PendingViewSettings.Num() == 0)
+	{
+		if (ViewSettings_GameThread.Num() == 0)
+		{
+			return;
+		}
+		ViewSettings_GameThread.Reset();
+	}
+	else
+	{
+		const uint32 FrameNumber = (uint32)GFrameCounter;
+		for (auto It = ViewSettings_GameThread.CreateIterator(); It; ++It)
+		{
+			if (FrameNumber - It.Value().LastUsedFrame > ClassicBloomViewSettingsMaxAge)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	ENQUEUE_RENDER_COMMAND(ClassicBloomUpdateViewSettings)(
+		[Extension = StaticCastSharedRef<FClassicBloomSceneViewExtension>(AsShared()), ViewSettings = MoveTemp(PendingViewSettings)](FRHICommandListImmediate& RHICmdList) mutable
+		{
+			if (ViewSettings.Num() == 0)
+			{
+				Extension->ViewSettings_RenderThread.Reset();
+				return;
+			}
+
+			const uint32 FrameNumber = GFrameCounterRenderThread;
+			for (TPair<uint32, FClassicBloomRenderSettingsPtr>& ViewSetting : ViewSettings)
+			{
+				FViewSettingsEntry& Entry = Extension->ViewSettings_RenderThread.FindOrAdd(ViewSetting.Key);
+				Entry.Settings = MoveTemp(ViewSetting.Value);
+				Entry.LastUsedFrame = FrameNumber;
+			}
+
+			for (auto It = Extension->ViewSettings_RenderThread.CreateIterator(); It; ++It)
+			{
+				if (FrameNumber - It.Value().LastUsedFrame > ClassicBloomViewSettingsMaxAge)
+				{
+					It.RemoveCurrent();
+				}
+			}
+		});
+
+	PendingViewSettings.Reset();
+}
+
+const FClassicBloomRenderSettings* FClassicBloomSceneViewExtension::GetViewSettings_RenderThread(const FSceneView& View) const
+{
+	check(IsInRenderingThread());
+
+	const uint32 ViewKey = View.GetViewKey();
+	if (ViewKey != 0)
+	{
+		if (const FViewSettingsEntry* Entry = ViewSettings_RenderThread.Find(ViewKey))
+		{
+			return Entry->Settings.Get();
+		}
+	}
+
+	return Registry->GetActiveSettings();
+}
+
+const FClassicBloomRenderSettings* FClassicBloomSceneViewExtension::GetRenderSettings_RenderThread(const FSceneView& View, FClassicBloomRenderSettings& Storage)
+{
+	const FClassicBloomRenderSettings* Settings = GetViewSettings_RenderThread(View);
+	if (!Settings)
+	{
+		return nullptr;
+	}
+
+	// Scalability caps come first, so the GPU budget's ladder starts from what they leave
+	const FClassicBloomCVarOverrides Overrides = FClassicBloomCVarOverrides::Get_RenderThread();
+	if (!Overrides.IsEmpty())
+	{
+		Storage = *Settings;
+		Overrides.Apply(Storage);
+		Settings = &Storage;
+	}
+
+	if (Settings->UsesGpuBudget() && FClassicBloomGpuTimer::IsSupported())
+	{
+		Settings = &ApplyGpuBudget_RenderThread(View, *Settings, Storage);
+	}
+	return Settings;
 }
 
 void FClassicBloomSceneViewExtension::SubscribeToPostProcessingPass(EPostProcessingPass PassId, const FSceneView& View, FAfterPassCallbackDelegateArray& InOutPassCallbacks, bool bIsPassEnabled)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ClassicBloom_Subscribe);
+
+	// r.ClassicBloom.Enable 0 leaves every pass untouched
+	if (!FClassicBloomCVarOverrides::IsBloomEnabled())
+	{
+		return;
+	}
+
 	// Filter out unwanted views at subscription time
 	const FSceneViewFamily* Family = View.Family;
 	if (!Family)
@@ -61,45 +260,15 @@ void FClassicBloomSceneViewExtension::SubscribeToPostProcessingPass(EPostProcess
 		return;
 	}
 
-	// Get subsystem to check which pass to subscribe to
-	UClassicBloomSubsystem* Subsystem = WeakSubsystem.Get();
-	if (!Subsystem)
+	// Settings snapshot for this view (no UObject access on the render thread)
+	const FClassicBloomRenderSettings* Settings = GetViewSettings_RenderThread(View);
+	if (!Settings)
 	{
 		return;
 	}
 
-	// Find active component and get desired post-process pass
-	EPostProcessingPass DesiredPass = EPostProcessingPass::MotionBlur; // Default
-	bool bEnableDebug = false;
-	
-	const TArray<TWeakObjectPtr<UBloomFXComponent>>& Components = Subsystem->GetBloomComponents();
-	for (const TWeakObjectPtr<UBloomFXComponent>& CompPtr : Components)
-	{
-		if (CompPtr.IsValid() && CompPtr->IsActive())
-		{
-			// Convert our custom enum to engine enum
-			switch (CompPtr->PostProcessPass)
-			{
-				case EBloomPostProcessPass::Tonemap:
-					DesiredPass = EPostProcessingPass::Tonemap;
-					break;
-				case EBloomPostProcessPass::MotionBlur:
-					DesiredPass = EPostProcessingPass::MotionBlur;
-					break;
-				case EBloomPostProcessPass::FXAA:
-					DesiredPass = EPostProcessingPass::FXAA;
-					break;
-				case EBloomPostProcessPass::VisualizeDepthOfField:
-					DesiredPass = EPostProcessingPass::VisualizeDepthOfField;
-					break;
-				default:
-					DesiredPass = EPostProcessingPass::MotionBlur;
-					break;
-			}
-			bEnableDebug = CompPtr->bEnableDebugLogging;
-			break;
-		}
-	}
+	const EPostProcessingPass DesiredPass = GetEnginePostProcessPass(Settings->PostProcessPass);
+	const bool bEnableDebug = Settings->bEnableDebugLogging;
 
 	// Subscribe to the selected post-process pass
 	if (PassId == DesiredPass)
@@ -113,29 +282,17 @@ void FClassicBloomSceneViewExtension::SubscribeToPostProcessingPass(EPostProcess
 			// Already have callbacks for this pass, skip to prevent double-application
 			if (bEnableDebug)
 			{
-				static double LastSkipLogTime = 0.0;
-				double CurrentTime = FPlatformTime::Seconds();
-				if (CurrentTime - LastSkipLogTime > 2.0)
-				{
-					LastSkipLogTime = CurrentTime;
-					UE_LOG(LogTemp, Warning, TEXT("ClassicBloom: Skipped duplicate subscription (already %d callbacks), preventing double-application"), 
-						InOutPassCallbacks.Num());
-				}
+				UE_LOG(LogClassicBloom, Verbose, TEXT("Skipped duplicate subscription (already %d callbacks), preventing double-application"),
+					InOutPassCallbacks.Num());
 			}
 			return;
 		}
 		
-		// Throttled debug logging (once per second max)
+		// Per view per frame, so only at Verbose (log LogClassicBloom Verbose)
 		if (bEnableDebug)
 		{
-			static double LastSubscribeLogTime = 0.0;
-			double CurrentTime = FPlatformTime::Seconds();
-			if (CurrentTime - LastSubscribeLogTime > 1.0)
-			{
-				LastSubscribeLogTime = CurrentTime;
-				UE_LOG(LogTemp, Log, TEXT("ClassicBloom: Subscribed to pass %d (WorldType: %d, PassEnabled: %d)"),
-					(int32)PassId, Family->Scene ? (int32)Family->Scene->GetWorld()->WorldType : -1, bIsPassEnabled);
-			}
+			UE_LOG(LogClassicBloom, Verbose, TEXT("Subscribed to pass %d (WorldType: %d, PassEnabled: %d)"),
+				(int32)PassId, Family->Scene && Family->Scene->GetWorld() ? (int32)Family->Scene->GetWorld()->WorldType : -1, bIsPassEnabled);
 		}
 		
 		InOutPassCallbacks.Add(FAfterPassCallbackDelegate::CreateRaw(this, &FClassicBloomSceneViewExtension::PostProcessPass_RenderThread));
@@ -144,29 +301,502 @@ void FClassicBloomSceneViewExtension::SubscribeToPostProcessingPass(EPostProcess
 
 bool FClassicBloomSceneViewExtension::IsActiveThisFrame_Internal(const FSceneViewExtensionContext& Context) const
 {
-	if (!WeakSubsystem.IsValid())
+	if (!FClassicBloomCVarOverrides::IsBloomEnabled())
 	{
 		return false;
 	}
 
-	// Check any active bloom components
-	const TArray<TWeakObjectPtr<UBloomFXComponent>>& Components = WeakSubsystem->GetBloomComponents();
-	bool bHasActiveComponents = false;
-	for (const TWeakObjectPtr<UBloomFXComponent>& Component : Components)
+	// The registry publishes settings only while at least one component is active
+	if (Registry->GetActiveSettings() != nullptr)
+	{
+		return true;
+	}
+
+	// Volumes and per-view components can enable bloom for some views even without a global component
+	UClassicBloomSubsystem* Subsystem = IsInGameThread() ? WeakSubsystem.Get() : nullptr;
+	return Subsystem && Subsystem->NeedsPerViewSettings();
+}
+
+static FScreenTransform ToScreenTransform(const FClassicBloomUVTransform& Transform)
+{
+	FScreenTransform Result;
+	Result.Scale = Transform.Scale;
+	Result.Bias = Transform.Bias;
+	return Result;
+}
+
+static FVector4f GetSizeAndInvSize(FIntPoint Size)
+{
+	return FVector4f(Size.X, Size.Y, 1.0f / Size.X, 1.0f / Size.Y);
+}
+
+// Compute targets need typed UAV stores; the planner falls back to half float where R11G11B10 has none
+static bool IsR11G11B10UAVSupported()
+{
+	return RHIPixelFormatHasCapabilities(PF_FloatR11G11B10, EPixelFormatCapabilities::UAV);
+}
+
+// Kernel image of the FFT convolution as a graph texture; null while the texture has no RHI resource yet, when its
+// reference still points at the RHI's single-texel placeholder
+static FRDGTextureRef RegisterConvolutionKernel(FRDGBuilder& GraphBuilder, FRHITextureReference* Kernel)
+{
+	FRHITexture* Texture = Kernel ? Kernel->GetReferencedTexture() : nullptr;
+	if (!Texture || Texture->GetDesc().Extent.GetMin() <= 1)
+	{
+		return nullptr;
+	}
+	return RegisterExternalTexture(GraphBuilder, Texture, TEXT("ClassicBloom.ConvolutionKernel"));
+}
+
+// Frame slicing state of one view's plan for AddPassPlan
+struct FClassicBloomSliceReplay
+{
+	uint32 SkippedSlices = 0;                   // Bit per plan slice not run this frame
+	TArray<FRDGTextureRef> PersistentTextures;  // Per plan texture: in, the result of a skipped slice; out, the result of a slice that ran
+};
+
+// Replay a pass plan into the graph; returns the bloom texture, or null if a required shader is missing.
+// A cached kernel spectrum replaces the plan's and skips the passes writing it; otherwise the spectrum the plan
+// computes is returned through OutKernelSpectrum. Passes sampling scene color are offset by SceneColorJitter,
+// in texels of the bloom texture (temporal reuse). Slicing skips the passes of slices not run this frame.
+static FRDGTextureRef AddPassPlan(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FClassicBloomPassPlan& Plan, const FScreenPassTexture& SceneColor,
+	FRDGTextureRef ConvolutionKernel, FRDGTextureRef CachedKernelSpectrum = nullptr, FRDGTextureRef* OutKernelSpectrum = nullptr,
+	FVector2f SceneColorJitter = FVector2f::ZeroVector, FClassicBloomSliceReplay* Slicing = nullptr)
+{
+	const uint32 SkippedSlices = Slicing ? Slicing->SkippedSlices : 0;
+	auto IsSkipped = [&Plan, CachedKernelSpectrum, SkippedSlices](const FClassicBloomPlannedPass& Pass)
+	{
+		return (CachedKernelSpectrum && Pass.Output == Plan.KernelSpectrumTexture)
+			|| (Pass.Slice != INDEX_NONE && (SkippedSlices & (1u << Pass.Slice)) != 0);
+	};
+
+	// Textures bound from outside the graph instead of being created
+	auto GetExternalTexture = [&Plan, CachedKernelSpectrum, Slicing](int32 Index) -> FRDGTextureRef
 	{
-		if (Component.IsValid() && Component->IsActive())
+		if (CachedKernelSpectrum && Index == Plan.KernelSpectrumTexture)
 		{
-			bHasActiveComponents = true;
-			break;
+			return CachedKernelSpectrum;
+		}
+		return Slicing ? Slicing->PersistentTextures[Index] : nullptr;
+	};
+
+	// Shift the output pixel by the jitter converted to this pass's output texels
+	auto GetSourceTransform = [&Plan, SceneColorJitter](const FClassicBloomPlannedPass& Pass, FIntPoint OutputExtent)
+	{
+		FClassicBloomUVTransform Transform = Pass.SvPositionToSourceUV;
+		if (Pass.Inputs[0] == FClassicBloomPlannedPass::SceneColorInput)
+		{
+			const FVector2f OutputJitter = SceneColorJitter * FVector2f(OutputExtent) / FVector2f(Plan.Textures[Plan.BloomTexture].Extent);
+			Transform.Bias += OutputJitter * Transform.Scale;
+		}
+		return ToScreenTransform(Transform);
+	};
+
+	const FGlobalShaderMap* GlobalShaderMap = View.ShaderMap;
+	TShaderMapRef<FClassicBloomBrightPassPS> BrightPassShader(GlobalShaderMap);
+	TShaderMapRef<FClassicBloomGlareStreakPS> GlareStreakShader(GlobalShaderMap);
+	TShaderMapRef<FClassicBloomGlareStreakStepPS> GlareStreakStepShader(GlobalShaderMap);
+	TShaderMapRef<FClassicBloomGlareStreakResolvePS> GlareStreakResolveShader(GlobalShaderMap);
+	TShaderMapRef<FClassicBloomKawaseDownsamplePS> KawaseDownsampleShader(GlobalShaderMap);
+	TShaderMapRef<FClassicBloomKawaseUpsamplePS> KawaseUpsampleShader(GlobalShaderMap);
+	TShaderMapRef<FClassicBloomKawaseDownsampleChainCS> KawaseDownsampleChainShader(GlobalShaderMap);
+
+	// Blur shaders are compiled per tap count
+	auto GetBlurShader = [GlobalShaderMap](const FClassicBloomPlannedPass& Pass)
+	{
+		FClassicBloomBlurPS::FPermutationDomain PermutationVector;
+		PermutationVector.Set<FClassicBloomBlurTapsDim>(Pass.BlurKernel.GetNumTaps());
+		return TShaderMapRef<FClassicBloomBlurPS>(GlobalShaderMap, PermutationVector);
+	};
+	auto GetBlurComputeShader = [GlobalShaderMap](const FClassicBloomPlannedPass& Pass)
+	{
+		FClassicBloomBlurCS::FPermutationDomain PermutationVector;
+		PermutationVector.Set<FClassicBloomBlurTapsDim>(Pass.BlurKernel.GetNumTaps());
+		return TShaderMapRef<FClassicBloomBlurCS>(GlobalShaderMap, PermutationVector);
+	};
+
+	// FFT shaders are compiled per transform length: the row length for row passes, the column length for column passes
+	auto GetFFTSize = [&Plan](const FClassicBloomPlannedPass& Pass)
+	{
+		const FIntPoint SpectrumExtent = Plan.Textures[Pass.Type == EClassicBloomPassType::FFTInverseRows ? Pass.Inputs[0] : Pass.Output].Extent;
+		return Pass.Type == EClassicBloomPassType::FFTColumns ? SpectrumExtent.Y : SpectrumExtent.X;
+	};
+	auto GetFFTForwardRowsShader = [GlobalShaderMap, &GetFFTSize](const FClassicBloomPlannedPass& Pass)
+	{
+		FClassicBloomFFTForwardRowsCS::FPermutationDomain PermutationVector;
+		PermutationVector.Set<FClassicBloomFFTSizeDim>(GetFFTSize(Pass));
+		PermutationVector.Set<FClassicBloomFFTForwardRowsCS::FKernelInputDim>(Pass.Inputs[0] == FClassicBloomPlannedPass::ConvolutionKernelInput);
+		return TShaderMapRef<FClassicBloomFFTForwardRowsCS>(GlobalShaderMap, PermutationVector);
+	};
+	auto GetFFTColumnsShader = [GlobalShaderMap, &GetFFTSize](const FClassicBloomPlannedPass& Pass)
+	{
+		FClassicBloomFFTColumnsCS::FPermutationDomain PermutationVector;
+		PermutationVector.Set<FClassicBloomFFTSizeDim>(GetFFTSize(Pass));
+		PermutationVector.Set<FClassicBloomFFTColumnsCS::FConvolveDim>(Pass.NumInputs > 1);
+		return TShaderMapRef<FClassicBloomFFTColumnsCS>(GlobalShaderMap, PermutationVector);
+	};
+	auto GetFFTInverseRowsShader = [GlobalShaderMap, &GetFFTSize](const FClassicBloomPlannedPass& Pass)
+	{
+		FClassicBloomFFTInverseRowsCS::FPermutationDomain PermutationVector;
+		PermutationVector.Set<FClassicBloomFFTSizeDim>(GetFFTSize(Pass));
+		return TShaderMapRef<FClassicBloomFFTInverseRowsCS>(GlobalShaderMap, PermutationVector);
+	};
+
+	// Validate every shader up front so a plan is never replayed halfway
+	for (const FClassicBloomPlannedPass& Pass : Plan.Passes)
+	{
+		if (IsSkipped(Pass))
+		{
+			continue;
+		}
+
+		bool bValid = false;
+		switch (Pass.Type)
+		{
+			case EClassicBloomPassType::BrightPass: bValid = BrightPassShader.IsValid(); break;
+			case EClassicBloomPassType::GlareStreak: bValid = GlareStreakShader.IsValid(); break;
+			case EClassicBloomPassType::GlareStreakStep: bValid = GlareStreakStepShader.IsValid(); break;
+			case EClassicBloomPassType::GlareStreakResolve: bValid = GlareStreakResolveShader.IsValid(); break;
+			case EClassicBloomPassType::Blur: bValid = GetBlurShader(Pass).IsValid(); break;
+			case EClassicBloomPassType::BlurCompute: bValid = GetBlurComputeShader(Pass).IsValid(); break;
+			case EClassicBloomPassType::KawaseDownsample: bValid = KawaseDownsampleShader.IsValid(); break;
+			case EClassicBloomPassType::KawaseDownsampleChain: bValid = KawaseDownsampleChainShader.IsValid(); break;
+			case EClassicBloomPassType::KawaseUpsample: bValid = KawaseUpsampleShader.IsValid(); break;
+			case EClassicBloomPassType::FFTForwardRows: bValid = GetFFTForwardRowsShader(Pass).IsValid(); break;
+			case EClassicBloomPassType::FFTColumns: bValid = GetFFTColumnsShader(Pass).IsValid(); break;
+			case EClassicBloomPassType::FFTInverseRows: bValid = GetFFTInverseRowsShader(Pass).IsValid(); break;
+		}
+		if (!bValid)
+		{
+			return nullptr;
+		}
+	}
+
+	int32 NumPasses = 0;
+	for (const FClassicBloomPlannedPass& Pass : Plan.Passes)
+	{
+		NumPasses += IsSkipped(Pass) ? 0 : 1;
+	}
+	uint64 TransientTextureBytes = Plan.TransientTextureBytes;
+	for (int32 Index = 0; Index < Plan.Textures.Num(); ++Index)
+	{
+		TransientTextureBytes -= GetExternalTexture(Index) ? Plan.Textures[Index].GetMemorySize() : 0;
+	}
+	AccountBloomPasses(NumPasses, TransientTextureBytes);
+
+	TArray<FRDGTextureRef, TInlineAllocator<32>> Textures;
+	for (const FClassicBloomPlannedTexture& PlannedTexture : Plan.Textures)
+	{
+		if (FRDGTextureRef ExternalTexture = GetExternalTexture(Textures.Num()))
+		{
+			Textures.Add(ExternalTexture);
+			continue;
+		}
+
+		const ETextureCreateFlags Flags = TexCreate_ShaderResource | TexCreate_RenderTargetable | (PlannedTexture.bUAV ? TexCreate_UAV : TexCreate_None);
+		const FRDGTextureDesc Desc = PlannedTexture.ArraySize > 1
+			? FRDGTextureDesc::Create2DArray(PlannedTexture.Extent, PlannedTexture.Format, FClearValueBinding::Black, Flags, PlannedTexture.ArraySize, PlannedTexture.NumMips)
+			: FRDGTextureDesc::Create2D(PlannedTexture.Extent, PlannedTexture.Format, FClearValueBinding::Black, Flags, PlannedTexture.NumMips);
+		Textures.Add(GraphBuilder.CreateTexture(Desc, PlannedTexture.Name));
+	}
+
+	auto GetInput = [&Textures, &SceneColor, ConvolutionKernel](const FClassicBloomPlannedPass& Pass, int32 Slot)
+	{
+		const int32 Input = Pass.Inputs[Slot];
+		if (Input == FClassicBloomPlannedPass::ConvolutionKernelInput)
+		{
+			return ConvolutionKernel;
+		}
+		return Input == FClassicBloomPlannedPass::SceneColorInput ? SceneColor.Texture : Textures[Input];
+	};
+
+	// Kawase passes read a single mip of the pyramid they also render into
+	auto GetInputMip = [&GraphBuilder, &GetInput](const FClassicBloomPlannedPass& Pass, int32 Slot)
+	{
+		FRDGTextureRef Input = GetInput(Pass, Slot);
+		return Pass.Inputs[Slot] == FClassicBloomPlannedPass::SceneColorInput
+			? GraphBuilder.CreateSRV(FRDGTextureSRVDesc(Input))
+			: GraphBuilder.CreateSRV(FRDGTextureSRVDesc::CreateForMipLevel(Input, Pass.InputMips[Slot]));
+	};
+
+	FRHISamplerState* BilinearSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+
+	for (const FClassicBloomPlannedPass& Pass : Plan.Passes)
+	{
+		if (IsSkipped(Pass))
+		{
+			continue;
+		}
+
+		const FIntPoint OutputExtent = Plan.Textures[Pass.Output].GetMipExtent(Pass.OutputMip);
+		const FIntRect OutputRect(FIntPoint::ZeroValue, OutputExtent);
+		const FRenderTargetBinding OutputBinding(Textures[Pass.Output], Pass.bAdditive ? ERenderTargetLoadAction::ELoad : ERenderTargetLoadAction::EClear, Pass.OutputMip);
+		FRHIBlendState* BlendState = Pass.bAdditive ? TStaticBlendState<CW_RGB, BO_Add, BF_One, BF_One>::GetRHI() : nullptr;
+		FRDGEventName EventName = Pass.NameIndex != INDEX_NONE ? RDG_EVENT_NAME("%s%d", Pass.Name, Pass.NameIndex) : RDG_EVENT_NAME("%s", Pass.Name);
+
+		switch (Pass.Type)
+		{
+			case EClassicBloomPassType::BrightPass:
+			{
+				CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomBrightPass);
+				FClassicBloomBrightPassPS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomBrightPassPS::FParameters>();
+				PassParameters->View = View.ViewUniformBuffer;
+				PassParameters->SceneColorTexture = GetInput(Pass, 0);
+				PassParameters->SceneColorSampler = BilinearSampler;
+				PassParameters->InputViewportSizeAndInvSize = GetSizeAndInvSize(SceneColor.ViewRect.Size());
+				PassParameters->OutputViewportSizeAndInvSize = GetSizeAndInvSize(OutputExtent);
+				PassParameters->SvPositionToInputTextureUV = GetSourceTransform(Pass, OutputExtent);
+				PassParameters->BloomThreshold = Pass.Threshold;
+				PassParameters->BloomIntensity = 1.0f; // No longer used in shader, but keep for compatibility
+				PassParameters->RenderTargets[0] = OutputBinding;
+				FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, MoveTemp(EventName), BrightPassShader, PassParameters, OutputRect);
+				break;
+			}
+
+			case EClassicBloomPassType::GlareStreak:
+			{
+				CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomGlareStreak);
+				FClassicBloomGlareStreakPS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomGlareStreakPS::FParameters>();
+				PassParameters->View = View.ViewUniformBuffer;
+				PassParameters->SourceTexture = GetInput(Pass, 0);
+				PassParameters->SourceSampler = BilinearSampler;
+				PassParameters->BufferSizeAndInvSize = GetSizeAndInvSize(Pass.SourceExtent);
+				PassParameters->SvPositionToSourceU = Pass.InputTransforms[0].U;
+				PassParameters->SvPositionToSourceV = Pass.InputTransforms[0].V;
+				PassParameters->StreakLength = Pass.Radius;
+				PassParameters->StreakFalloff = Pass.Falloff;
+				for (int32 Axis = 0; Axis < FClassicBloomPlannedPass::MaxStreakAxes; ++Axis)
+				{
+					PassParameters->StreakAxes[Axis] = Pass.StreakAxes[Axis];
+				}
+				PassParameters->NumStreakAxes = Pass.NumStreakAxes;
+				PassParameters->RenderTargets[0] = OutputBinding;
+				FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, MoveTemp(EventName), GlareStreakShader, PassParameters, OutputRect, BlendState);
+				break;
+			}
+
+			case EClassicBloomPassType::GlareStreakStep:
+			{
+				CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomGlareStreak);
+				FClassicBloomGlareStreakStepPS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomGlareStreakStepPS::FParameters>();
+				PassParameters->SourceTexture = GetInput(Pass, 0);
+				PassParameters->SourceSampler = BilinearSampler;
+				PassParameters->BufferSizeAndInvSize = GetSizeAndInvSize(OutputExtent);
+				PassParameters->StreakDirection = Pass.Direction;
+				PassParameters->StreakStride = Pass.Radius;
+				PassParameters->StreakTapStart = Pass.TapStart;
+				PassParameters->StreakTapWeights = Pass.TapWeights;
+				PassParameters->RenderTargets[0] = OutputBinding;
+				FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, MoveTemp(EventName), GlareStreakStepShader, PassParameters, OutputRect, BlendState);
+				break;
+			}
+
+			case EClassicBloomPassType::GlareStreakResolve:
+			{
+				CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomGlareStreak);
+				FClassicBloomGlareStreakResolvePS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomGlareStreakResolvePS::FParameters>();
+				FRDGTextureRef StreakTextures[FClassicBloomGlareStreakResolvePS::MaxStreakBuffers];
+				for (int32 Slot = 0; Slot < FClassicBloomGlareStreakResolvePS::MaxStreakBuffers; ++Slot)
+				{
+					// Unused slots are skipped by the shader but still need a texture bound
+					const bool bUsed = Slot < Pass.NumInputs;
+					StreakTextures[Slot] = GetInput(Pass, bUsed ? Slot : 0);
+					PassParameters->StreakToBufferU[Slot] = FVector4f(Pass.InputTransforms[Slot].U, 0.0f);
+					PassParameters->StreakToBufferV[Slot] = FVector4f(Pass.InputTransforms[Slot].V, 0.0f);
+				}
+				PassParameters->StreakTexture_0 = StreakTextures[0];
+				PassParameters->StreakTexture_1 = StreakTextures[1];
+				PassParameters->StreakTexture_2 = StreakTextures[2];
+				PassParameters->StreakTexture_3 = StreakTextures[3];
+				PassParameters->StreakSampler = BilinearSampler;
+				PassParameters->NumStreakBuffers = Pass.NumInputs;
+				PassParameters->RenderTargets[0] = OutputBinding;
+				FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, MoveTemp(EventName), GlareStreakResolveShader, PassParameters, OutputRect, BlendState);
+				break;
+			}
+
+			case EClassicBloomPassType::Blur:
+			{
+				CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomBlur);
+				FClassicBloomBlurPS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomBlurPS::FParameters>();
+				PassParameters->View = View.ViewUniformBuffer;
+				PassParameters->SourceTexture = GetInput(Pass, 0);
+				PassParameters->SourceSampler = BilinearSampler;
+				PassParameters->BufferSizeAndInvSize = GetSizeAndInvSize(OutputExtent);
+				PassParameters->BlurDirection = Pass.Direction;
+				PassParameters->BlurWeights = Pass.BlurKernel.GetShaderWeights();
+				PassParameters->BlurOffsets = Pass.BlurKernel.GetShaderOffsets();
+				PassParameters->RenderTargets[0] = OutputBinding;
+				FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, MoveTemp(EventName), GetBlurShader(Pass), PassParameters, OutputRect);
+				break;
+			}
+
+			case EClassicBloomPassType::BlurCompute:
+			{
+				CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomBlur);
+				const bool bVertical = Pass.Direction.Y != 0.0f;
+				FClassicBloomBlurCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomBlurCS::FParameters>();
+				PassParameters->SourceTexture = GetInput(Pass, 0);
+				PassParameters->SourceSize = OutputExtent;
+				PassParameters->BlurWeights = Pass.BlurKernel.GetShaderWeights();
+				PassParameters->BlurOffsets = Pass.BlurKernel.GetShaderOffsets();
+				PassParameters->bVertical = bVertical ? 1 : 0;
+				PassParameters->Iterations = Pass.Iterations;
+				PassParameters->Apron = FClassicBloomBlurCS::GetApron(Pass.BlurKernel);
+				PassParameters->RWOutputTexture = GraphBuilder.CreateUAV(Textures[Pass.Output]);
+				FComputeShaderUtils::AddPass(GraphBuilder, MoveTemp(EventName), GetBlurComputeShader(Pass), PassParameters, FClassicBloomBlurCS::GetGroupCount(OutputExtent, bVertical));
+				break;
+			}
+
+			case EClassicBloomPassType::KawaseDownsample:
+			{
+				CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomKawaseDown);
+				FClassicBloomKawaseDownsamplePS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomKawaseDownsamplePS::FParameters>();
+				PassParameters->View = View.ViewUniformBuffer;
+				PassParameters->SourceTexture = GetInputMip(Pass, 0);
+				PassParameters->SourceSampler = BilinearSampler;
+				PassParameters->SourceSizeAndInvSize = GetSizeAndInvSize(Pass.SourceExtent);
+				PassParameters->OutputSizeAndInvSize = GetSizeAndInvSize(OutputExtent);
+				PassParameters->SvPositionToSourceUV = GetSourceTransform(Pass, OutputExtent);
+				PassParameters->BloomThreshold = Pass.Threshold;
+				PassParameters->ThresholdKnee = Pass.ThresholdKnee;
+				PassParameters->MipLevel = Pass.MipLevel;
+				PassParameters->bUseKarisAverage = (Pass.MipLevel == 0) ? 1 : 0; // Only apply Karis on first mip
+				PassParameters->RenderTargets[0] = OutputBinding;
+				FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, MoveTemp(EventName), KawaseDownsampleShader, PassParameters, OutputRect);
+				break;
+			}
+
+			case EClassicBloomPassType::KawaseDownsampleChain:
+			{
+				CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomKawaseDown);
+				FClassicBloomKawaseDownsampleChainCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomKawaseDownsampleChainCS::FParameters>();
+				PassParameters->SourceTexture = GetInput(Pass, 0);
+				PassParameters->SourceSampler = BilinearSampler;
+				PassParameters->SourceSizeAndInvSize = GetSizeAndInvSize(Pass.SourceExtent);
+				PassParameters->SvPositionToSourceUV = GetSourceTransform(Pass, OutputExtent);
+				PassParameters->BloomThreshold = Pass.Threshold;
+				PassParameters->ThresholdKnee = Pass.ThresholdKnee;
+				PassParameters->NumMips = Pass.NumOutputMips;
+
+				// Every mip but the last is read back from scratch; first-level tiles have no counters
+				uint32 NumScratchTexels = 0;
+				uint32 NumTileCounters = 0;
+				for (int32 Mip = 0; Mip < FClassicBloomKawaseDownsampleChainCS::MaxMips; ++Mip)
+				{
+					if (Mip >= Pass.NumOutputMips)
+					{
+						PassParameters->MipSizeAndOffsets[Mip] = FIntVector4(0, 0, 0, 0);
+						PassParameters->RWMipTextures[Mip] = PassParameters->RWMipTextures[0]; // Never written
+						continue;
+					}
+
+					const FIntPoint MipExtent = Plan.Textures[Pass.Output].GetMipExtent(Pass.OutputMip + Mip);
+					const FIntPoint TileCount = FClassicBloomKawaseDownsampleChainCS::GetTileCount(MipExtent);
+					PassParameters->MipSizeAndOffsets[Mip] = FIntVector4(MipExtent.X, MipExtent.Y, NumScratchTexels, NumTileCounters);
+					PassParameters->RWMipTextures[Mip] = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(Textures[Pass.Output], Pass.OutputMip + Mip));
+					if (Mip + 1 < Pass.NumOutputMips)
+					{
+						NumScratchTexels += MipExtent.X * MipExtent.Y;
+					}
+					if (Mip > 0)
+					{
+						NumTileCounters += TileCount.X * TileCount.Y;
+					}
+				}
+
+				FRDGBufferRef ScratchBuffer = GraphBuilder.CreateBuffer(
+					FRDGBufferDesc::CreateStructuredDesc(sizeof(uint32) * 2, FMath::Max(NumScratchTexels, 1u)), TEXT("ClassicBloom.KawaseChainScratch"));
+				FRDGBufferRef TileCounterBuffer = GraphBuilder.CreateBuffer(
+					FRDGBufferDesc::CreateStructuredDesc(sizeof(uint32), FMath::Max(NumTileCounters, 1u)), TEXT("ClassicBloom.KawaseChainCounters"));
+				PassParameters->RWScratch = GraphBuilder.CreateUAV(ScratchBuffer);
+				PassParameters->RWTileCounters = GraphBuilder.CreateUAV(TileCounterBuffer);
+				AddClearUAVPass(GraphBuilder, PassParameters->RWTileCounters, 0);
+
+				const FIntPoint GroupCount = FClassicBloomKawaseDownsampleChainCS::GetTileCount(OutputExtent);
+				FComputeShaderUtils::AddPass(GraphBuilder, MoveTemp(EventName), KawaseDownsampleChainShader, PassParameters, FIntVector(GroupCount.X, GroupCount.Y, 1));
+				break;
+			}
+
+			case EClassicBloomPassType::KawaseUpsample:
+			{
+				CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomKawaseUp);
+				FClassicBloomKawaseUpsamplePS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomKawaseUpsamplePS::FParameters>();
+				PassParameters->View = View.ViewUniformBuffer;
+				PassParameters->SourceTexture = GetInputMip(Pass, 0);
+				PassParameters->SourceSampler = BilinearSampler;
+				PassParameters->OutputSizeAndInvSize = GetSizeAndInvSize(OutputExtent);
+				PassParameters->FilterRadius = Pass.Radius;
+				PassParameters->RenderTargets[0] = OutputBinding;
+				FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, MoveTemp(EventName), KawaseUpsampleShader, PassParameters, OutputRect, BlendState);
+				break;
+			}
+
+			// One thread group per row or column of the spectrum
+			case EClassicBloomPassType::FFTForwardRows:
+			{
+				CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomConvolution);
+				FClassicBloomFFTForwardRowsCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomFFTForwardRowsCS::FParameters>();
+				PassParameters->SourceTexture = GetInput(Pass, 0);
+				PassParameters->SourceSampler = BilinearSampler;
+				PassParameters->SourceSize = Pass.SourceExtent;
+				PassParameters->FFTSize = OutputExtent;
+				PassParameters->KernelSizeInTexels = Pass.Radius;
+				PassParameters->RWSpectrumTexture = GraphBuilder.CreateUAV(Textures[Pass.Output]);
+				FComputeShaderUtils::AddPass(GraphBuilder, MoveTemp(EventName), GetFFTForwardRowsShader(Pass), PassParameters, FIntVector(Pass.SourceExtent.Y, 1, 1));
+				break;
+			}
+
+			case EClassicBloomPassType::FFTColumns:
+			{
+				CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomConvolution);
+				FClassicBloomFFTColumnsCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomFFTColumnsCS::FParameters>();
+				PassParameters->KernelSpectrumTexture = Pass.NumInputs > 1 ? GetInput(Pass, 1) : nullptr;
+				PassParameters->SourceSize = Pass.SourceExtent;
+				PassParameters->FFTSize = OutputExtent;
+				PassParameters->RWSpectrumTexture = GraphBuilder.CreateUAV(Textures[Pass.Output]);
+				FComputeShaderUtils::AddPass(GraphBuilder, MoveTemp(EventName), GetFFTColumnsShader(Pass), PassParameters, FIntVector(OutputExtent.X, 1, 1));
+				break;
+			}
+
+			case EClassicBloomPassType::FFTInverseRows:
+			{
+				CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomConvolution);
+				FClassicBloomFFTInverseRowsCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomFFTInverseRowsCS::FParameters>();
+				PassParameters->SpectrumTexture = GetInput(Pass, 0);
+				PassParameters->SourceSize = OutputExtent;
+				PassParameters->RWOutputTexture = GraphBuilder.CreateUAV(Textures[Pass.Output]);
+				FComputeShaderUtils::AddPass(GraphBuilder, MoveTemp(EventName), GetFFTInverseRowsShader(Pass), PassParameters, FIntVector(OutputExtent.Y, 1, 1));
+				break;
+			}
 		}
 	}
 
-	return bHasActiveComponents;
+	if (OutKernelSpectrum && !CachedKernelSpectrum && Plan.KernelSpectrumTexture != INDEX_NONE)
+	{
+		*OutKernelSpectrum = Textures[Plan.KernelSpectrumTexture];
+	}
+	if (Slicing)
+	{
+		for (int32 Slice = 0; Slice < Plan.Slices.Num(); ++Slice)
+		{
+			if ((SkippedSlices & (1u << Slice)) == 0)
+			{
+				for (int32 Texture : Plan.Slices[Slice].PersistentTextures)
+				{
+					Slicing->PersistentTextures[Texture] = Textures[Texture];
+				}
+			}
+		}
+	}
+	return Textures[Plan.BloomTexture];
 }
 
 FScreenPassTexture FClassicBloomSceneViewExtension::PostProcessPass_RenderThread(FRDGBuilder& GraphBuilder, const FSceneView& View, const FPostProcessMaterialInputs& Inputs)
 {
 	check(IsInRenderingThread());
+	SCOPE_CYCLE_COUNTER(STAT_ClassicBloom_GraphSetup);
+	const uint64 SetupStartCycles = UE_TRACE_CHANNELEXPR_IS_ENABLED(ClassicBloomChannel) ? FPlatformTime::Cycles64() : 0;
 
 	// Get the scene color input first - return this if skip rendering
 	FScreenPassTexture SceneColor = FScreenPassTexture::CopyFromSlice(GraphBuilder, Inputs.GetInput(EPostProcessMaterialInput::SceneColor));
@@ -206,103 +836,37 @@ FScreenPassTexture FClassicBloomSceneViewExtension::PostProcessPass_RenderThread
 		return SceneColor;
 	}
 
-	// Get subsystem and components
-	UClassicBloomSubsystem* Subsystem = WeakSubsystem.Get();
-	if (!Subsystem)
+	// Published and per-view snapshots stay alive until a later render command retires them;
+	// a copy adjusted by the console overrides or the GPU budget lives in RenderSettings
+	FClassicBloomRenderSettings RenderSettings;
+	const FClassicBloomRenderSettings* SettingsPtr = GetRenderSettings_RenderThread(View, RenderSettings);
+
+	// Check if have any active effect to process
+	if (!SettingsPtr || SettingsPtr->BloomIntensity <= 0.0f)
 	{
 		return SceneColor;
 	}
 
-	// Get bloom settings from active components
-	const TArray<TWeakObjectPtr<UBloomFXComponent>>& Components = Subsystem->GetBloomComponents();
-	UBloomFXComponent* ActiveComponent = nullptr;
-	
-	for (const TWeakObjectPtr<UBloomFXComponent>& CompPtr : Components)
+	const FClassicBloomRenderSettings& Settings = *SettingsPtr;
+	const bool bGpuBudget = Settings.UsesGpuBudget() && FClassicBloomGpuTimer::IsSupported();
+
+	// Views that turned temporal reuse or frame slicing off release their history
+	if (!Settings.UsesTemporalReuse() && TemporalHistories.Num() > 0)
 	{
-		if (CompPtr.IsValid() && CompPtr->IsActive())
-		{
-			ActiveComponent = CompPtr.Get();
-			break;
-		}
+		TemporalHistories.Remove(View.GetViewKey());
 	}
-
-	// Check if have any active effect to process
-	if (!ActiveComponent || ActiveComponent->BloomIntensity <= 0.0f)
+	if (!Settings.UsesFrameSlicing() && SlicedHistories.Num() > 0)
 	{
-		return SceneColor;
+		SlicedHistories.Remove(View.GetViewKey());
 	}
 
-	RDG_EVENT_SCOPE(GraphBuilder, "ClassicBloom");
+	// Shared by every view that resolved to equal settings
+	const FClassicBloomDerivedParams& Derived = DerivedParamsCache.FindOrCompute(Settings);
 
 	const FIntPoint SceneColorExtent = SceneColor.Texture->Desc.Extent;
 	const FIntRect ViewRect = SceneColor.ViewRect;  // Use SceneColor.ViewRect consistently
 	const FGlobalShaderMap* GlobalShaderMap = ViewInfoPtr->ShaderMap;
 
-	// Check if debug logging is enabled (throttled to avoid spam)
-	bool bDebugLog = ActiveComponent->bEnableDebugLogging;
-	static double LastLogTime = 0.0;
-	double CurrentTime = FPlatformTime::Seconds();
-	bool bShouldLog = bDebugLog && (CurrentTime - LastLogTime > 1.0); // Log once per second max
-	if (bShouldLog)
-	{
-		LastLogTime = CurrentTime;
-		
-		// Convert enum to pass name
-		const TCHAR* PassName = TEXT("Unknown");
-		switch (ActiveComponent->PostProcessPass)
-		{
-			case EBloomPostProcessPass::Tonemap: PassName = TEXT("Tonemap"); break;
-			case EBloomPostProcessPass::MotionBlur: PassName = TEXT("MotionBlur"); break;
-			case EBloomPostProcessPass::FXAA: PassName = TEXT("FXAA"); break;
-			case EBloomPostProcessPass::VisualizeDepthOfField: PassName = TEXT("VisualizeDOF"); break;
-		}
-		
-		const TCHAR* WorldTypeName = TEXT("Unknown");
-		bool bIsGameWorld = false;
-		bool bIsPIE = false;
-		if (ViewInfo.Family->Scene && ViewInfo.Family->Scene->GetWorld())
-		{
-			UWorld* World = ViewInfo.Family->Scene->GetWorld();
-			bIsGameWorld = World->IsGameWorld();
-			switch (World->WorldType)
-			{
-				case EWorldType::None: WorldTypeName = TEXT("None"); break;
-				case EWorldType::Game: WorldTypeName = TEXT("Game"); break;
-				case EWorldType::Editor: WorldTypeName = TEXT("Editor"); break;
-				case EWorldType::PIE: WorldTypeName = TEXT("PIE"); bIsPIE = true; break;
-				case EWorldType::EditorPreview: WorldTypeName = TEXT("EditorPreview"); break;
-				case EWorldType::GamePreview: WorldTypeName = TEXT("GamePreview"); break;
-				case EWorldType::Inactive: WorldTypeName = TEXT("Inactive"); break;
-			}
-		}
-		
-		UE_LOG(LogTemp, Warning, TEXT("========== CUSTOM BLOOM DEBUG =========="));
-		UE_LOG(LogTemp, Warning, TEXT("WORLD INFO:"));
-		UE_LOG(LogTemp, Warning, TEXT("  WorldType: %s | IsGameWorld: %d | IsPIE: %d"), WorldTypeName, bIsGameWorld, bIsPIE);
-		UE_LOG(LogTemp, Warning, TEXT("  PostProcessPass: %s"), PassName);
-		UE_LOG(LogTemp, Warning, TEXT("VIEW INFO:"));
-		UE_LOG(LogTemp, Warning, TEXT("  ViewRect: [%d,%d] -> [%d,%d] (Size: %dx%d)"), 
-			ViewRect.Min.X, ViewRect.Min.Y,
-			ViewRect.Max.X, ViewRect.Max.Y,
-			ViewRect.Width(), ViewRect.Height());
-		UE_LOG(LogTemp, Warning, TEXT("  Extent: %dx%d"), SceneColorExtent.X, SceneColorExtent.Y);
-		UE_LOG(LogTemp, Warning, TEXT("  bIsGameView: %d | bIsSceneCapture: %d | bIsReflectionCapture: %d"),
-			ViewInfo.bIsGameView, ViewInfo.bIsSceneCapture, ViewInfo.bIsReflectionCapture);
-		UE_LOG(LogTemp, Warning, TEXT("BLOOM SETTINGS:"));
-		UE_LOG(LogTemp, Warning, TEXT("  BloomIntensity: %.3f | BloomThreshold: %.3f | BloomSize: %.3f"),
-			ActiveComponent->BloomIntensity, ActiveComponent->BloomThreshold, ActiveComponent->BloomSize);
-		UE_LOG(LogTemp, Warning, TEXT("  bUseSceneColor: %d | BloomTint: (%.2f, %.2f, %.2f)"),
-			ActiveComponent->bUseSceneColor, 
-			ActiveComponent->BloomTint.R, ActiveComponent->BloomTint.G, ActiveComponent->BloomTint.B);
-		UE_LOG(LogTemp, Warning, TEXT("BLOOM MODE:"));
-		UE_LOG(LogTemp, Warning, TEXT("  BloomMode: %d (0=Standard, 1=DirectionalGlare, 2=Kawase, 3=SoftFocus)"),
-			(int32)ActiveComponent->BloomMode);
-		UE_LOG(LogTemp, Warning, TEXT("QUALITY:"));
-		UE_LOG(LogTemp, Warning, TEXT("  DownsampleScale: %.2f | BlurPasses: %d | BlurSamples: %d"),
-			ActiveComponent->DownsampleScale, ActiveComponent->BlurPasses, ActiveComponent->BlurSamples);
-		UE_LOG(LogTemp, Warning, TEXT("========================================"));
-	}
-
 	// Validate viewport rect
 	if (ViewRect.Width() <= 0 || ViewRect.Height() <= 0)
 	{
@@ -310,561 +874,121 @@ FScreenPassTexture FClassicBloomSceneViewExtension::PostProcessPass_RenderThread
 		return SceneColor;
 	}
 
-	// Step 1: Extract bright pixels (downsample based on quality setting)
-	float DownsampleScale = FMath::Clamp(ActiveComponent->DownsampleScale, 0.25f, 2.0f);
-	int32 Divisor = FMath::Max(1, FMath::RoundToInt(2.0f / DownsampleScale));
-	
-	// Use ViewRect (actual content size) for both extent AND rect
-	// This ensures texture extent == viewport size, avoiding UV mapping issues
-	// when the source texture has padding (extent > viewport)
-	FIntPoint DownsampledExtent = FIntPoint::DivideAndRoundUp(FIntPoint(ViewRect.Width(), ViewRect.Height()), Divisor);
-	
-	// Rect starts at (0,0) and matches extent exactly
-	FIntRect DownsampledRect = FIntRect(FIntPoint::ZeroValue, DownsampledExtent);
+	RDG_EVENT_SCOPE(GraphBuilder, "ClassicBloom");
 
-	// Validate downsampled rect
-	if (DownsampledRect.Width() <= 0 || DownsampledRect.Height() <= 0)
+	// Brackets everything down to the composite, including the batched stages the family's first view runs.
+	// Any return from here on still ends the bracket, around whatever passes were added before it
+	FClassicBloomGpuTimer* GpuTimer = bGpuBudget ? &FindOrAddGpuBudget_RenderThread(View).Timer : nullptr;
+	if (GpuTimer)
 	{
-		// Invalid downsampled viewport, return scene color unchanged
-		return SceneColor;
+		GpuTimer->AddBeginPass(GraphBuilder);
 	}
+	ON_SCOPE_EXIT
+	{
+		if (GpuTimer)
+		{
+			GpuTimer->AddEndPass(GraphBuilder);
+		}
+	};
 
-	FRDGTextureDesc BrightPassDesc = FRDGTextureDesc::Create2D(
-		DownsampledExtent,
-		PF_FloatR11G11B10,
-		FClearValueBinding::Black,
-		TexCreate_ShaderResource | TexCreate_RenderTargetable);
+	// Steps 1-3: Bright pass and mode specific blur
+	// Split-screen / stereo: these may already have run for every view of the family at once
+	const int32 BatchedSlice = GetBatchedBloomSlice_RenderThread(GraphBuilder, ViewInfo, Inputs, Settings);
+	const bool bBatched = (BatchedSlice != INDEX_NONE);
 
-	FRDGTextureRef BrightPassTexture = GraphBuilder.CreateTexture(BrightPassDesc, TEXT("ClassicBloom.BrightPass"));
+	FRDGTextureRef BlurredBloomTexture = nullptr;
+	FIntPoint BloomExtent = FIntPoint::ZeroValue;
+	int32 NumPasses = 1; // Composite
 
-	// Bright pass shader
+	if (bBatched)
 	{
-		TShaderMapRef<FClassicBloomBrightPassPS> PixelShader(GlobalShaderMap);
-		
-		// Validate shader is available
-		if (!PixelShader.IsValid())
+		BloomExtent = BatchedBloom.SliceExtent;
+	}
+	else
+	{
+		// Extents, transforms and pass list only change with the settings or the view size
+		const FClassicBloomPassPlan& Plan = PassPlanCache.FindOrBuild(Settings, Derived, SceneColorExtent, ViewRect, ViewInfo.GetFeatureLevel(), IsR11G11B10UAVSupported());
+		if (!Plan.IsValid())
 		{
-			// Shader not compiled or available, return scene color unchanged
 			return SceneColor;
 		}
-		
-		// Determine effective threshold based on bloom mode
-		// Soft focus needs the entire scene, so use very low threshold
-		// Regular bloom only needs highlights
-		float EffectiveThreshold = ActiveComponent->BloomThreshold;
-		bool bIsSoftFocusMode = (ActiveComponent->BloomMode == EBloomMode::SoftFocus);
-		
-		if (bIsSoftFocusMode)
-		{
-			// Soft focus mode: capture full scene with very low threshold
-			EffectiveThreshold = 0.01f;
-		}
-		
-		// Debug log threshold
-		if (bShouldLog)
+
+		// A cached kernel spectrum skips the kernel passes and does not need the kernel texture; without one
+		// there is no bloom until the kernel texture has a resource
+		FRDGTextureRef ConvolutionKernel = nullptr;
+		FRDGTextureRef CachedKernelSpectrum = nullptr;
+		FRDGTextureRef ComputedKernelSpectrum = nullptr;
+		const FClassicBloomKernelSpectrumKey KernelSpectrumKey = FClassicBloomKernelSpectrumKey::Make(Settings);
+		if (Settings.BloomMode == EBloomMode::Convolution)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("THRESHOLD CALCULATION:"));
-			UE_LOG(LogTemp, Warning, TEXT("  BloomThreshold: %.3f | Effective: %.3f"),
-				ActiveComponent->BloomThreshold, EffectiveThreshold);
+			CachedKernelSpectrum = KernelSpectrumKey.IsValid() ? KernelSpectrumCache->Find(GraphBuilder, KernelSpectrumKey) : nullptr;
+			ConvolutionKernel = CachedKernelSpectrum ? nullptr : RegisterConvolutionKernel(GraphBuilder, Settings.ConvolutionKernelTexture);
+			if (!CachedKernelSpectrum && !ConvolutionKernel)
+			{
+				return SceneColor;
+			}
 		}
-		
-		FClassicBloomBrightPassPS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomBrightPassPS::FParameters>();
-		PassParameters->View = View.ViewUniformBuffer;
-		PassParameters->SceneColorTexture = SceneColor.Texture;
-		PassParameters->SceneColorSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-		PassParameters->InputViewportSizeAndInvSize = FVector4f(ViewRect.Width(), ViewRect.Height(), 1.0f / ViewRect.Width(), 1.0f / ViewRect.Height());
-		PassParameters->OutputViewportSizeAndInvSize = FVector4f(DownsampledRect.Width(), DownsampledRect.Height(), 1.0f / DownsampledRect.Width(), 1.0f / DownsampledRect.Height());
-		
-		// Create FScreenTransform to map SvPosition to scene color texture UV
-		// This properly handles viewport offsets using UE's standard approach:
-		// 1. TexelPosition -> ViewportUV: Maps output SvPosition [ViewRect.Min, ViewRect.Max] to [0,1]
-		// 2. ViewportUV -> TextureUV: Maps [0,1] to actual texture UV coordinates
-		// NOTE: Use actual texture extent for proper UV mapping, not just rect size
-		FScreenPassTextureViewport OutputViewport(DownsampledExtent, DownsampledRect);
-		FScreenPassTextureViewport InputViewport(FIntPoint(SceneColor.Texture->Desc.Extent.X, SceneColor.Texture->Desc.Extent.Y), SceneColor.ViewRect);
-		PassParameters->SvPositionToInputTextureUV = (
-			FScreenTransform::ChangeTextureBasisFromTo(OutputViewport, FScreenTransform::ETextureBasis::TexelPosition, FScreenTransform::ETextureBasis::ViewportUV) *
-			FScreenTransform::ChangeTextureBasisFromTo(InputViewport, FScreenTransform::ETextureBasis::ViewportUV, FScreenTransform::ETextureBasis::TextureUV));
-		
-		PassParameters->BloomThreshold = EffectiveThreshold;
-		PassParameters->BloomIntensity = 1.0f; // No longer used in shader, but keep for compatibility
-		PassParameters->RenderTargets[0] = FRenderTargetBinding(BrightPassTexture, ERenderTargetLoadAction::EClear);
 
-		FPixelShaderUtils::AddFullscreenPass(
-			GraphBuilder,
-			GlobalShaderMap,
-			RDG_EVENT_NAME("BrightPass"),
-			PixelShader,
-			PassParameters,
-			DownsampledRect);
-	}
+		// Temporal reuse: the stages run at a quarter of the texels, jittered, and are reconstructed into the view's history
+		const bool bTemporal = Settings.UsesTemporalReuse() && Plan.TemporalExtent != FIntPoint::ZeroValue;
+		const FVector2f TemporalJitter = bTemporal ? GetTemporalJitter_RenderThread(View) : FVector2f::ZeroVector;
 
-	// Step 2 & 3: Blur passes - Gaussian, Directional Glare, or Kawase bloom
-	FRDGTextureRef BlurredBloomTexture = nullptr;
-	
-	// Check bloom mode from component
-	bool bUseDirectionalGlare = (ActiveComponent->BloomMode == EBloomMode::DirectionalGlare);
-	bool bUseKawaseBloom = (ActiveComponent->BloomMode == EBloomMode::Kawase);
-	bool bUseSoftFocus = (ActiveComponent->BloomMode == EBloomMode::SoftFocus);
-	
-	if (bUseDirectionalGlare)
-	{
-		// Directional glare: Apply directional streaks from bright areas
-		int32 NumStreaks = FMath::Clamp(ActiveComponent->GlareStreakCount, 2, 16);
-		float StreakLength = FMath::Clamp((float)ActiveComponent->GlareStreakLength, 5.0f, 200.0f);
-		float RotationOffset = ActiveComponent->GlareRotationOffset;
-		float Falloff = FMath::Clamp(ActiveComponent->GlareFalloff, 0.5f, 10.0f);
-		
-		// Scale streak length for downsampled resolution
-		float ScaledStreakLength = StreakLength / (float)Divisor;
-		
-		// Create streak textures (we'll process up to 4 at a time, then accumulate)
-		TArray<FRDGTextureRef> StreakTextures;
-		StreakTextures.Reserve(NumStreaks);
-		
-		// Calculate angle step for even distribution
-		float AngleStep = 360.0f / (float)NumStreaks;
-		
-		if (bShouldLog)
+		// Frame slicing: slices not scheduled this frame are bound from an earlier one instead of running
+		FClassicBloomSliceReplay SliceReplay;
+		const bool bSliced = Plan.Slices.Num() > 0 && Plan.SliceSchedule.GetPeriod() > 1;
+		if (bSliced)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("DIRECTIONAL GLARE SETTINGS:"));
-			UE_LOG(LogTemp, Warning, TEXT("  NumStreaks: %d | StreakLength: %.1f (scaled: %.1f)"), NumStreaks, StreakLength, ScaledStreakLength);
-			UE_LOG(LogTemp, Warning, TEXT("  RotationOffset: %.1f | Falloff: %.2f | AngleStep: %.1f"), RotationOffset, Falloff, AngleStep);
+			BeginFrameSlicing_RenderThread(GraphBuilder, ViewInfo, Settings, Plan, SliceReplay);
 		}
-		
-		TShaderMapRef<FClassicBloomGlareStreakPS> GlareStreakShader(GlobalShaderMap);
-		
-		if (!GlareStreakShader.IsValid())
+
+		BlurredBloomTexture = AddPassPlan(GraphBuilder, ViewInfo, Plan, SceneColor, ConvolutionKernel, CachedKernelSpectrum, &ComputedKernelSpectrum, TemporalJitter,
+			bSliced ? &SliceReplay : nullptr);
+		if (!BlurredBloomTexture)
 		{
-			if (bShouldLog)
-			{
-				UE_LOG(LogTemp, Warning, TEXT("ClassicBloom: Glare streak shader not available, falling back to standard"));
-			}
-			// Fall back to standard blur
-			bUseDirectionalGlare = false;
+			UE_LOG(LogClassicBloom, Verbose, TEXT("Bloom shaders not available, skipping view"));
+			return SceneColor;
 		}
-		else
+		if (ComputedKernelSpectrum && KernelSpectrumKey.IsValid())
 		{
-			// Process each streak direction
-			for (int32 i = 0; i < NumStreaks; ++i)
-			{
-				float Angle = (AngleStep * (float)i) + RotationOffset;
-				float RadAngle = FMath::DegreesToRadians(Angle);
-				FVector2f Direction(FMath::Cos(RadAngle), FMath::Sin(RadAngle));
-				
-				FRDGTextureRef StreakTexture = GraphBuilder.CreateTexture(BrightPassDesc, *FString::Printf(TEXT("ClassicBloom.Streak%d"), i));
-				StreakTextures.Add(StreakTexture);
-				
-				FClassicBloomGlareStreakPS::FParameters* StreakParams = GraphBuilder.AllocParameters<FClassicBloomGlareStreakPS::FParameters>();
-				StreakParams->View = View.ViewUniformBuffer;
-				StreakParams->SourceTexture = BrightPassTexture;
-				StreakParams->SourceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-				StreakParams->BufferSizeAndInvSize = FVector4f(DownsampledExtent.X, DownsampledExtent.Y, 1.0f / DownsampledExtent.X, 1.0f / DownsampledExtent.Y);
-				StreakParams->StreakDirection = Direction;
-				StreakParams->StreakLength = ScaledStreakLength;
-				StreakParams->StreakFalloff = Falloff;
-				StreakParams->RenderTargets[0] = FRenderTargetBinding(StreakTexture, ERenderTargetLoadAction::EClear);
-				
-				FPixelShaderUtils::AddFullscreenPass(
-					GraphBuilder,
-					GlobalShaderMap,
-					RDG_EVENT_NAME("GlareStreak%d", i),
-					GlareStreakShader,
-					StreakParams,
-					DownsampledRect);
-			}
-			
-			// Accumulate all streaks into final glare texture
-			// Process in batches of 4 if we have more than 4 streaks
-			TShaderMapRef<FClassicBloomGlareAccumulatePS> GlareAccumShader(GlobalShaderMap);
-			
-			if (GlareAccumShader.IsValid())
-			{
-				FRDGTextureRef AccumTexture = GraphBuilder.CreateTexture(BrightPassDesc, TEXT("ClassicBloom.GlareAccum"));
-				
-				// For simplicity, accumulate first 4 streaks, then blend more in subsequent passes if needed
-				int32 StreaksToProcess = FMath::Min(NumStreaks, 4);
-				
-				FClassicBloomGlareAccumulatePS::FParameters* AccumParams = GraphBuilder.AllocParameters<FClassicBloomGlareAccumulatePS::FParameters>();
-				AccumParams->View = View.ViewUniformBuffer;
-				AccumParams->StreakTexture0 = StreakTextures[0];
-				AccumParams->StreakTexture1 = StreaksToProcess >= 2 ? StreakTextures[1] : StreakTextures[0];
-				AccumParams->StreakTexture2 = StreaksToProcess >= 3 ? StreakTextures[2] : StreakTextures[0];
-				AccumParams->StreakTexture3 = StreaksToProcess >= 4 ? StreakTextures[3] : StreakTextures[0];
-				AccumParams->StreakSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-				AccumParams->GlareViewportSizeAndInvSize = FVector4f(DownsampledRect.Width(), DownsampledRect.Height(), 1.0f / DownsampledRect.Width(), 1.0f / DownsampledRect.Height());
-				AccumParams->NumStreaks = StreaksToProcess;
-				AccumParams->RenderTargets[0] = FRenderTargetBinding(AccumTexture, ERenderTargetLoadAction::EClear);
-				
-				FPixelShaderUtils::AddFullscreenPass(
-					GraphBuilder,
-					GlobalShaderMap,
-					RDG_EVENT_NAME("GlareAccumulate"),
-					GlareAccumShader,
-					AccumParams,
-					DownsampledRect);
-				
-				// If we have more than 4 streaks, continue accumulating
-				if (NumStreaks > 4)
-				{
-					FRDGTextureRef PrevAccum = AccumTexture;
-					
-					for (int32 BatchStart = 4; BatchStart < NumStreaks; BatchStart += 3)
-					{
-						// Blend previous accumulation with next batch of streaks
-						FRDGTextureRef NextAccum = GraphBuilder.CreateTexture(BrightPassDesc, *FString::Printf(TEXT("ClassicBloom.GlareAccum%d"), BatchStart));
-						
-						int32 StreaksInBatch = FMath::Min(3, NumStreaks - BatchStart);
-						
-						AccumParams = GraphBuilder.AllocParameters<FClassicBloomGlareAccumulatePS::FParameters>();
-						AccumParams->View = View.ViewUniformBuffer;
-						AccumParams->StreakTexture0 = PrevAccum; // Previous accumulation
-						AccumParams->StreakTexture1 = StreakTextures[BatchStart];
-						AccumParams->StreakTexture2 = StreaksInBatch >= 2 ? StreakTextures[BatchStart + 1] : StreakTextures[BatchStart];
-						AccumParams->StreakTexture3 = StreaksInBatch >= 3 ? StreakTextures[BatchStart + 2] : StreakTextures[BatchStart];
-						AccumParams->StreakSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-						AccumParams->GlareViewportSizeAndInvSize = FVector4f(DownsampledRect.Width(), DownsampledRect.Height(), 1.0f / DownsampledRect.Width(), 1.0f / DownsampledRect.Height());
-						AccumParams->NumStreaks = 1 + StreaksInBatch; // 1 for prev accum + new streaks
-						AccumParams->RenderTargets[0] = FRenderTargetBinding(NextAccum, ERenderTargetLoadAction::EClear);
-						
-						FPixelShaderUtils::AddFullscreenPass(
-							GraphBuilder,
-							GlobalShaderMap,
-							RDG_EVENT_NAME("GlareAccumulate%d", BatchStart),
-							GlareAccumShader,
-							AccumParams,
-							DownsampledRect);
-						
-						PrevAccum = NextAccum;
-					}
-					
-					AccumTexture = PrevAccum;
-				}
-				
-				// Apply a light Gaussian blur to smooth the glare
-				FRDGTextureRef GlareBlurTemp = GraphBuilder.CreateTexture(BrightPassDesc, TEXT("ClassicBloom.GlareBlurTemp"));
-				BlurredBloomTexture = GraphBuilder.CreateTexture(BrightPassDesc, TEXT("ClassicBloom.GlareBlurred"));
-				
-				// Horizontal blur
-				{
-					FClassicBloomBlurPS::FParameters* BlurParams = GraphBuilder.AllocParameters<FClassicBloomBlurPS::FParameters>();
-					BlurParams->View = View.ViewUniformBuffer;
-					BlurParams->SourceTexture = AccumTexture;
-					BlurParams->SourceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-					BlurParams->BufferSizeAndInvSize = FVector4f(DownsampledExtent.X, DownsampledExtent.Y, 1.0f / DownsampledExtent.X, 1.0f / DownsampledExtent.Y);
-					BlurParams->BlurDirection = FVector2f(1.0f, 0.0f);
-					BlurParams->BlurRadius = ActiveComponent->BloomSize * 0.05f; // Lighter blur for glare
-					BlurParams->RenderTargets[0] = FRenderTargetBinding(GlareBlurTemp, ERenderTargetLoadAction::EClear);
-					
-					TShaderMapRef<FClassicBloomBlurPS> BlurShader(GlobalShaderMap);
-					FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, RDG_EVENT_NAME("GlareBlurH"), BlurShader, BlurParams, DownsampledRect);
-				}
-				
-				// Vertical blur
-				{
-					FClassicBloomBlurPS::FParameters* BlurParams = GraphBuilder.AllocParameters<FClassicBloomBlurPS::FParameters>();
-					BlurParams->View = View.ViewUniformBuffer;
-					BlurParams->SourceTexture = GlareBlurTemp;
-					BlurParams->SourceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-					BlurParams->BufferSizeAndInvSize = FVector4f(DownsampledExtent.X, DownsampledExtent.Y, 1.0f / DownsampledExtent.X, 1.0f / DownsampledExtent.Y);
-					BlurParams->BlurDirection = FVector2f(0.0f, 1.0f);
-					BlurParams->BlurRadius = ActiveComponent->BloomSize * 0.05f;
-					BlurParams->RenderTargets[0] = FRenderTargetBinding(BlurredBloomTexture, ERenderTargetLoadAction::EClear);
-					
-					TShaderMapRef<FClassicBloomBlurPS> BlurShader(GlobalShaderMap);
-					FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, RDG_EVENT_NAME("GlareBlurV"), BlurShader, BlurParams, DownsampledRect);
-				}
-			}
-			else
-			{
-				// Accumulate shader not available, fall back to standard
-				bUseDirectionalGlare = false;
-			}
+			KernelSpectrumCache->Add(GraphBuilder, KernelSpectrumKey, ComputedKernelSpectrum);
 		}
-	}
-	
-	// ========================================================================
-	// Kawase Bloom Mode
-	// ========================================================================
-	if (bUseKawaseBloom && !BlurredBloomTexture)
-	{
-		TShaderMapRef<FClassicBloomKawaseDownsamplePS> KawaseDownsampleShader(GlobalShaderMap);
-		TShaderMapRef<FClassicBloomKawaseUpsamplePS> KawaseUpsampleShader(GlobalShaderMap);
-		
-		if (!KawaseDownsampleShader.IsValid() || !KawaseUpsampleShader.IsValid())
+
+		if (bSliced)
 		{
-			if (bShouldLog)
-			{
-				UE_LOG(LogTemp, Warning, TEXT("ClassicBloom: Kawase shaders not available, falling back to standard"));
-			}
-			bUseKawaseBloom = false;
+			EndFrameSlicing_RenderThread(GraphBuilder, ViewInfo, Plan, SliceReplay);
 		}
-		else
+
+		BloomExtent = Plan.Textures[Plan.BloomTexture].Extent;
+		NumPasses += Plan.Passes.Num() - (CachedKernelSpectrum ? Plan.NumKernelSpectrumPasses : 0);
+		for (int32 Slice = 0; Slice < Plan.Slices.Num(); ++Slice)
 		{
-			// Configure Kawase bloom parameters
-			int32 MipCount = FMath::Clamp(ActiveComponent->KawaseMipCount, 3, 8);
-			float FilterRadius = FMath::Clamp(ActiveComponent->KawaseFilterRadius, 0.0001f, 0.01f);
-			bool bSoftThreshold = ActiveComponent->bKawaseSoftThreshold;
-			float ThresholdKnee = bSoftThreshold ? FMath::Clamp(ActiveComponent->KawaseThresholdKnee, 0.0f, 1.0f) : 0.0f;
-			
-			if (bShouldLog)
-			{
-				UE_LOG(LogTemp, Warning, TEXT("KAWASE BLOOM SETTINGS:"));
-				UE_LOG(LogTemp, Warning, TEXT("  MipCount: %d | FilterRadius: %.5f"), MipCount, FilterRadius);
-				UE_LOG(LogTemp, Warning, TEXT("  SoftThreshold: %d | ThresholdKnee: %.2f"), bSoftThreshold, ThresholdKnee);
-				UE_LOG(LogTemp, Warning, TEXT("  BloomThreshold: %.2f | BloomIntensity: %.2f"), ActiveComponent->BloomThreshold, ActiveComponent->BloomIntensity);
-			}
-			
-			// Create mip chain textures
-			TArray<FRDGTextureRef> MipTextures;
-			TArray<FIntPoint> MipExtents;
-			TArray<FIntRect> MipRects;
-			
-			MipTextures.Reserve(MipCount);
-			MipExtents.Reserve(MipCount);
-			MipRects.Reserve(MipCount);
-			
-			// Calculate mip sizes (each mip is half the resolution of the previous)
-			FIntPoint CurrentExtent = DownsampledExtent;
-			FIntRect CurrentRect = DownsampledRect;
-			
-			for (int32 Mip = 0; Mip < MipCount; ++Mip)
-			{
-				// Halve the resolution for each mip
-				CurrentExtent = FIntPoint::DivideAndRoundUp(CurrentExtent, 2);
-				CurrentRect = FIntRect(FIntPoint::ZeroValue, FIntPoint::DivideAndRoundUp(FIntPoint(CurrentRect.Width(), CurrentRect.Height()), 2));
-				
-				// Ensure minimum size
-				CurrentExtent.X = FMath::Max(CurrentExtent.X, 1);
-				CurrentExtent.Y = FMath::Max(CurrentExtent.Y, 1);
-				CurrentRect.Max.X = FMath::Max(CurrentRect.Max.X, 1);
-				CurrentRect.Max.Y = FMath::Max(CurrentRect.Max.Y, 1);
-				
-				FRDGTextureDesc MipDesc = FRDGTextureDesc::Create2D(
-					CurrentExtent,
-					PF_FloatR11G11B10,
-					FClearValueBinding::Black,
-					TexCreate_ShaderResource | TexCreate_RenderTargetable);
-				
-				FRDGTextureRef MipTexture = GraphBuilder.CreateTexture(MipDesc, *FString::Printf(TEXT("ClassicBloom.KawaseMip%d"), Mip));
-				MipTextures.Add(MipTexture);
-				MipExtents.Add(CurrentExtent);
-				MipRects.Add(CurrentRect);
-			}
-			
-			// ================================================================
-			// DOWNSAMPLE PASS: Create the mip pyramid
-			// Kawase bloom works directly on scene color (not BrightPass)
-			// Threshold is applied only in the first Kawase downsample pass
-			// This is the authentic physically-based bloom approach
-			// ================================================================
-			FRDGTextureRef DownsampleSource = SceneColor.Texture; // Use scene color directly
-			FIntPoint SourceExtent = SceneColorExtent;
-			FIntRect SourceRect = SceneColor.ViewRect; // Track source viewport for FScreenTransform
-			
-			for (int32 Mip = 0; Mip < MipCount; ++Mip)
-			{
-				FClassicBloomKawaseDownsamplePS::FParameters* DownParams = GraphBuilder.AllocParameters<FClassicBloomKawaseDownsamplePS::FParameters>();
-				DownParams->View = View.ViewUniformBuffer;
-				DownParams->SourceTexture = DownsampleSource;
-				DownParams->SourceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-				DownParams->SourceSizeAndInvSize = FVector4f(SourceExtent.X, SourceExtent.Y, 1.0f / SourceExtent.X, 1.0f / SourceExtent.Y);
-				// Output size is the destination mip size (where we're rendering to)
-				DownParams->OutputSizeAndInvSize = FVector4f(MipExtents[Mip].X, MipExtents[Mip].Y, 1.0f / MipExtents[Mip].X, 1.0f / MipExtents[Mip].Y);
-				
-				// Create FScreenTransform to map output SvPosition to source texture UV
-				// This properly handles viewport offsets (especially important for Mip 0 which samples from SceneColor)
-				FScreenPassTextureViewport OutputViewport(MipExtents[Mip], MipRects[Mip]);
-				FScreenPassTextureViewport SourceViewport(SourceExtent, SourceRect);
-				DownParams->SvPositionToSourceUV = (
-					FScreenTransform::ChangeTextureBasisFromTo(OutputViewport, FScreenTransform::ETextureBasis::TexelPosition, FScreenTransform::ETextureBasis::ViewportUV) *
-					FScreenTransform::ChangeTextureBasisFromTo(SourceViewport, FScreenTransform::ETextureBasis::ViewportUV, FScreenTransform::ETextureBasis::TextureUV));
-				
-				DownParams->BloomThreshold = ActiveComponent->BloomThreshold;
-				DownParams->ThresholdKnee = ThresholdKnee;
-				DownParams->MipLevel = Mip;
-				DownParams->bUseKarisAverage = (Mip == 0) ? 1 : 0; // Only apply Karis on first mip
-				DownParams->RenderTargets[0] = FRenderTargetBinding(MipTextures[Mip], ERenderTargetLoadAction::EClear);
-				
-				FPixelShaderUtils::AddFullscreenPass(
-					GraphBuilder,
-					GlobalShaderMap,
-					RDG_EVENT_NAME("KawaseDownsample_Mip%d", Mip),
-					KawaseDownsampleShader,
-					DownParams,
-					MipRects[Mip]);
-				
-				// Use this mip as source for next (our mips have extent==viewport now)
-				DownsampleSource = MipTextures[Mip];
-				SourceExtent = MipExtents[Mip];
-				SourceRect = MipRects[Mip];
-			}
-			
-			// ================================================================
-			// UPSAMPLE PASS: Progressive upsample with additive blend
-			// ================================================================
-			// Start from the smallest mip and work up
-			// E' = E (smallest mip stays as-is, it's just copied)
-			// D' = D + blur(E')
-			// C' = C + blur(D')
-			// etc.
-			
-			// Create upsample target textures (one for each mip level except the last)
-			TArray<FRDGTextureRef> UpsampleTextures;
-			UpsampleTextures.Reserve(MipCount - 1);
-			
-			for (int32 Mip = MipCount - 2; Mip >= 0; --Mip)
-			{
-				FRDGTextureDesc UpsampleDesc = FRDGTextureDesc::Create2D(
-					MipExtents[Mip],
-					PF_FloatR11G11B10,
-					FClearValueBinding::Black,
-					TexCreate_ShaderResource | TexCreate_RenderTargetable);
-				
-				FRDGTextureRef UpsampleTexture = GraphBuilder.CreateTexture(UpsampleDesc, *FString::Printf(TEXT("ClassicBloom.KawaseUpsample%d"), Mip));
-				UpsampleTextures.Add(UpsampleTexture);
-			}
-			
-			// The first upsample source is the smallest mip (no processing needed)
-			FRDGTextureRef UpsampleSource = MipTextures[MipCount - 1];
-			FIntPoint UpsampleSourceExtent = MipExtents[MipCount - 1];
-			
-			int32 UpsampleIdx = 0;
-			for (int32 Mip = MipCount - 2; Mip >= 0; --Mip)
-			{
-				FClassicBloomKawaseUpsamplePS::FParameters* UpParams = GraphBuilder.AllocParameters<FClassicBloomKawaseUpsamplePS::FParameters>();
-				UpParams->View = View.ViewUniformBuffer;
-				UpParams->SourceTexture = UpsampleSource;
-				UpParams->PreviousMipTexture = MipTextures[Mip]; // The larger mip blending into
-				UpParams->SourceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-				// Output size is the destination mip size (where rendering to)
-				UpParams->OutputSizeAndInvSize = FVector4f(MipExtents[Mip].X, MipExtents[Mip].Y, 1.0f / MipExtents[Mip].X, 1.0f / MipExtents[Mip].Y);
-				UpParams->FilterRadius = FilterRadius;
-				UpParams->RenderTargets[0] = FRenderTargetBinding(UpsampleTextures[UpsampleIdx], ERenderTargetLoadAction::EClear);
-				
-				FPixelShaderUtils::AddFullscreenPass(
-					GraphBuilder,
-					GlobalShaderMap,
-					RDG_EVENT_NAME("KawaseUpsample_Mip%d", Mip),
-					KawaseUpsampleShader,
-					UpParams,
-					MipRects[Mip]);
-				
-				// Use this as source for next upsample iteration
-				UpsampleSource = UpsampleTextures[UpsampleIdx];
-				UpsampleSourceExtent = MipExtents[Mip];
-				++UpsampleIdx;
-			}
-			
-			// The final upsample texture is our bloom result
-			// We need to upsample it back to the original bloom texture size
-			if (UpsampleTextures.Num() > 0)
-			{
-				// Create final output texture at original downsampled size
-				BlurredBloomTexture = GraphBuilder.CreateTexture(BrightPassDesc, TEXT("ClassicBloom.KawaseBlurred"));
-				
-				// Final upsample pass to original resolution
-				// Blend with MipTextures[0] (first downsampled mip from scene color with threshold applied)
-				FClassicBloomKawaseUpsamplePS::FParameters* FinalUpParams = GraphBuilder.AllocParameters<FClassicBloomKawaseUpsamplePS::FParameters>();
-				FinalUpParams->View = View.ViewUniformBuffer;
-				FinalUpParams->SourceTexture = UpsampleTextures.Last();
-				FinalUpParams->PreviousMipTexture = MipTextures[0]; // Blend with first Kawase mip (has threshold applied)
-				FinalUpParams->SourceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-				// Output size is the final bloom texture size
-				FinalUpParams->OutputSizeAndInvSize = FVector4f(DownsampledExtent.X, DownsampledExtent.Y, 1.0f / DownsampledExtent.X, 1.0f / DownsampledExtent.Y);
-				FinalUpParams->FilterRadius = FilterRadius;
-				FinalUpParams->RenderTargets[0] = FRenderTargetBinding(BlurredBloomTexture, ERenderTargetLoadAction::EClear);
-				
-				FPixelShaderUtils::AddFullscreenPass(
-					GraphBuilder,
-					GlobalShaderMap,
-					RDG_EVENT_NAME("KawaseUpsample_Final"),
-					KawaseUpsampleShader,
-					FinalUpParams,
-					DownsampledRect);
-			}
-			else
-			{
-				// Fallback if something went wrong - use first mip as bloom
-				BlurredBloomTexture = MipTextures.Num() > 0 ? MipTextures[0] : BrightPassTexture;
-			}
-			
-			if (bShouldLog)
-			{
-				UE_LOG(LogTemp, Warning, TEXT("KAWASE BLOOM COMPLETED:"));
-				UE_LOG(LogTemp, Warning, TEXT("  Generated %d mips, %d upsample passes"), MipCount, UpsampleTextures.Num());
-			}
+			NumPasses -= (SliceReplay.SkippedSlices & (1u << Slice)) ? Plan.Slices[Slice].NumPasses : 0;
 		}
-	}
-	
-	// Standard Gaussian blur mode (or fallback from directional glare/Kawase if they failed)
-	if (!BlurredBloomTexture)
-	{
-		int32 NumBlurPasses = FMath::Clamp(ActiveComponent->BlurPasses, 1, 4);
-		FRDGTextureRef BlurSource = BrightPassTexture;
-		FRDGTextureRef BlurTempTexture = GraphBuilder.CreateTexture(BrightPassDesc, TEXT("ClassicBloom.BlurTemp"));
-		BlurredBloomTexture = GraphBuilder.CreateTexture(BrightPassDesc, TEXT("ClassicBloom.Blurred"));
 
-		for (int32 PassIndex = 0; PassIndex < NumBlurPasses; ++PassIndex)
+		if (bTemporal)
 		{
-			// Horizontal pass
-			{
-				FClassicBloomBlurPS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomBlurPS::FParameters>();
-				PassParameters->View = View.ViewUniformBuffer;
-				PassParameters->SourceTexture = BlurSource;
-				PassParameters->SourceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-				PassParameters->BufferSizeAndInvSize = FVector4f(DownsampledExtent.X, DownsampledExtent.Y, 1.0f / DownsampledExtent.X, 1.0f / DownsampledExtent.Y);
-				PassParameters->BlurDirection = FVector2f(1.0f, 0.0f); // Horizontal
-				PassParameters->BlurRadius = ActiveComponent->BloomSize * 0.1f;
-				PassParameters->RenderTargets[0] = FRenderTargetBinding(BlurTempTexture, ERenderTargetLoadAction::EClear);
-
-				TShaderMapRef<FClassicBloomBlurPS> PixelShader(GlobalShaderMap);
-
-				FPixelShaderUtils::AddFullscreenPass(
-					GraphBuilder,
-					GlobalShaderMap,
-					RDG_EVENT_NAME("BlurHorizontal"),
-					PixelShader,
-					PassParameters,
-					DownsampledRect);
-			}
-
-			// Vertical pass
+			BlurredBloomTexture = AddTemporalResolvePass_RenderThread(GraphBuilder, ViewInfo, Inputs, Settings, Plan, BlurredBloomTexture, TemporalJitter);
+			if (!BlurredBloomTexture)
 			{
-				FClassicBloomBlurPS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomBlurPS::FParameters>();
-				PassParameters->View = View.ViewUniformBuffer;
-				PassParameters->SourceTexture = BlurTempTexture;
-				PassParameters->SourceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-				PassParameters->BufferSizeAndInvSize = FVector4f(DownsampledExtent.X, DownsampledExtent.Y, 1.0f / DownsampledExtent.X, 1.0f / DownsampledExtent.Y);
-				PassParameters->BlurDirection = FVector2f(0.0f, 1.0f); // Vertical
-				PassParameters->BlurRadius = ActiveComponent->BloomSize * 0.1f;
-				PassParameters->RenderTargets[0] = FRenderTargetBinding(BlurredBloomTexture, ERenderTargetLoadAction::EClear);
-
-				TShaderMapRef<FClassicBloomBlurPS> PixelShader(GlobalShaderMap);
-
-				FPixelShaderUtils::AddFullscreenPass(
-					GraphBuilder,
-					GlobalShaderMap,
-					RDG_EVENT_NAME("BlurVertical"),
-					PixelShader,
-					PassParameters,
-					DownsampledRect);
+				UE_LOG(LogClassicBloom, Verbose, TEXT("Temporal resolve shader not available, skipping view"));
+				return SceneColor;
 			}
-
-			// Use output as source for next pass iteration
-			BlurSource = BlurredBloomTexture;
+			BloomExtent = Plan.TemporalExtent;
+			NumPasses += 1;
 		}
 	}
 
 	// Step 4: Composite bloom back onto scene color
 	// Use override output if provided, otherwise create new
 	FScreenPassRenderTarget Output = Inputs.OverrideOutput;
+	uint64 OutputTextureBytes = 0;
 	if (!Output.IsValid())
 	{
 		FRDGTextureDesc OutputDesc = SceneColor.Texture->Desc;
 		OutputDesc.ClearValue = FClearValueBinding::Black;
 		OutputDesc.Flags |= TexCreate_RenderTargetable | TexCreate_ShaderResource;
 		FRDGTextureRef OutputTexture = GraphBuilder.CreateTexture(OutputDesc, TEXT("ClassicBloom.Output"));
+		OutputTextureBytes = (uint64)OutputDesc.Extent.X * OutputDesc.Extent.Y * GPixelFormats[OutputDesc.Format].BlockBytes;
 		// Important: Use exact same rect as scene color to prevent misalignment
 		Output = FScreenPassRenderTarget(OutputTexture, SceneColor.ViewRect, ERenderTargetLoadAction::ENoAction);
 	}
@@ -873,11 +997,15 @@ FScreenPassTexture FClassicBloomSceneViewExtension::PostProcessPass_RenderThread
 	// This provides more consistent results than trying to detect game mode in C++
 	
 	{
+		CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomComposite);
+
 		FClassicBloomCompositePS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomCompositePS::FParameters>();
 		PassParameters->View = View.ViewUniformBuffer;
 		PassParameters->SceneColorTexture = SceneColor.Texture;
 		PassParameters->SceneColorSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
 		PassParameters->BloomTexture = BlurredBloomTexture;
+		PassParameters->BloomTextureArray = bBatched ? BatchedBloom.Texture : nullptr;
+		PassParameters->BloomArraySlice = bBatched ? (float)BatchedSlice : 0.0f;
 		PassParameters->BloomSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
 		// Use exact viewport rect dimensions
 		PassParameters->OutputViewportSizeAndInvSize = FVector4f(Output.ViewRect.Width(), Output.ViewRect.Height(), 1.0f / Output.ViewRect.Width(), 1.0f / Output.ViewRect.Height());
@@ -888,8 +1016,8 @@ FScreenPassTexture FClassicBloomSceneViewExtension::PostProcessPass_RenderThread
 		// Scene color viewport: source scene color texture
 		FScreenPassTextureViewport SceneColorViewport(FIntPoint(SceneColor.Texture->Desc.Extent.X, SceneColor.Texture->Desc.Extent.Y), SceneColor.ViewRect);
 		// Bloom viewport: generated bloom texture
-		// The bloom was rendered to DownsampledRect within DownsampledExtent texture
-		FScreenPassTextureViewport BloomViewport(DownsampledExtent, DownsampledRect);
+		// The bloom always covers its whole texture (or texture array slice)
+		FScreenPassTextureViewport BloomViewport(BloomExtent);
 		
 		// Transform: SvPosition -> ViewportUV [0,1] -> SceneColor TextureUV
 		PassParameters->SvPositionToSceneColorUV = (
@@ -903,77 +1031,50 @@ FScreenPassTexture FClassicBloomSceneViewExtension::PostProcessPass_RenderThread
 		
 		// For Soft Focus mode, pass 0 for bloom intensity (uses SoftFocusIntensity instead)
 		// For other modes, pass the bloom intensity normally
-		PassParameters->BloomIntensity = bUseSoftFocus ? 0.0f : ActiveComponent->BloomIntensity;
-	
-	// Debug log final intensity values
-	if (bShouldLog)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("FINAL SHADER PARAMETERS:"));
-		UE_LOG(LogTemp, Warning, TEXT("  BloomMode: %d (SoftFocus: %d) | BloomIntensity: %.3f"), (int32)ActiveComponent->BloomMode, bUseSoftFocus, PassParameters->BloomIntensity);
-		UE_LOG(LogTemp, Warning, TEXT("  SoftFocusIntensity: %.3f"),
-			bUseSoftFocus ? ActiveComponent->BloomIntensity : 0.0f);
-		UE_LOG(LogTemp, Warning, TEXT("  bUseAdaptiveScaling: %d"), ActiveComponent->bUseAdaptiveBrightnessScaling);
-		UE_LOG(LogTemp, Warning, TEXT("VIEWPORT MAPPING:"));
-		UE_LOG(LogTemp, Warning, TEXT("  Output: Extent[%d,%d] ViewRect[%d,%d]-[%d,%d]"), 
-			Output.Texture->Desc.Extent.X, Output.Texture->Desc.Extent.Y,
-			Output.ViewRect.Min.X, Output.ViewRect.Min.Y, Output.ViewRect.Max.X, Output.ViewRect.Max.Y);
-		UE_LOG(LogTemp, Warning, TEXT("  SceneColor: Extent[%d,%d] ViewRect[%d,%d]-[%d,%d]"),
-			SceneColor.Texture->Desc.Extent.X, SceneColor.Texture->Desc.Extent.Y,
-			SceneColor.ViewRect.Min.X, SceneColor.ViewRect.Min.Y, SceneColor.ViewRect.Max.X, SceneColor.ViewRect.Max.Y);
-		UE_LOG(LogTemp, Warning, TEXT("  Bloom: Extent[%d,%d] Rect[%d,%d]-[%d,%d]"),
-			DownsampledExtent.X, DownsampledExtent.Y,
-			DownsampledRect.Min.X, DownsampledRect.Min.Y, DownsampledRect.Max.X, DownsampledRect.Max.Y);
-		UE_LOG(LogTemp, Warning, TEXT("  SvPosToSceneColorUV: Scale[%.4f,%.4f] Bias[%.4f,%.4f]"),
-			PassParameters->SvPositionToSceneColorUV.Scale.X, PassParameters->SvPositionToSceneColorUV.Scale.Y,
-			PassParameters->SvPositionToSceneColorUV.Bias.X, PassParameters->SvPositionToSceneColorUV.Bias.Y);
-		UE_LOG(LogTemp, Warning, TEXT("  SvPosToBloomUV: Scale[%.4f,%.4f] Bias[%.4f,%.4f]"),
-			PassParameters->SvPositionToBloomUV.Scale.X, PassParameters->SvPositionToBloomUV.Scale.Y,
-			PassParameters->SvPositionToBloomUV.Bias.X, PassParameters->SvPositionToBloomUV.Bias.Y);
-	}
+		PassParameters->BloomIntensity = Derived.CompositeBloomIntensity;
 	
 	// Encode bUseSceneColor in the alpha channel of BloomTint (0.0 = use tint, 1.0 = use scene color)
-	FLinearColor TintWithFlag = ActiveComponent->BloomTint;
-	TintWithFlag.A = ActiveComponent->bUseSceneColor ? 1.0f : 0.0f;
-	PassParameters->BloomTint = FVector4f(TintWithFlag);
-		// Pass blend mode as float (0-5)
-		PassParameters->BloomBlendMode = (float)ActiveComponent->BloomBlendMode;
+	PassParameters->BloomTint = Derived.BloomTint;
 		// Pass saturation boost
-		PassParameters->BloomSaturation = ActiveComponent->BloomSaturation;
-		// Pass highlight protection settings
-		PassParameters->bProtectHighlights = ActiveComponent->bProtectHighlights ? 1.0f : 0.0f;
-		PassParameters->HighlightProtection = ActiveComponent->HighlightProtection;
+		PassParameters->BloomSaturation = Settings.BloomSaturation;
+		// Pass highlight protection strength (the on/off switch is a permutation)
+		PassParameters->HighlightProtection = Settings.HighlightProtection;
 		// For Soft Focus mode, use BloomIntensity as the soft focus intensity
-		PassParameters->SoftFocusIntensity = bUseSoftFocus ? ActiveComponent->BloomIntensity : 0.0f;
+		PassParameters->SoftFocusIntensity = Derived.SoftFocusIntensity;
 		// Pack soft focus tuning parameters into a vector4
-		PassParameters->SoftFocusParams = FVector4f(
-			ActiveComponent->SoftFocusOverlayMultiplier,
-			ActiveComponent->SoftFocusBlendStrength,
-			ActiveComponent->SoftFocusSoftLightMultiplier,
-			ActiveComponent->SoftFocusFinalBlend
-		);
-		// Pass adaptive scaling flag
-		PassParameters->bUseAdaptiveScaling = ActiveComponent->bUseAdaptiveBrightnessScaling ? 1.0f : 0.0f;
-		// Pass debug flags
-		PassParameters->bShowBloomOnly = ActiveComponent->bShowBloomOnly ? 1.0f : 0.0f;
-		PassParameters->bShowGammaCompensation = ActiveComponent->bShowGammaCompensation ? 1.0f : 0.0f;
-		// Pass world type and manual game mode scale
+		PassParameters->SoftFocusParams = Settings.SoftFocusParams;
+		// Without adaptive scaling the scale only depends on the world type: manual compensation in game/PIE, 1 in the editor
 		bool bIsGameWorld = ViewInfo.Family->Scene && ViewInfo.Family->Scene->GetWorld() && ViewInfo.Family->Scene->GetWorld()->IsGameWorld();
-		PassParameters->bIsGameWorld = bIsGameWorld ? 1.0f : 0.0f;
-		PassParameters->GameModeBloomScale = ActiveComponent->GameModeBloomScale;
+		PassParameters->BloomScale = bIsGameWorld ? Settings.GameModeBloomScale : 1.0f;
 		PassParameters->RenderTargets[0] = Output.GetRenderTargetBinding();
 
-		TShaderMapRef<FClassicBloomCompositePS> PixelShader(GlobalShaderMap);
+		// Debug views only exist where debug view modes are compiled (never in Shipping)
+		int32 DebugView = 0;
+#if !UE_BUILD_SHIPPING
+		if (AllowDebugViewmodes())
+		{
+			DebugView = Settings.bShowBloomOnly ? 1 : (Settings.bShowGammaCompensation ? 2 : 0);
+		}
+#endif
+
+		FClassicBloomCompositePS::FPermutationDomain PermutationVector;
+		PermutationVector.Set<FClassicBloomCompositePS::FBloomTextureArrayDim>(bBatched);
+		PermutationVector.Set<FClassicBloomCompositePS::FBlendModeDim>(FMath::Clamp((int32)Settings.BloomBlendMode, 0, 5));
+		PermutationVector.Set<FClassicBloomCompositePS::FSoftFocusDim>(Derived.SoftFocusIntensity > 0.0f);
+		PermutationVector.Set<FClassicBloomCompositePS::FProtectHighlightsDim>(Settings.bProtectHighlights);
+		PermutationVector.Set<FClassicBloomCompositePS::FAdaptiveScalingDim>(Settings.bUseAdaptiveBrightnessScaling);
+		PermutationVector.Set<FClassicBloomCompositePS::FDebugViewDim>(DebugView);
+		PermutationVector = FClassicBloomCompositePS::RemapPermutation(PermutationVector);
+		TShaderMapRef<FClassicBloomCompositePS> PixelShader(GlobalShaderMap, PermutationVector);
 
 		// Validate shader is available
 		if (!PixelShader.IsValid())
 		{
-			if (bShouldLog)
-			{
-				UE_LOG(LogTemp, Warning, TEXT("ClassicBloom: Composite shader not available"));
-			}
+			UE_LOG(LogClassicBloom, Verbose, TEXT("Composite shader not available, skipping view"));
 			return SceneColor;
 		}
 
+		AccountBloomPasses(1, OutputTextureBytes);
 		FPixelShaderUtils::AddFullscreenPass(
 			GraphBuilder,
 			GlobalShaderMap,
@@ -983,18 +1084,583 @@ FScreenPassTexture FClassicBloomSceneViewExtension::PostProcessPass_RenderThread
 			Output.ViewRect);  // Use Output.ViewRect instead of SceneColorRect to ensure perfect alignment
 	}
 
-	// Log success if debug logging is enabled (already throttled above)
-	if (bShouldLog)
-	{
-		UE_LOG(LogTemp, Log, TEXT("ClassicBloom: Successfully rendered bloom (Downsampled: %dx%d, Output ViewRect: [%d,%d]-[%d,%d])"), 
-			DownsampledRect.Width(), DownsampledRect.Height(),
-			Output.ViewRect.Min.X, Output.ViewRect.Min.Y, Output.ViewRect.Max.X, Output.ViewRect.Max.Y);
-	}
-	
+	UE_TRACE_LOG(ClassicBloom, ViewFrame, ClassicBloomChannel)
+		<< ViewFrame.Cycle(FPlatformTime::Cycles64())
+		<< ViewFrame.SetupCycles(FPlatformTime::Cycles64() - SetupStartCycles)
+		<< ViewFrame.FrameNumber(GFrameCounterRenderThread)
+		<< ViewFrame.ViewKey(View.GetViewKey())
+		<< ViewFrame.SettingsHash(GetTypeHash(Settings))
+		<< ViewFrame.ViewWidth((uint16)ViewRect.Width())
+		<< ViewFrame.ViewHeight((uint16)ViewRect.Height())
+		<< ViewFrame.BloomWidth((uint16)BloomExtent.X)
+		<< ViewFrame.BloomHeight((uint16)BloomExtent.Y)
+		<< ViewFrame.PassCount((uint16)NumPasses)
+		<< ViewFrame.Mode((uint8)Settings.BloomMode)
+		<< ViewFrame.BatchedSlice((int8)BatchedSlice);
+
 	// Return the output (either override or our created texture)
 	return MoveTemp(Output);
 }
 
+// ============================================================================
+// Temporal Reuse
+// ============================================================================
+
+// Views not rendered for this many frames drop their history
+static constexpr uint32 ClassicBloomTemporalHistoryMaxAge = 8;
+
+// History is discarded rather than rescaled when the pre-exposure changes by more than this factor in one frame
+static constexpr float ClassicBloomTemporalMaxExposureRatio = 2.0f;
+
+// Halton (2, 3) covers a bloom texel evenly in this many frames
+static constexpr uint32 ClassicBloomTemporalJitterSamples = 8;
+
+FVector2f FClassicBloomSceneViewExtension::GetTemporalJitter_RenderThread(const FSceneView& View)
+{
+	const uint32 FrameNumber = GFrameCounterRenderThread;
+	for (auto It = TemporalHistories.CreateIterator(); It; ++It)
+	{
+		if (FrameNumber - It.Value()->LastUsedFrame > ClassicBloomTemporalHistoryMaxAge)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TUniquePtr<FTemporalHistory>& History = TemporalHistories.FindOrAdd(View.GetViewKey());
+	if (!History)
+	{
+		History = MakeUnique<FTemporalHistory>();
+	}
+	if (History->LastUsedFrame != FrameNumber)
+	{
+		History->JitterIndex = (History->JitterIndex + 1) % ClassicBloomTemporalJitterSamples;
+		History->LastUsedFrame = FrameNumber;
+	}
+
+	// Halton index 0 is the texel center for both bases; start at 1
+	const int32 Index = (int32)History->JitterIndex + 1;
+	return FVector2f(Halton(Index, 2) - 0.5f, Halton(Index, 3) - 0.5f);
+}
+
+FRDGTextureRef FClassicBloomSceneViewExtension::AddTemporalResolvePass_RenderThread(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FPostProcessMaterialInputs& Inputs,
+	const FClassicBloomRenderSettings& Settings, const FClassicBloomPassPlan& Plan, FRDGTextureRef CurrentBloom, FVector2f Jitter)
+{
+	TShaderMapRef<FClassicBloomTemporalResolvePS> PixelShader(View.ShaderMap);
+	TUniquePtr<FTemporalHistory>* HistoryPtr = TemporalHistories.Find(View.GetViewKey());
+	if (!PixelShader.IsValid() || !HistoryPtr)
+	{
+		return nullptr;
+	}
+	FTemporalHistory& History = **HistoryPtr;
+
+	CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomTemporal);
+
+	// Camera cuts, resizes, mode switches and exposure jumps start over from the current frame
+	const float ExposureScale = History.PreExposure > 0.0f ? View.PreExposure / History.PreExposure : 0.0f;
+	const bool bHistoryValid = History.Texture.IsValid()
+		&& History.Extent == Plan.TemporalExtent
+		&& History.Mode == Settings.BloomMode
+		&& !View.bCameraCut
+		&& !View.bPrevTransformsReset
+		&& ExposureScale <= ClassicBloomTemporalMaxExposureRatio
+		&& ExposureScale >= 1.0f / ClassicBloomTemporalMaxExposureRatio;
+
+	// Alpha holds the scene depth for disocclusion tests, which needs more than R11G11B10
+	const FRDGTextureDesc Desc = FRDGTextureDesc::Create2D(Plan.TemporalExtent, PF_FloatRGBA, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_RenderTargetable);
+	FRDGTextureRef Output = GraphBuilder.CreateTexture(Desc, TEXT("ClassicBloom.TemporalHistory"));
+
+	FRHISamplerState* BilinearSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+	FClassicBloomTemporalResolvePS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomTemporalResolvePS::FParameters>();
+	PassParameters->View = View.ViewUniformBuffer;
+	PassParameters->SceneTextures = Inputs.SceneTextures;
+	PassParameters->CurrentTexture = CurrentBloom;
+	PassParameters->CurrentSampler = BilinearSampler;
+	PassParameters->CurrentSizeAndInvSize = GetSizeAndInvSize(Plan.Textures[Plan.BloomTexture].Extent);
+	PassParameters->CurrentJitter = Jitter;
+	PassParameters->HistoryTexture = bHistoryValid ? GraphBuilder.RegisterExternalTexture(History.Texture) : GSystemTextures.GetBlackDummy(GraphBuilder);
+	PassParameters->HistorySampler = BilinearSampler;
+	PassParameters->HistoryWeight = bHistoryValid ? Settings.TemporalHistoryWeight : 0.0f;
+	PassParameters->HistoryExposureScale = bHistoryValid ? ExposureScale : 1.0f;
+	PassParameters->OutputSizeAndInvSize = GetSizeAndInvSize(Plan.TemporalExtent);
+	PassParameters->RenderTargets[0] = FRenderTargetBinding(Output, ERenderTargetLoadAction::ENoAction);
+
+	// The history outlives the graph, so it is not counted as transient memory
+	AccountBloomPasses(1, 0);
+	FPixelShaderUtils::AddFullscreenPass(GraphBuilder, View.ShaderMap, RDG_EVENT_NAME("TemporalResolve"), PixelShader, PassParameters, FIntRect(FIntPoint::ZeroValue, Plan.TemporalExtent));
+
+	History.Extent = Plan.TemporalExtent;
+	History.Mode = Settings.BloomMode;
+	History.PreExposure = View.PreExposure;
+	GraphBuilder.QueueTextureExtraction(Output, &History.Texture);
+	return Output;
+}
+
+// ============================================================================
+// GPU Budget
+// ============================================================================
+
+// Views not rendered for this many frames drop their budget state
+static constexpr uint32 ClassicBloomGpuBudgetMaxAge = 8;
+
+FClassicBloomSceneViewExtension::FGpuBudget& FClassicBloomSceneViewExtension::FindOrAddGpuBudget_RenderThread(const FSceneView& View)
+{
+	const uint32 FrameNumber = GFrameCounterRenderThread;
+	for (auto It = GpuBudgets.CreateIterator(); It; ++It)
+	{
+		if (FrameNumber - It.Value()->LastUsedFrame > ClassicBloomGpuBudgetMaxAge)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TUniquePtr<FGpuBudget>& Budget = GpuBudgets.FindOrAdd(View.GetViewKey());
+	if (!Budget)
+	{
+		Budget = MakeUnique<FGpuBudget>();
+	}
+	Budget->LastUsedFrame = FrameNumber;
+	return *Budget;
+}
+
+const FClassicBloomRenderSettings& FClassicBloomSceneViewExtension::ApplyGpuBudget_RenderThread(const FSceneView& View, const FClassicBloomRenderSettings& Settings, FClassicBloomRenderSettings& OutBudgetSettings)
+{
+	// Rebuilt per call: it is a handful of integers
+	const FClassicBloomQualityLadder Ladder(Settings.GetQualityLevel(), Settings.GetQualityAxes());
+	FGpuBudget& Budget = FindOrAddGpuBudget_RenderThread(View);
+	FClassicBloomBudgetController& Controller = Budget.Controller;
+
+	// The view's first lookup of a frame feeds every frame whose timestamps landed since, oldest first
+	// (batching looks up the settings of the family's other views too)
+	const uint32 FrameNumber = GFrameCounterRenderThread;
+	if (Budget.FedFrameNumber != FrameNumber)
+	{
+		Budget.FedFrameNumber = FrameNumber;
+		Controller.SetTargetMs(Settings.GpuBudgetMs);
+		Controller.SetNumLevels(Ladder.Num());
+
+		const int32 PreviousLevel = Controller.GetLevel();
+		float GpuMs = 0.0f;
+		while (Budget.Timer.ReadBack(GpuMs))
+		{
+			Controller.AddSample(GpuMs);
+			SET_FLOAT_STAT(STAT_ClassicBloom_BudgetGpuTime, GpuMs);
+			CSV_CUSTOM_STAT(ClassicBloom, BudgetGpuMs, GpuMs, ECsvCustomStatOp::Set);
+		}
+
+		// Level changes are rare by design (hysteresis), so this is cheap to leave on
+		if (Settings.bEnableDebugLogging && Controller.GetLevel() != PreviousLevel)
+		{
+			UE_LOG(LogClassicBloom, Log, TEXT("GPU budget %.2f ms of view %u: quality level %d -> %d of %d (%.2f ms)"),
+				Settings.GpuBudgetMs, View.GetViewKey(), PreviousLevel, Controller.GetLevel(), Ladder.Num() - 1, GpuMs);
+		}
+		SET_DWORD_STAT(STAT_ClassicBloom_BudgetLevel, Controller.GetLevel());
+		CSV_CUSTOM_STAT(ClassicBloom, BudgetLevel, Controller.GetLevel(), ECsvCustomStatOp::Set);
+	}
+
+	if (Controller.GetLevel() == 0)
+	{
+		return Settings;
+	}
+	OutBudgetSettings = Settings;
+	OutBudgetSettings.ApplyQualityLevel(Ladder.GetLevel(Controller.GetLevel()));
+	return OutBudgetSettings;
+}
+
+// ============================================================================
+// Frame Slicing
+// ============================================================================
+
+// Views not rendered for this many frames drop their slice results
+static constexpr uint32 ClassicBloomSlicedHistoryMaxAge = 8;
+
+void FClassicBloomSceneViewExtension::BeginFrameSlicing_RenderThread(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FClassicBloomRenderSettings& Settings,
+	const FClassicBloomPassPlan& Plan, FClassicBloomSliceReplay& OutReplay)
+{
+	const uint32 FrameNumber = GFrameCounterRenderThread;
+	for (auto It = SlicedHistories.CreateIterator(); It; ++It)
+	{
+		if (FrameNumber - It.Value()->LastUsedFrame > ClassicBloomSlicedHistoryMaxAge)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TUniquePtr<FSlicedHistory>& History = SlicedHistories.FindOrAdd(View.GetViewKey());
+	if (!History)
+	{
+		History = MakeUnique<FSlicedHistory>();
+	}
+
+	// Results of other settings or another view size do not fit the plan; after a camera cut they are stale
+	const uint32 PlanHash = HashCombineFast(GetTypeHash(Settings), GetTypeHash(Plan.DownsampledExtent));
+	if (History->PlanHash != PlanHash || History->Textures.Num() != Plan.Textures.Num() || View.bCameraCut)
+	{
+		History->PlanHash = PlanHash;
+		History->Textures.Reset();
+		History->Textures.SetNum(Plan.Textures.Num());
+		History->ValidSlices = 0;
+	}
+	if (History->LastUsedFrame != FrameNumber)
+	{
+		++History->FrameIndex;
+		History->LastUsedFrame = FrameNumber;
+	}
+
+	// Slices without a result yet run whatever the schedule says
+	const uint32 AllSlices = Plan.Slices.Num() >= 32 ? ~0u : (1u << Plan.Slices.Num()) - 1;
+	const uint32 RunSlices = (Plan.SliceSchedule.GetSliceMask(History->FrameIndex) | ~History->ValidSlices) & AllSlices;
+	OutReplay.SkippedSlices = AllSlices & ~RunSlices;
+	OutReplay.PersistentTextures.SetNumZeroed(Plan.Textures.Num());
+	for (int32 Slice = 0; Slice < Plan.Slices.Num(); ++Slice)
+	{
+		if (OutReplay.SkippedSlices & (1u << Slice))
+		{
+			for (int32 Texture : Plan.Slices[Slice].PersistentTextures)
+			{
+				OutReplay.PersistentTextures[Texture] = GraphBuilder.RegisterExternalTexture(History->Textures[Texture]);
+			}
+		}
+	}
+}
+
+void FClassicBloomSceneViewExtension::EndFrameSlicing_RenderThread(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FClassicBloomPassPlan& Plan, const FClassicBloomSliceReplay& Replay)
+{
+	FSlicedHistory& History = *SlicedHistories.FindChecked(View.GetViewKey());
+	for (int32 Slice = 0; Slice < Plan.Slices.Num(); ++Slice)
+	{
+		if ((Replay.SkippedSlices & (1u << Slice)) == 0)
+		{
+			for (int32 Texture : Plan.Slices[Slice].PersistentTextures)
+			{
+				GraphBuilder.QueueTextureExtraction(Replay.PersistentTextures[Texture], &History.Textures[Texture]);
+			}
+			History.ValidSlices |= 1u << Slice;
+		}
+	}
+}
+
+// ============================================================================
+// Batched Multi-View Bloom
+// ============================================================================
+
+int32 FClassicBloomSceneViewExtension::GetBatchedBloomSlice_RenderThread(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FPostProcessMaterialInputs& Inputs, const FClassicBloomRenderSettings& Settings)
+{
+	const FSceneViewFamily* Family = View.Family;
+	if (!Settings.bBatchMultiView || Settings.BloomMode == EBloomMode::DirectionalGlare || Settings.BloomMode == EBloomMode::Convolution || Settings.UsesTemporalReuse() || Settings.UsesFrameSlicing() || !Family || Family->Views.Num() < 2)
+	{
+		return INDEX_NONE;
+	}
+
+	// Reuse the batch built by an earlier view of this family in the same graph
+	const uint32 FrameNumber = GFrameCounterRenderThread;
+	if (BatchedBloom.Family == Family && BatchedBloom.GraphBuilder == &GraphBuilder && BatchedBloom.FrameNumber == FrameNumber)
+	{
+		return BatchedBloom.Texture ? BatchedBloom.Views.IndexOfByKey(&View) : INDEX_NONE;
+	}
+
+	BatchedBloom = FBatchedBloom();
+	BatchedBloom.Family = Family;
+	BatchedBloom.GraphBuilder = &GraphBuilder;
+	BatchedBloom.FrameNumber = FrameNumber;
+
+	// The shared stages read the family HDR scene color, which holds every view
+	if (!Inputs.SceneTextures.SceneTextures)
+	{
+		return INDEX_NONE;
+	}
+	FRDGTextureRef FamilySceneColor = Inputs.SceneTextures.SceneTextures->GetParameters()->SceneColorTexture;
+	if (!FamilySceneColor)
+	{
+		return INDEX_NONE;
+	}
+
+	// Only where the hook hands every view the family scene color itself. Past the first pass writing a new
+	// texture (tonemapping, temporal upscaling, motion blur) each view has an input of its own that the others'
+	// callbacks cannot read yet, and blooming the HDR scene color instead would not match the per-view path
+	const FScreenPassTextureSlice ViewSceneColor = Inputs.GetInput(EPostProcessMaterialInput::SceneColor);
+	if (!ViewSceneColor.TextureSRV || ViewSceneColor.TextureSRV->Desc.Texture != FamilySceneColor)
+	{
+		return INDEX_NONE;
+	}
+
+	// Slices and Kawase levels take their sizes from the view's own pass plan, so a batched view blooms at
+	// exactly the resolutions it would alone
+	const FClassicBloomDerivedParams& Derived = DerivedParamsCache.FindOrCompute(Settings);
+	const FClassicBloomPassPlan& Plan = PassPlanCache.FindOrBuild(Settings, Derived, FamilySceneColor->Desc.Extent, View.ViewRect, View.GetFeatureLevel(), IsR11G11B10UAVSupported());
+	if (!Plan.IsValid())
+	{
+		return INDEX_NONE;
+	}
+	const int32 Divisor = Settings.GetDownsampleDivisor();
+	const FIntPoint SliceExtent = Plan.DownsampledExtent;
+
+	// Gather views that would run the same bright pass, blur and pyramid at the same resolution
+	for (const FSceneView* FamilyView : Family->Views)
+	{
+		if (BatchedBloom.Views.Num() == FClassicBloomBatchedCS::MaxViews)
+		{
+			break;
+		}
+
+		if (!FamilyView || !FamilyView->bIsViewInfo || FamilyView->bIsSceneCapture || FamilyView->bIsReflectionCapture)
+		{
+			continue;
+		}
+
+		// Compared after overrides and budget, like the settings of the view building the batch
+		FClassicBloomRenderSettings ViewSettingsStorage;
+		const FClassicBloomRenderSettings* ViewSettings = GetRenderSettings_RenderThread(*FamilyView, ViewSettingsStorage);
+		if (!ViewSettings || ViewSettings->BloomIntensity <= 0.0f || !ViewSettings->IsBatchCompatible(Settings))
+		{
+			continue;
+		}
+
+		// Same rule as FClassicBloomPassPlan::DownsampledExtent; with compatible settings the rest of the plan follows
+		const FViewInfo* FamilyViewInfo = static_cast<const FViewInfo*>(FamilyView);
+		if (FIntPoint::DivideAndRoundUp(FamilyViewInfo->ViewRect.Size(), Divisor) == SliceExtent)
+		{
+			BatchedBloom.Views.Add(FamilyView);
+		}
+	}
+
+	if (BatchedBloom.Views.Num() < 2 || !BatchedBloom.Views.Contains(&View) || SliceExtent.X <= 0 || SliceExtent.Y <= 0)
+	{
+		BatchedBloom.Views.Reset();
+		return INDEX_NONE;
+	}
+
+	BatchedBloom.SliceExtent = SliceExtent;
+	if (!AddBatchedBloomPasses_RenderThread(GraphBuilder, View, FamilySceneColor, Settings, Derived, Plan))
+	{
+		BatchedBloom.Views.Reset();
+		return INDEX_NONE;
+	}
+
+	return BatchedBloom.Views.IndexOfByKey(&View);
+}
+
+bool FClassicBloomSceneViewExtension::AddBatchedBloomPasses_RenderThread(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef FamilySceneColor, const FClassicBloomRenderSettings& Settings, const FClassicBloomDerivedParams& Derived, const FClassicBloomPassPlan& Plan)
+{
+	const FGlobalShaderMap* GlobalShaderMap = View.ShaderMap;
+	const int32 NumSlices = BatchedBloom.Views.Num();
+	const FIntPoint SliceExtent = BatchedBloom.SliceExtent;
+	const FIntPoint SceneColorExtent = FamilySceneColor->Desc.Extent;
+	FRHISamplerState* BilinearSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+
+	const bool bKawase = (Settings.BloomMode == EBloomMode::Kawase);
+
+	TShaderMapRef<FClassicBloomBatchedBrightPassCS> BrightPassShader(GlobalShaderMap);
+	FClassicBloomBatchedBlurCS::FPermutationDomain BlurPermutation;
+	BlurPermutation.Set<FClassicBloomBlurTapsDim>(Derived.BlurKernel.GetNumTaps());
+	TShaderMapRef<FClassicBloomBatchedBlurCS> BlurShader(GlobalShaderMap, BlurPermutation);
+	TShaderMapRef<FClassicBloomBatchedKawaseUpsampleCS> KawaseUpsampleShader(GlobalShaderMap);
+	FClassicBloomBatchedKawaseDownsampleCS::FPermutationDomain FirstMipPermutation;
+	FirstMipPermutation.Set<FClassicBloomBatchedKawaseDownsampleCS::FSourceIsSceneColorDim>(true);
+	TShaderMapRef<FClassicBloomBatchedKawaseDownsampleCS> KawaseFirstMipShader(GlobalShaderMap, FirstMipPermutation);
+	TShaderMapRef<FClassicBloomBatchedKawaseDownsampleCS> KawaseDownsampleShader(GlobalShaderMap);
+
+	if (bKawase
+		? (!KawaseFirstMipShader.IsValid() || !KawaseDownsampleShader.IsValid() || !KawaseUpsampleShader.IsValid())
+		: (!BrightPassShader.IsValid() || !BlurShader.IsValid()))
+	{
+		return false;
+	}
+
+	uint64 TransientTextureBytes = 0;
+	auto CreateArray = [&GraphBuilder, &TransientTextureBytes, NumSlices](FIntPoint Extent, const TCHAR* Name)
+	{
+		TransientTextureBytes += (uint64)Extent.X * Extent.Y * NumSlices * GPixelFormats[PF_FloatRGBA].BlockBytes;
+		return GraphBuilder.CreateTexture(
+			FRDGTextureDesc::Create2DArray(Extent, PF_FloatRGBA, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV, NumSlices),
+			Name);
+	};
+
+	auto GetGroupCount = [NumSlices](FIntPoint Extent)
+	{
+		return FComputeShaderUtils::GetGroupCount(FIntVector(Extent.X, Extent.Y, NumSlices), FIntVector(FClassicBloomBatchedCS::ThreadGroupSize, FClassicBloomBatchedCS::ThreadGroupSize, 1));
+	};
+
+	auto SizeAndInvSize = [](FIntPoint Extent)
+	{
+		return FVector4f(Extent.X, Extent.Y, 1.0f / Extent.X, 1.0f / Extent.Y);
+	};
+
+	// Per slice: output pixel center -> UV of that view's rect in the family scene color
+	auto SetSceneColorUVScaleBias = [&](FVector4f* OutScaleBias, FIntPoint OutputExtent)
+	{
+		for (int32 Slice = 0; Slice < NumSlices; ++Slice)
+		{
+			const FIntRect& Rect = static_cast<const FViewInfo*>(BatchedBloom.Views[Slice])->ViewRect;
+			OutScaleBias[Slice] = FVector4f(
+				(float)Rect.Width() / ((float)OutputExtent.X * SceneColorExtent.X),
+				(float)Rect.Height() / ((float)OutputExtent.Y * SceneColorExtent.Y),
+				(float)Rect.Min.X / SceneColorExtent.X,
+				(float)Rect.Min.Y / SceneColorExtent.Y);
+		}
+	};
+
+	RDG_EVENT_SCOPE(GraphBuilder, "ClassicBloom.Batched %d views", NumSlices);
+
+	if (bKawase)
+	{
+		// Same layout as the plan's pyramid, with one array slice per view: mip 0 is the bloom target, mips
+		// 1..MipCount the Kawase levels. Batched views are never frame sliced, so the pyramid holds every level
+		const FClassicBloomPlannedTexture& PlannedPyramid = Plan.Textures[Plan.BloomTexture];
+		const int32 MipCount = PlannedPyramid.NumMips - 1;
+		if (MipCount <= 0)
+		{
+			return false;
+		}
+
+		// The upsamples add onto their output mip in place, which loads from the UAV; without typed UAV loads
+		// for either format the views render one by one instead
+		auto SupportsInPlaceAdd = [](EPixelFormat Format)
+		{
+			return RHIPixelFormatHasCapabilities(Format, EPixelFormatCapabilities::UAV | EPixelFormatCapabilities::TypedUAVLoad);
+		};
+		const EPixelFormat PyramidFormat = SupportsInPlaceAdd(PF_FloatR11G11B10) ? PF_FloatR11G11B10 : PF_FloatRGBA;
+		if (!SupportsInPlaceAdd(PyramidFormat))
+		{
+			return false;
+		}
+
+		for (int32 Mip = 0; Mip <= MipCount; ++Mip)
+		{
+			const FIntPoint MipExtent = PlannedPyramid.GetMipExtent(Mip);
+			TransientTextureBytes += (uint64)MipExtent.X * MipExtent.Y * NumSlices * GPixelFormats[PyramidFormat].BlockBytes;
+		}
+		FRDGTextureRef Pyramid = GraphBuilder.CreateTexture(
+			FRDGTextureDesc::Create2DArray(SliceExtent, PyramidFormat, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV, NumSlices, MipCount + 1),
+			TEXT("ClassicBloom.Batched.KawasePyramid"));
+
+		// Downsample: mip Mip + 1 from mip Mip, the first level from the family scene color with the threshold
+		for (int32 Mip = 0; Mip < MipCount; ++Mip)
+		{
+			CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomKawaseDown);
+			const bool bFirstMip = (Mip == 0);
+			const FIntPoint MipExtent = PlannedPyramid.GetMipExtent(Mip + 1);
+
+			FClassicBloomBatchedKawaseDownsampleCS::FParameters* DownParams = GraphBuilder.AllocParameters<FClassicBloomBatchedKawaseDownsampleCS::FParameters>();
+			DownParams->SourceSampler = BilinearSampler;
+			DownParams->OutputSizeAndInvSize = SizeAndInvSize(MipExtent);
+			DownParams->NumSlices = NumSlices;
+			DownParams->BloomThreshold = Settings.BloomThreshold;
+			DownParams->ThresholdKnee = Settings.KawaseThresholdKnee;
+			DownParams->bFirstMip = bFirstMip ? 1 : 0;
+			DownParams->RWOutputTexture = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(Pyramid, Mip + 1));
+
+			if (bFirstMip)
+			{
+				DownParams->SceneColorTexture = FamilySceneColor;
+				DownParams->SourceSizeAndInvSize = SizeAndInvSize(SceneColorExtent);
+				SetSceneColorUVScaleBias(&DownParams->SourceUVScaleBias[0], MipExtent);
+			}
+			else
+			{
+				DownParams->SourceTexture = GraphBuilder.CreateSRV(FRDGTextureSRVDesc::CreateForMipLevel(Pyramid, Mip));
+				DownParams->SourceSizeAndInvSize = SizeAndInvSize(PlannedPyramid.GetMipExtent(Mip));
+				for (int32 Slice = 0; Slice < NumSlices; ++Slice)
+				{
+					DownParams->SourceUVScaleBias[Slice] = FVector4f(1.0f / MipExtent.X, 1.0f / MipExtent.Y, 0.0f, 0.0f);
+				}
+			}
+
+			FComputeShaderUtils::AddPass(
+				GraphBuilder,
+				RDG_EVENT_NAME("KawaseDownsample_Mip%d", Mip),
+				bFirstMip ? KawaseFirstMipShader : KawaseDownsampleShader,
+				DownParams,
+				GetGroupCount(MipExtent));
+		}
+
+		// Upsample mip SourceMip onto mip OutputMip, replacing or adding to its contents
+		int32 NumUpsamplePasses = 0;
+		auto AddUpsample = [&](FRDGEventName&& EventName, int32 SourceMip, int32 OutputMip, float FilterRadius, bool bAdditive)
+		{
+			CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomKawaseUp);
+			const FIntPoint OutputExtent = PlannedPyramid.GetMipExtent(OutputMip);
+
+			FClassicBloomBatchedKawaseUpsampleCS::FParameters* UpParams = GraphBuilder.AllocParameters<FClassicBloomBatchedKawaseUpsampleCS::FParameters>();
+			UpParams->SourceTexture = GraphBuilder.CreateSRV(FRDGTextureSRVDesc::CreateForMipLevel(Pyramid, SourceMip));
+			UpParams->SourceSampler = BilinearSampler;
+			UpParams->OutputSizeAndInvSize = SizeAndInvSize(OutputExtent);
+			UpParams->NumSlices = NumSlices;
+			UpParams->FilterRadius = FilterRadius;
+			UpParams->bAdditive = bAdditive ? 1 : 0;
+			UpParams->RWOutputTexture = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(Pyramid, OutputMip));
+
+			FComputeShaderUtils::AddPass(GraphBuilder, MoveTemp(EventName), KawaseUpsampleShader, UpParams, GetGroupCount(OutputExtent));
+			++NumUpsamplePasses;
+		};
+
+		// As the per-view plan: copy the first level into the bloom mip (a zero radius makes the tent bilinear)
+		// before the upsamples accumulate into it, then D += blur(E), C += blur(D), ... and finally the bloom mip
+		AddUpsample(RDG_EVENT_NAME("KawaseUpsample_Base"), 1, 0, 0.0f, false);
+		for (int32 Mip = MipCount - 2; Mip >= 0; --Mip)
+		{
+			AddUpsample(RDG_EVENT_NAME("KawaseUpsample_Mip%d", Mip), Mip + 2, Mip + 1, Settings.KawaseFilterRadius, true);
+		}
+		if (MipCount > 1)
+		{
+			AddUpsample(RDG_EVENT_NAME("KawaseUpsample_Final"), 1, 0, Settings.KawaseFilterRadius, true);
+		}
+
+		AccountBloomPasses(MipCount + NumUpsamplePasses, TransientTextureBytes);
+		BatchedBloom.Texture = Pyramid;
+		return true;
+	}
+
+	// Standard and Soft Focus: bright pass, then separable blur passes
+	FRDGTextureRef BrightPassTexture = CreateArray(SliceExtent, TEXT("ClassicBloom.Batched.BrightPass"));
+	{
+		CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomBrightPass);
+		FClassicBloomBatchedBrightPassCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomBatchedBrightPassCS::FParameters>();
+		PassParameters->SceneColorTexture = FamilySceneColor;
+		PassParameters->SourceSampler = BilinearSampler;
+		SetSceneColorUVScaleBias(&PassParameters->SourceUVScaleBias[0], SliceExtent);
+		PassParameters->OutputSizeAndInvSize = SizeAndInvSize(SliceExtent);
+		PassParameters->NumSlices = NumSlices;
+		PassParameters->BloomThreshold = Derived.BrightPassThreshold;
+		PassParameters->RWOutputTexture = GraphBuilder.CreateUAV(BrightPassTexture);
+
+		FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("BrightPass"), BrightPassShader, PassParameters, GetGroupCount(SliceExtent));
+	}
+
+	FRDGTextureRef BlurSource = BrightPassTexture;
+	FRDGTextureRef BlurTempTexture = CreateArray(SliceExtent, TEXT("ClassicBloom.Batched.BlurTemp"));
+	FRDGTextureRef BlurredTexture = CreateArray(SliceExtent, TEXT("ClassicBloom.Batched.Blurred"));
+
+	for (int32 PassIndex = 0; PassIndex < Derived.BlurIterations; ++PassIndex)
+	{
+		for (int32 Axis = 0; Axis < 2; ++Axis)
+		{
+			CLASSIC_BLOOM_STAGE_SCOPE(GraphBuilder, ClassicBloomBlur);
+			FClassicBloomBatchedBlurCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FClassicBloomBatchedBlurCS::FParameters>();
+			PassParameters->SourceTexture = Axis == 0 ? BlurSource : BlurTempTexture;
+			PassParameters->SourceSampler = BilinearSampler;
+			PassParameters->OutputSizeAndInvSize = SizeAndInvSize(SliceExtent);
+			PassParameters->NumSlices = NumSlices;
+			PassParameters->BlurDirection = Axis == 0 ? FVector2f(1.0f, 0.0f) : FVector2f(0.0f, 1.0f);
+			PassParameters->BlurWeights = Derived.BlurKernel.GetShaderWeights();
+			PassParameters->BlurOffsets = Derived.BlurKernel.GetShaderOffsets();
+			PassParameters->RWOutputTexture = GraphBuilder.CreateUAV(Axis == 0 ? BlurTempTexture : BlurredTexture);
+
+			FComputeShaderUtils::AddPass(
+				GraphBuilder,
+				Axis == 0 ? RDG_EVENT_NAME("BlurHorizontal") : RDG_EVENT_NAME("BlurVertical"),
+				BlurShader,
+				PassParameters,
+				GetGroupCount(SliceExtent));
+		}
+
+		BlurSource = BlurredTexture;
+	}
+
+	AccountBloomPasses(1 + 2 * Derived.BlurIterations, TransientTextureBytes);
+	BatchedBloom.Texture = BlurredTexture;
+	return true;
+}
+
 // ============================================================================
 // UClassicBloomSubsystem Implementation
 // ============================================================================
@@ -1004,7 +1670,17 @@ void UClassicBloomSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	Super::Initialize(Collection);
 
 	// Create and register the scene view extension
-	SceneViewExtension = FSceneViewExtensions::NewExtension<FClassicBloomSceneViewExtension>(this);
+	SceneViewExtension = FSceneViewExtensions::NewExtension<FClassicBloomSceneViewExtension>(this, Registry, KernelSpectrumCache);
+
+	static bool bReportedPermutations = false;
+	if (!bReportedPermutations)
+	{
+		bReportedPermutations = true;
+		UE_LOG(LogClassicBloom, Log, TEXT("Composite shader: %d of %d permutations compiled for %s"),
+			FClassicBloomCompositePS::GetNumCompiledPermutations(GMaxRHIShaderPlatform),
+			FClassicBloomCompositePS::FPermutationDomain::PermutationCount,
+			*LexToString(GMaxRHIShaderPlatform));
+	}
 }
 
 void UClassicBloomSubsystem::Deinitialize()
@@ -1017,16 +1693,137 @@ void UClassicBloomSubsystem::Deinitialize()
 
 void UClassicBloomSubsystem::RegisterBloomComponent(UBloomFXComponent* Component)
 {
-	if (Component)
+	if (!Component)
+	{
+		return;
+	}
+
+	PrefetchKernelSpectrum(Component);
+
+	if (UBloomFXVolumeComponent* Volume = Cast<UBloomFXVolumeComponent>(Component))
 	{
-		BloomComponents.AddUnique(Component);
+		VolumeIndex.Add(Volume);
+		return;
+	}
+
+	if (Component->bOnlyAffectViewTarget)
+	{
+		if (AActor* Owner = Component->GetOwner())
+		{
+			ViewTargetComponents.Add(Owner, Component);
+		}
+		return;
 	}
+
+	Registry->Register(Component);
 }
 
 void UClassicBloomSubsystem::UnregisterBloomComponent(UBloomFXComponent* Component)
 {
+	if (!Component)
+	{
+		return;
+	}
+
+	if (UBloomFXVolumeComponent* Volume = Cast<UBloomFXVolumeComponent>(Component))
+	{
+		VolumeIndex.Remove(Volume);
+		return;
+	}
+
+	// The routing flag may have changed since registration, so remove from both places
+	if (AActor* Owner = Component->GetOwner())
+	{
+		const TWeakObjectPtr<UBloomFXComponent>* Registered = ViewTargetComponents.Find(Owner);
+		if (Registered && *Registered == Component)
+		{
+			ViewTargetComponents.Remove(Owner);
+		}
+	}
+
+	Registry->Unregister(Component);
+}
+
+void UClassicBloomSubsystem::NotifyBloomComponentChanged(UBloomFXComponent* Component)
+{
+	PrefetchKernelSpectrum(Component);
+
+	if (UBloomFXVolumeComponent* Volume = Cast<UBloomFXVolumeComponent>(Component))
+	{
+		if (VolumeIndex.Contains(Volume))
+		{
+			VolumeIndex.MarkDirty();
+		}
+		return;
+	}
+
+	// View target components and player overrides are read in SetupView every frame
+	Registry->Update(Component);
+}
+
+void UClassicBloomSubsystem::PrefetchKernelSpectrum(const UBloomFXComponent* Component)
+{
+	// Volumes and view target components may end up convolving with their kernel too
+	if (Component && Component->GetRenderSettings())
+	{
+		KernelSpectrumCache->Prefetch(*Component->GetRenderSettings());
+	}
+}
+
+void UClassicBloomSubsystem::SetPlayerBloomOverride(APlayerController* Player, UBloomFXComponent* Component)
+{
+	if (!Player)
+	{
+		return;
+	}
+
+	PlayerOverrides.RemoveAllSwap([Player](const FPlayerBloomOverride& Override)
+	{
+		return !Override.Player.IsValid() || Override.Player.Get() == Player;
+	});
+
 	if (Component)
 	{
-		BloomComponents.Remove(Component);
+		PlayerOverrides.Add({ Player, Component });
+	}
+}
+
+bool UClassicBloomSubsystem::NeedsPerViewSettings()
+{
+	return ViewTargetComponents.Num() > 0 || PlayerOverrides.Num() > 0 || VolumeIndex.HasActiveVolumes();
+}
+
+FClassicBloomRenderSettingsPtr UClassicBloomSubsystem::ResolveSettingsForView(const FSceneView& View)
+{
+	check(IsInGameThread());
+	return VolumeIndex.Resolve(View.ViewLocation, GetBaseSettingsForViewTarget(View.ViewActor));
+}
+
+const FClassicBloomRenderSettingsPtr& UClassicBloomSubsystem::GetBaseSettingsForViewTarget(const AActor* ViewTarget) const
+{
+	if (ViewTarget)
+	{
+		// Component on the view target itself (camera-attached bloom)
+		if (const TWeakObjectPtr<UBloomFXComponent>* Found = ViewTargetComponents.Find(ViewTarget))
+		{
+			const UBloomFXComponent* Component = Found->Get();
+			if (Component && Component->IsActive() && Component->GetRenderSettings().IsValid())
+			{
+				return Component->GetRenderSettings();
+			}
+		}
+
+		// Override set for the local player currently viewing through this target
+		for (const FPlayerBloomOverride& Override : PlayerOverrides)
+		{
+			const APlayerController* Player = Override.Player.Get();
+			const UBloomFXComponent* Component = Override.Component.Get();
+			if (Player && Component && Component->IsActive() && Player->IsLocalController() && Player->GetViewTarget() == ViewTarget && Component->GetRenderSettings().IsValid())
+			{
+				return Component->GetRenderSettings();
+			}
+		}
 	}
+
+	return Registry->GetActiveSettingsPtr();
 }
@@ -0,0 +1,179 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "ClassicBloomPassPlan.h"
+#include "ClassicBloomDerivedParams.h"
+#include "Algo/Count.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClassicBloomPassPlanTest
+{
+	// A 1080p view inside a larger, padded scene color texture
+	static const FIntPoint SceneColorExtent(1920, 1088);
+	static const FIntRect ViewRect(0, 0, 1920, 1080);
+
+	static FClassicBloomRenderSettings MakeSettings(EBloomMode Mode)
+	{
+		FClassicBloomRenderSettings Settings;
+		Settings.BloomMode = Mode;
+		return Settings;
+	}
+
+	static FClassicBloomPassPlan BuildPlan(const FClassicBloomRenderSettings& Settings)
+	{
+		return FClassicBloomPassPlan::Build(Settings, FClassicBloomDerivedParams::Compute(Settings), SceneColorExtent, ViewRect, ERHIFeatureLevel::SM5, true);
+	}
+
+	static int32 CountPasses(const FClassicBloomPassPlan& Plan, EClassicBloomPassType Type)
+	{
+		return Algo::CountIf(Plan.Passes, [Type](const FClassicBloomPlannedPass& Pass) { return Pass.Type == Type; });
+	}
+
+	static bool IsSameTexture(const FClassicBloomPlannedTexture& A, const FClassicBloomPlannedTexture& B)
+	{
+		return A.Extent == B.Extent && A.Format == B.Format && FCString::Strcmp(A.Name, B.Name) == 0
+			&& A.NumMips == B.NumMips && A.ArraySize == B.ArraySize && A.bUAV == B.bUAV;
+	}
+
+	static bool IsSamePass(const FClassicBloomPlannedPass& A, const FClassicBloomPlannedPass& B)
+	{
+		if (A.Type != B.Type || A.Slice != B.Slice || A.Output != B.Output || A.OutputMip != B.OutputMip || A.NumOutputMips != B.NumOutputMips
+			|| A.bAdditive != B.bAdditive || A.NumInputs != B.NumInputs || A.Radius != B.Radius || A.Threshold != B.Threshold
+			|| A.Iterations != B.Iterations || A.BlurKernel.GetNumTaps() != B.BlurKernel.GetNumTaps())
+		{
+			return false;
+		}
+		for (int32 Input = 0; Input < A.NumInputs; ++Input)
+		{
+			if (A.Inputs[Input] != B.Inputs[Input] || A.InputMips[Input] != B.InputMips[Input])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static bool IsSamePlan(const FClassicBloomPassPlan& A, const FClassicBloomPassPlan& B)
+	{
+		if (A.BloomTexture != B.BloomTexture || A.Textures.Num() != B.Textures.Num() || A.Passes.Num() != B.Passes.Num()
+			|| A.TransientTextureBytes != B.TransientTextureBytes || A.Slices.Num() != B.Slices.Num())
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < A.Textures.Num(); ++Index)
+		{
+			if (!IsSameTexture(A.Textures[Index], B.Textures[Index]))
+			{
+				return false;
+			}
+		}
+		for (int32 Index = 0; Index < A.Passes.Num(); ++Index)
+		{
+			if (!IsSamePass(A.Passes[Index], B.Passes[Index]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClassicBloomPassPlanKawaseBrightPassTest, "ClassicBloom.PassPlan.KawaseRemovesBrightPass",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FClassicBloomPassPlanKawaseBrightPassTest::RunTest(const FString& Parameters)
+{
+	using namespace ClassicBloomPassPlanTest;
+
+	// The Gaussian blurs the bright pass, so it must survive there for the Kawase result to mean anything
+	const FClassicBloomPassPlan Standard = BuildPlan(MakeSettings(EBloomMode::Standard));
+	TestTrue(TEXT("Standard plan is valid"), Standard.IsValid());
+	TestEqual(TEXT("Standard plan keeps its bright pass"), CountPasses(Standard, EClassicBloomPassType::BrightPass), 1);
+
+	// Kawase thresholds in its first downsample, with or without the single-dispatch chain
+	for (const bool bSinglePass : { true, false })
+	{
+		FClassicBloomRenderSettings Settings = MakeSettings(EBloomMode::Kawase);
+		Settings.bKawaseSinglePassDownsample = bSinglePass;
+		const FClassicBloomPassPlan Kawase = BuildPlan(Settings);
+
+		const TCHAR* Variant = bSinglePass ? TEXT("single-pass") : TEXT("per-mip");
+		TestTrue(FString::Printf(TEXT("Kawase (%s) plan is valid"), Variant), Kawase.IsValid());
+		TestEqual(FString::Printf(TEXT("Kawase (%s) plan has no bright pass"), Variant), CountPasses(Kawase, EClassicBloomPassType::BrightPass), 0);
+		TestFalse(FString::Printf(TEXT("Kawase (%s) plan drops the bright pass texture"), Variant),
+			Kawase.Textures.ContainsByPredicate([](const FClassicBloomPlannedTexture& Texture) { return FCString::Strcmp(Texture.Name, TEXT("ClassicBloom.BrightPass")) == 0; }));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClassicBloomPassPlanLiveProducersTest, "ClassicBloom.PassPlan.KeepsAdditiveAndPartialMipProducers",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FClassicBloomPassPlanLiveProducersTest::RunTest(const FString& Parameters)
+{
+	using namespace ClassicBloomPassPlanTest;
+
+	// Per-mip Kawase: every downsample writes one mip of the pyramid, the upsamples add onto the mip below
+	{
+		FClassicBloomRenderSettings Settings = MakeSettings(EBloomMode::Kawase);
+		Settings.bKawaseSinglePassDownsample = false;
+		const FClassicBloomPassPlan Plan = BuildPlan(Settings);
+
+		TestEqual(TEXT("Every partial-mip downsample is kept"), CountPasses(Plan, EClassicBloomPassType::KawaseDownsample), Settings.KawaseMipCount);
+		// Base copy, one in-place upsample per level below the coarsest, then the final additive upsample
+		TestEqual(TEXT("Every upsample is kept"), CountPasses(Plan, EClassicBloomPassType::KawaseUpsample), Settings.KawaseMipCount + 1);
+	}
+
+	// The chain writes mips 1.. only, and the base copy then writes mip 0 of the same texture
+	{
+		const FClassicBloomPassPlan Plan = BuildPlan(MakeSettings(EBloomMode::Kawase));
+		TestEqual(TEXT("The downsample chain is kept"), CountPasses(Plan, EClassicBloomPassType::KawaseDownsampleChain), 1);
+	}
+
+	// Glare with more axes than one pass takes: later streak passes add onto the first one's output
+	{
+		FClassicBloomRenderSettings Settings = MakeSettings(EBloomMode::DirectionalGlare);
+		Settings.GlareStreakCount = 12;
+		const FClassicBloomDerivedParams Derived = FClassicBloomDerivedParams::Compute(Settings);
+		const int32 ExpectedPasses = FMath::DivideAndRoundUp(Derived.StreakDirections.Num(), FClassicBloomPlannedPass::MaxStreakAxes);
+		const FClassicBloomPassPlan Plan = BuildPlan(Settings);
+
+		TestTrue(TEXT("The glare settings need several streak passes"), ExpectedPasses > 1);
+		TestEqual(TEXT("Every additive streak pass and the one it adds onto are kept"), CountPasses(Plan, EClassicBloomPassType::GlareStreak), ExpectedPasses);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClassicBloomPassPlanEqualInputsTest, "ClassicBloom.PassPlan.EqualInputsGiveEqualPlans",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FClassicBloomPassPlanEqualInputsTest::RunTest(const FString& Parameters)
+{
+	using namespace ClassicBloomPassPlanTest;
+
+	for (const EBloomMode Mode : { EBloomMode::Standard, EBloomMode::DirectionalGlare, EBloomMode::Kawase, EBloomMode::SoftFocus })
+	{
+		// Two snapshots made independently from the same values, as two components with equal properties would
+		FClassicBloomRenderSettings A = MakeSettings(Mode);
+		FClassicBloomRenderSettings B = MakeSettings(Mode);
+		A.BloomIntensity = B.BloomIntensity = 1.5f;
+		A.bFrameSlicing = B.bFrameSlicing = true;
+
+		const int32 ModeIndex = (int32)Mode;
+		TestTrue(FString::Printf(TEXT("Mode %d: equal settings compare equal"), ModeIndex), A == B);
+		TestEqual(FString::Printf(TEXT("Mode %d: equal settings hash equal"), ModeIndex), GetTypeHash(A), GetTypeHash(B));
+		TestTrue(FString::Printf(TEXT("Mode %d: equal settings build equal plans"), ModeIndex), IsSamePlan(BuildPlan(A), BuildPlan(B)));
+
+		// A value the plan depends on has to change the cache key as well
+		B.DownsampleScale = 0.5f;
+		TestFalse(FString::Printf(TEXT("Mode %d: different settings compare different"), ModeIndex), A == B);
+		TestFalse(FString::Printf(TEXT("Mode %d: different settings build different plans"), ModeIndex), IsSamePlan(BuildPlan(A), BuildPlan(B)));
+	}
+
+	return true;
+}
+
+#endif
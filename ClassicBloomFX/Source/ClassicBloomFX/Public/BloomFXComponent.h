@@ -6,6 +6,9 @@
 #include "Components/SceneComponent.h"
 #include "BloomFXComponent.generated.h"
 
+class UTexture2D;
+struct FClassicBloomRenderSettings;
+
 /** Post-process pass to apply bloom after */
 UENUM(BlueprintType)
 enum class EBloomPostProcessPass : uint8
@@ -49,7 +52,9 @@ enum class EBloomMode : uint8
 	/** Kawase bloom - Progressive pyramid blur */
 	Kawase UMETA(DisplayName = "Kawase"),
 	/** Soft Focus - Dreamy full-scene glow effect */
-	SoftFocus UMETA(DisplayName = "Soft Focus (Dreamy Glow)")
+	SoftFocus UMETA(DisplayName = "Soft Focus (Dreamy Glow)"),
+	/** FFT convolution - bright pass convolved with a kernel image (lens flare, diffraction spikes); cost does not depend on the kernel size */
+	Convolution UMETA(DisplayName = "FFT Convolution")
 };
 
 /**
@@ -68,7 +73,7 @@ public:
 	// Bloom Mode
 	// ========================================================================
 	
-	/** Bloom effect mode - Standard Gaussian, Directional Glare, Kawase, or Soft Focus */
+	/** Bloom effect mode - Standard Gaussian, Directional Glare, Kawase, Soft Focus, or FFT Convolution */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bloom Mode")
 	EBloomMode BloomMode = EBloomMode::Standard;
 
@@ -77,15 +82,15 @@ public:
 	// ========================================================================
 	
 	/** Overall intensity of the bloom effect */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bloom Settings", meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "8.0"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetBloomIntensity, Category = "Bloom Settings", meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "8.0"))
 	float BloomIntensity = 2.0f;
 
 	/** Threshold for bloom - only pixels brighter than this will bloom (not used in Soft Focus mode) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bloom Settings", meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "10.0", EditCondition = "BloomMode != EBloomMode::SoftFocus"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetBloomThreshold, Category = "Bloom Settings", meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "10.0", EditCondition = "BloomMode != EBloomMode::SoftFocus"))
 	float BloomThreshold = 0.8f;
 
 	/** Size of the bloom effect (Standard and Glare modes only) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bloom Settings", meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "64.0", EditCondition = "BloomMode == EBloomMode::Standard || BloomMode == EBloomMode::DirectionalGlare || BloomMode == EBloomMode::SoftFocus"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetBloomSize, Category = "Bloom Settings", meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "64.0", EditCondition = "BloomMode == EBloomMode::Standard || BloomMode == EBloomMode::DirectionalGlare || BloomMode == EBloomMode::SoftFocus"))
 	float BloomSize = 4.0f;
 
 	/** Use scene colors for bloom (realistic) or apply tint color */
@@ -93,7 +98,7 @@ public:
 	bool bUseSceneColor = true;
 
 	/** Tint color for the bloom (only used when Use Scene Color is disabled) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bloom Settings", meta = (EditCondition = "!bUseSceneColor"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetBloomTint, Category = "Bloom Settings", meta = (EditCondition = "!bUseSceneColor"))
 	FLinearColor BloomTint = FLinearColor::White;
 
 	/** Blend mode for compositing bloom onto the scene */
@@ -101,7 +106,7 @@ public:
 	EBloomBlendMode BloomBlendMode = EBloomBlendMode::Screen;
 
 	/** Saturation boost for bloom colors (1.0 = normal, >1.0 = more vibrant, <1.0 = desaturated) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bloom Settings", meta = (ClampMin = "0.0", ClampMax = "3.0", UIMin = "0.0", UIMax = "2.0"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetBloomSaturation, Category = "Bloom Settings", meta = (ClampMin = "0.0", ClampMax = "3.0", UIMin = "0.0", UIMax = "2.0"))
 	float BloomSaturation = 1.0f;
 
 	/** Protect highlights from over-brightening (prevents bloom from washing out to white) */
@@ -124,14 +129,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bloom Quality", meta = (ClampMin = "1", ClampMax = "4", UIMin = "1", UIMax = "4", EditCondition = "BloomMode == EBloomMode::Standard || BloomMode == EBloomMode::SoftFocus", EditConditionHides))
 	int32 BlurPasses = 1;
 
-	/** Blur quality - number of samples per tap (5, 9, or 13) */
+	/** Blur quality - Gaussian taps per axis (5, 9, or 13; other values use the nearest). Adjacent taps share a bilinear fetch, so 13 taps cost 7 fetches */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bloom Quality", meta = (ClampMin = "5", ClampMax = "13", UIMin = "5", UIMax = "13", EditCondition = "BloomMode == EBloomMode::Standard || BloomMode == EBloomMode::SoftFocus", EditConditionHides))
-	int32 BlurSamples = 5;
+	int32 BlurSamples = 9;
 
 	/** Use high quality upsampling (slower but reduces pixelation) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bloom Quality", meta = (EditCondition = "BloomMode == EBloomMode::Standard || BloomMode == EBloomMode::SoftFocus", EditConditionHides))
 	bool bHighQualityUpsampling = false;
 
+	/** Run the Gaussian blur as compute passes that read each texel once into groupshared memory; every blur pass along one axis shares a dispatch */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bloom Quality", meta = (EditCondition = "BloomMode != EBloomMode::Kawase", EditConditionHides))
+	bool bComputeBlur = true;
+
 	// ========================================================================
 	// Directional Glare Settings (only for DirectionalGlare mode)
 	// ========================================================================
@@ -152,6 +161,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Directional Glare Settings", meta = (ClampMin = "0.5", ClampMax = "10.0", UIMin = "1.0", UIMax = "5.0", EditCondition = "BloomMode == EBloomMode::DirectionalGlare", EditConditionHides))
 	float GlareFalloff = 3.0f;
 
+	/** Build each streak from a few 4-tap passes with growing stride (1, 4, 16, ...) instead of one 33-tap pass; cost grows with log(length) and long streaks are not undersampled */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Directional Glare Settings", meta = (EditCondition = "BloomMode == EBloomMode::DirectionalGlare", EditConditionHides))
+	bool bLogGlareStreaks = false;
+
+	/** Render each streak axis into its own buffer downsampled this many times along the axis (sheared for diagonals), then stretch it back; 1 = off. Long streaks at a fraction of the fill rate. Not used with bLogGlareStreaks */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Directional Glare Settings", meta = (ClampMin = "1", ClampMax = "8", UIMin = "1", UIMax = "4", EditCondition = "BloomMode == EBloomMode::DirectionalGlare && !bLogGlareStreaks", EditConditionHides))
+	int32 GlareStreakDownsample = 1;
+
 	// ========================================================================
 	// Kawase Bloom Settings (only for Kawase mode)
 	// ========================================================================
@@ -172,6 +189,26 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Kawase Bloom Settings", meta = (ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0", EditCondition = "BloomMode == EBloomMode::Kawase && bKawaseSoftThreshold", EditConditionHides))
 	float KawaseThresholdKnee = 0.5f;
 
+	/** Build the whole downsample pyramid in one compute dispatch instead of one pass per mip (same result, fewer barriers and mostly-idle small passes) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Kawase Bloom Settings", meta = (EditCondition = "BloomMode == EBloomMode::Kawase", EditConditionHides))
+	bool bKawaseSinglePassDownsample = true;
+
+	// ========================================================================
+	// Convolution Settings (only for Convolution mode)
+	// ========================================================================
+
+	/** Kernel image the bright pass is convolved with; its center is the light source. Brightness is normalized, so only its shape and color matter. No bloom without a kernel */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Convolution Settings", meta = (EditCondition = "BloomMode == EBloomMode::Convolution", EditConditionHides))
+	TObjectPtr<UTexture2D> ConvolutionKernel;
+
+	/** Width of the kernel image as a fraction of the view's longer side */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Convolution Settings", meta = (ClampMin = "0.05", ClampMax = "1.0", UIMin = "0.1", UIMax = "1.0", EditCondition = "BloomMode == EBloomMode::Convolution", EditConditionHides))
+	float ConvolutionKernelSize = 0.5f;
+
+	/** Largest FFT size (256, 512 or 1024); the bright pass is downsampled so it and the kernel's reach fit, so larger sizes give sharper kernels at a higher cost */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Convolution Settings", meta = (ClampMin = "256", ClampMax = "1024", EditCondition = "BloomMode == EBloomMode::Convolution", EditConditionHides))
+	int32 ConvolutionFFTSize = 512;
+
 	// ========================================================================
 	// Soft Focus Tuning (deprecated - soft focus now uses standard bloom settings)
 	// These are kept for backward compatibility but hidden from UI
@@ -209,11 +246,65 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Advanced", meta = (ClampMin = "0.1", ClampMax = "2.0", UIMin = "0.5", UIMax = "1.5"))
 	float GameModeBloomScale = 1.0f;
 
+	/**
+	 * Only apply to views whose view target is the owning actor (e.g. a component on each player's camera in split-screen).
+	 * Such components never act as the global bloom; a view target component takes precedence over player overrides.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Advanced")
+	bool bOnlyAffectViewTarget = false;
+
+	/**
+	 * Render split-screen/stereo views together: bright pass, blur and Kawase pyramid run once for all views
+	 * (one texture array slice per view) and each view only runs its own composite.
+	 * Batching needs a pass that still hands every view the family's scene color texture, e.g. Motion Blur with motion blur
+	 * and depth of field off; where views get post-processed inputs of their own (always after Tonemap) they render per view.
+	 * Only views with matching bloom settings and resolution are batched; Directional Glare and FFT Convolution always render per view.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Advanced")
+	bool bBatchMultiView = false;
+
+	/**
+	 * Render the bloom stages at half the bloom resolution per axis, offset by a different sub-texel jitter every frame,
+	 * and accumulate them into a per-view history reprojected with the camera's motion. Gives close to full-resolution
+	 * bloom at about a quarter of the cost. History is dropped on disocclusion, exposure jumps and camera cuts.
+	 * Not used in FFT Convolution mode; temporal views always render per view.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Advanced")
+	bool bTemporalReuse = false;
+
+	/** Share of the reprojected history kept every frame with temporal reuse (higher = smoother but slower to react) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Advanced", meta = (ClampMin = "0.0", ClampMax = "0.98", UIMin = "0.5", UIMax = "0.95", EditCondition = "bTemporalReuse"))
+	float TemporalHistoryWeight = 0.9f;
+
+	/**
+	 * Spread the most expensive stages over several frames: glare streak axes are split into groups refreshed on
+	 * alternating frames, and Kawase mode refreshes its deeper mips every other frame. Results are kept per view
+	 * between refreshes. Only used by Directional Glare and Kawase, and not together with temporal reuse.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Advanced")
+	bool bFrameSlicing = false;
+
+	/** Most a frame may cost with frame slicing, as a fraction of the full bloom chain (the lowest reachable peak is used if none fits) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Advanced", meta = (ClampMin = "0.25", ClampMax = "1.0", EditCondition = "bFrameSlicing"))
+	float FrameSliceMaxCost = 0.6f;
+
+	/**
+	 * Hold the bloom's GPU time near GpuBudgetMs. Timings read back from GPU timestamps a few frames late step
+	 * BlurPasses, GlareStreakCount, KawaseMipCount and DownsampleScale down from the values set here when over budget,
+	 * and back up when there is room again. Not used in FFT Convolution mode.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Advanced")
+	bool bGpuBudget = false;
+
+	/** GPU milliseconds the bloom of each view may take per frame with bGpuBudget */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Advanced", meta = (ClampMin = "0.1", ClampMax = "10.0", UIMin = "0.25", UIMax = "4.0", EditCondition = "bGpuBudget"))
+	float GpuBudgetMs = 1.0f;
+
 	// ========================================================================
 	// Debug Settings
 	// ========================================================================
 
-	/** Enable debug logging to output log */
+	/** Log pass plan rebuilds and reinitialization to LogClassicBloom (per-frame data is in the ClassicBloom trace channel) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
 	bool bEnableDebugLogging = false;
 
@@ -237,6 +328,45 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
 	bool bReinitializeRect = false;
 
+	// ========================================================================
+	// Render Settings
+	// ========================================================================
+
+	/** Push changed settings to the renderer - call after writing properties directly (the setters below and editor changes push on their own) */
+	UFUNCTION(BlueprintCallable, Category = "Rendering|Bloom")
+	void MarkBloomSettingsDirty();
+
+	/** Begin a batch of property edits - nothing is pushed to the renderer until the matching EndBloomSettingsBatch */
+	UFUNCTION(BlueprintCallable, Category = "Rendering|Bloom")
+	void BeginBloomSettingsBatch();
+
+	/** End a batch of property edits - pushes a single settings update if anything changed */
+	UFUNCTION(BlueprintCallable, Category = "Rendering|Bloom")
+	void EndBloomSettingsBatch();
+
+	/** Setters for the commonly animated settings; Blueprint Set nodes and Sequencer tracks go through these and push the change */
+	UFUNCTION(BlueprintSetter)
+	void SetBloomIntensity(float NewIntensity);
+
+	UFUNCTION(BlueprintSetter)
+	void SetBloomThreshold(float NewThreshold);
+
+	UFUNCTION(BlueprintSetter)
+	void SetBloomSize(float NewSize);
+
+	UFUNCTION(BlueprintSetter)
+	void SetBloomTint(FLinearColor NewTint);
+
+	UFUNCTION(BlueprintSetter)
+	void SetBloomSaturation(float NewSaturation);
+
+	/** Latest settings snapshot pushed to the renderer (null until the component is registered) */
+	const TSharedPtr<const FClassicBloomRenderSettings, ESPMode::ThreadSafe>& GetRenderSettings() const { return RenderSettings; }
+
+	// UActorComponent interface
+	virtual void Activate(bool bReset = false) override;
+	virtual void Deactivate() override;
+
 protected:
 	virtual void OnRegister() override;
 	virtual void OnUnregister() override;
@@ -251,7 +381,16 @@ protected:
 private:
 	void RegisterWithSubsystem();
 	void UnregisterFromSubsystem();
+
+	/** Rebuild the settings snapshot and notify the subsystem if any value changed */
+	void UpdateRenderSettings();
 	
 	// Timer for auto-reinitialize
 	float ReinitializeTimer = 0.0f;
+
+	// Immutable snapshot last pushed to the renderer
+	TSharedPtr<const FClassicBloomRenderSettings, ESPMode::ThreadSafe> RenderSettings;
+
+	// Nesting depth of Begin/EndBloomSettingsBatch
+	int32 SettingsBatchDepth = 0;
 };
@@ -0,0 +1,59 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BloomFXComponent.h"
+#include "BloomFXVolumeComponent.generated.h"
+
+/**
+ * Localized bloom look (caves, interiors, neon districts...)
+ * Applies its settings to views inside its box and fades out over BlendRadius outside it.
+ * Overlapping volumes are blended by priority on top of the active global UBloomFXComponent.
+ */
+UCLASS(ClassGroup=(Rendering), meta=(BlueprintSpawnableComponent), hidecategories=(Object, LOD, Lighting, TextureStreaming, Activation, "Components|Activation"))
+class CLASSICBLOOMFX_API UBloomFXVolumeComponent : public UBloomFXComponent
+{
+	GENERATED_BODY()
+
+public:
+	UBloomFXVolumeComponent();
+
+	// ========================================================================
+	// Bloom Volume
+	// ========================================================================
+
+	/** Half-size of the volume box in component space */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bloom Volume", meta = (ClampMin = "0.0"))
+	FVector BoxExtent = FVector(500.0f);
+
+	/** Volumes with higher priority are blended on top of lower priority ones */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bloom Volume")
+	float Priority = 0.0f;
+
+	/** Distance outside the box over which the volume fades out (world units, 0 = hard edge) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bloom Volume", meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "2000.0"))
+	float BlendRadius = 100.0f;
+
+	/** Weight of the volume inside the box (1.0 = fully overrides lower priority settings) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bloom Volume", meta = (ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0"))
+	float BlendWeight = 1.0f;
+
+protected:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport) override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	/** Tell the subsystem the volume shape changed so the spatial index gets rebuilt */
+	void NotifyVolumeChanged();
+
+	// Shape values last reported to the subsystem (Blueprint/Sequencer write the properties directly)
+	FVector ReportedBoxExtent = FVector::ZeroVector;
+	float ReportedPriority = 0.0f;
+	float ReportedBlendRadius = 0.0f;
+	float ReportedBlendWeight = 0.0f;
+};
@@ -0,0 +1,27 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ClassicBloomBatchCommandlet.generated.h"
+
+/**
+ * Applies ClassicBloom to a folder of EXR / PNG frames on the CPU, without a GPU or a world.
+ * Frames flow through a bounded decode -> bloom -> encode pipeline; each stage runs on its own
+ * worker threads and blocks when the next stage falls behind, so memory stays bounded.
+ *
+ * UnrealEditor-Cmd <Project> -run=ClassicBloomBatch -Input=<Dir> -Output=<Dir>
+ *     [-Preset=<BloomFXComponent, or actor class holding one> | -Settings=<File.json>]
+ *     [-Format=exr|png] [-DecodeThreads=N] [-EncodeThreads=N] [-QueueDepth=N]
+ */
+UCLASS()
+class UClassicBloomBatchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UClassicBloomBatchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,36 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClassicBloomRenderSettings.h"
+
+/**
+ * Values of the r.ClassicBloom.* quality console variables, which sg.PostProcessQuality sets per scalability
+ * level (Config/DefaultScalability.ini). They cap what components and volumes author, never raise it; 0 leaves
+ * a parameter as authored.
+ */
+struct CLASSICBLOOMFX_API FClassicBloomCVarOverrides
+{
+	int32 MinDownsampleDivisor = 0;
+	int32 MaxBlurPasses = 0;
+	int32 MaxBlurSamples = 0;
+	int32 MaxKawaseMipCount = 0;
+	int32 MaxGlareStreakCount = 0;
+	int32 ModeFallback = 0;  // 1: FFT Convolution renders as Standard; 2: Directional Glare does too
+
+	/** Current values as the render thread sees them (console changes reach it with the next frame) */
+	static FClassicBloomCVarOverrides Get_RenderThread();
+
+	/** r.ClassicBloom.Enable on the calling thread; safe on the game and render threads */
+	static bool IsBloomEnabled();
+
+	/** Whether every parameter is left as authored */
+	bool IsEmpty() const
+	{
+		return MinDownsampleDivisor == 0 && MaxBlurPasses == 0 && MaxBlurSamples == 0 && MaxKawaseMipCount == 0 && MaxGlareStreakCount == 0 && ModeFallback == 0;
+	}
+
+	/** Apply the mode fallback, then clamp Settings' parameters to the caps */
+	void Apply(FClassicBloomRenderSettings& Settings) const;
+};
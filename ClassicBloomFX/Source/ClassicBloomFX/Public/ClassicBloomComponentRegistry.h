@@ -0,0 +1,80 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "ClassicBloomRenderSettings.h"
+#include <atomic>
+
+class UBloomFXComponent;
+
+/**
+ * Event-driven registry of bloom components owned by UClassicBloomSubsystem.
+ *
+ * Mutated on the game thread only (register, unregister, activate, deactivate, settings change).
+ * The settings of the first active component in registration order are published through an
+ * atomic pointer, so readers on any thread pay a single atomic load instead of scanning components.
+ * A replaced snapshot is released by a render command, i.e. only after every render command that
+ * could still hold the old pointer has finished (RCU-style grace period).
+ */
+class CLASSICBLOOMFX_API FClassicBloomComponentRegistry
+{
+public:
+	FClassicBloomComponentRegistry() = default;
+	~FClassicBloomComponentRegistry();
+
+	FClassicBloomComponentRegistry(const FClassicBloomComponentRegistry&) = delete;
+	FClassicBloomComponentRegistry& operator=(const FClassicBloomComponentRegistry&) = delete;
+
+	// Game thread
+	void Register(UBloomFXComponent* Component);
+	void Unregister(UBloomFXComponent* Component);
+	void Update(UBloomFXComponent* Component);
+	bool IsRegistered(const UBloomFXComponent* Component) const { return Serials.Contains(Component); }
+	const TArray<TWeakObjectPtr<UBloomFXComponent>>& GetComponents() const { return Components; }
+
+	/**
+	 * Settings of the first active component, or null if none is active.
+	 * Safe on any thread; the pointer stays valid for the rest of the current render command.
+	 */
+	const FClassicBloomRenderSettings* GetActiveSettings() const
+	{
+		return PublishedSettings.load(std::memory_order_acquire);
+	}
+
+	/** Owning pointer to the published settings (game thread only) */
+	const FClassicBloomRenderSettingsPtr& GetActiveSettingsPtr() const
+	{
+		check(IsInGameThread());
+		return PublishedOwner;
+	}
+
+private:
+	struct FActiveEntry
+	{
+		uint64 Serial = 0;
+		FClassicBloomRenderSettingsPtr Settings;
+	};
+
+	// Insert, replace or remove the component's entry in ActiveEntries; returns true if the head changed
+	bool SetActiveEntry(uint64 Serial, FClassicBloomRenderSettingsPtr Settings);
+	bool RemoveActiveEntry(uint64 Serial);
+
+	// Publish the head of ActiveEntries and retire the previously published snapshot
+	void Publish();
+
+	// Registered components in registration order (kept for UClassicBloomSubsystem::GetBloomComponents)
+	TArray<TWeakObjectPtr<UBloomFXComponent>> Components;
+
+	// Registration serial per component; a lower serial wins when several components are active
+	TMap<TObjectKey<UBloomFXComponent>, uint64> Serials;
+	uint64 NextSerial = 1;
+
+	// Active components sorted by serial; the first entry is the one being rendered
+	TArray<FActiveEntry> ActiveEntries;
+
+	// Owner of the published snapshot (game thread) and the pointer readers load
+	FClassicBloomRenderSettingsPtr PublishedOwner;
+	std::atomic<const FClassicBloomRenderSettings*> PublishedSettings{ nullptr };
+};
@@ -0,0 +1,28 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClassicBloomRenderSettings.h"
+#include "ClassicBloomImage.h"
+
+class UTexture2D;
+
+/**
+ * Whole-effect CPU path: builds the same pass plan the renderer replays into RDG and runs it with
+ * the ClassicBloomCore kernels, followed by the composite. Needs no RHI, so it serves offline
+ * processing, server-side tools and regression tests on machines without a GPU.
+ * Intermediates stay in full float, where the GPU stores them as R11G11B10.
+ */
+struct CLASSICBLOOMFX_API FClassicBloomCpuRenderer
+{
+	/**
+	 * Bloom SceneColor (linear HDR, the whole image is the view) into OutColor.
+	 * ConvolutionKernel stands in for the settings' kernel texture in Convolution mode (see LoadConvolutionKernel).
+	 * Returns false and copies the scene unchanged when the settings produce no bloom.
+	 */
+	static bool Render(const FClassicBloomRenderSettings& Settings, const FClassicBloomImage& SceneColor, FClassicBloomImage& OutColor, bool bIsGameWorld = true, const FClassicBloomImage* ConvolutionKernel = nullptr);
+
+	/** Linear image of a convolution kernel texture's source art (game thread; false without editor-only data) */
+	static bool LoadConvolutionKernel(UTexture2D& Texture, FClassicBloomImage& OutKernel);
+};
@@ -0,0 +1,65 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClassicBloomRenderSettings.h"
+#include "ClassicBloomBlurKernel.h"
+
+/**
+ * Render-thread constants derived from a settings snapshot that do not depend on the view
+ * (streak direction table, blur kernels, composite constants).
+ * Views whose resolved settings are equal share one instance through FClassicBloomDerivedParamsCache.
+ */
+struct CLASSICBLOOMFX_API FClassicBloomDerivedParams
+{
+	// Bright pass threshold (soft focus captures the whole scene)
+	float BrightPassThreshold = 0.0f;
+
+	// Unit streak directions, one per distinct axis of the GlareStreakCount streaks evenly spread from
+	// GlareRotationOffset (streaks are symmetric, so directions 180 degrees apart share an axis)
+	TArray<FVector2f> StreakDirections;
+
+	// Share of the glare average per axis: the number of streaks on the axis / GlareStreakCount
+	TArray<float> StreakWeights;
+
+	// Separable Gaussian of the standard path, applied BlurIterations times per axis (BlurPasses, or 1 when
+	// the passes collapse into one wider kernel), and the lighter smoothing blur after the glare
+	FClassicBloomBlurKernel BlurKernel;
+	int32 BlurIterations = 1;
+	FClassicBloomBlurKernel GlareBlurKernel;
+
+	// Composite constants (bloom intensity is routed to SoftFocusIntensity in soft focus mode)
+	float CompositeBloomIntensity = 0.0f;
+	float SoftFocusIntensity = 0.0f;
+	FVector4f BloomTint = FVector4f(1.0f, 1.0f, 1.0f, 1.0f); // Alpha: 1 = use scene color, 0 = use tint
+
+	static FClassicBloomDerivedParams Compute(const FClassicBloomRenderSettings& Settings);
+};
+
+/**
+ * Small render-thread cache of derived parameters keyed by settings value.
+ * Entries not requested for a few frames are evicted, and the cache never grows past MaxEntries.
+ */
+class CLASSICBLOOMFX_API FClassicBloomDerivedParamsCache
+{
+public:
+	/** Derived parameters for Settings, computed on first use; the reference is valid for the current pass setup */
+	const FClassicBloomDerivedParams& FindOrCompute(const FClassicBloomRenderSettings& Settings);
+
+	void Reset() { Entries.Reset(); }
+
+private:
+	static constexpr int32 MaxEntries = 16;
+	static constexpr uint32 MaxAge = 8;
+
+	struct FEntry
+	{
+		uint32 Hash = 0;
+		FClassicBloomRenderSettings Settings;
+		TUniquePtr<FClassicBloomDerivedParams> Params;
+		uint32 LastUsedFrame = 0;
+	};
+
+	TArray<FEntry> Entries;
+};
@@ -0,0 +1,47 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderGraphFwd.h"
+#include "RHIResources.h"
+
+/**
+ * GPU time of the bloom passes, from RHI timestamp queries read back a few frames later without waiting.
+ * Each view's passes are bracketed by a begin and an end timestamp; the durations of every view of a frame
+ * add up to that frame's time. Render thread only.
+ */
+class CLASSICBLOOMFX_API FClassicBloomGpuTimer
+{
+public:
+	/** Whether the RHI supports timestamp queries at all */
+	static bool IsSupported();
+
+	/** Timestamp before the first bloom pass of a view; a begin never ended is dropped */
+	void AddBeginPass(FRDGBuilder& GraphBuilder);
+
+	/** Timestamp after the last bloom pass of the view */
+	void AddEndPass(FRDGBuilder& GraphBuilder);
+
+	/** Bloom GPU time of the oldest frame whose timestamps have all landed and that was not returned yet */
+	bool ReadBack(float& OutMilliseconds);
+
+	/** Drop every frame in flight */
+	void Reset();
+
+private:
+	// Frames whose timestamps never land (device removed, query lost) are dropped after this many frames
+	static constexpr uint32 MaxLatency = 8;
+
+	struct FFrame
+	{
+		uint32 FrameNumber = 0;
+		TArray<TPair<FRHIPooledRenderQuery, FRHIPooledRenderQuery>, TInlineAllocator<2>> Views;  // Begin, end
+	};
+
+	FRenderQueryPoolRHIRef QueryPool;
+	FRHIPooledRenderQuery PendingBegin;
+	TArray<FFrame> Frames;  // Oldest first
+
+	void AddTimestampPass(FRDGBuilder& GraphBuilder, FRHIPooledRenderQuery& OutQuery);
+};
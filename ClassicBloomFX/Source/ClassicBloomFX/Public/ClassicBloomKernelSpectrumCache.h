@@ -0,0 +1,114 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "PixelFormat.h"
+#include "RenderGraphFwd.h"
+#include "RendererInterface.h"
+#include "ClassicBloomRenderSettings.h"
+#include <atomic>
+
+/** Identifies an FFT convolution kernel spectrum: the kernel image's contents, the transform layout and the texel format */
+struct CLASSICBLOOMFX_API FClassicBloomKernelSpectrumKey
+{
+	FGuid KernelId;
+	int32 FFTSize = 0;
+	float KernelTexels = 0.0f;
+	EPixelFormat Format = PF_Unknown;
+
+	/** Key of the spectrum Settings convolve with; invalid outside FFT convolution mode or without a kernel */
+	static FClassicBloomKernelSpectrumKey Make(const FClassicBloomRenderSettings& Settings);
+
+	bool IsValid() const { return KernelId.IsValid() && FFTSize > 0; }
+
+	/** Bytes of both spectrum slices, top mip only */
+	uint64 GetSpectrumBytes() const;
+
+	bool operator==(const FClassicBloomKernelSpectrumKey& Other) const
+	{
+		return KernelId == Other.KernelId && FFTSize == Other.FFTSize && KernelTexels == Other.KernelTexels && Format == Other.Format;
+	}
+
+	friend uint32 GetTypeHash(const FClassicBloomKernelSpectrumKey& Key)
+	{
+		uint32 Hash = GetTypeHash(Key.KernelId);
+		Hash = HashCombineFast(Hash, GetTypeHash(Key.FFTSize));
+		Hash = HashCombineFast(Hash, GetTypeHash(Key.KernelTexels));
+		return HashCombineFast(Hash, GetTypeHash((int32)Key.Format));
+	}
+};
+
+/** Lookups since startup; a miss computes the spectrum on the GPU, a derived data miss builds it on the CPU */
+struct FClassicBloomKernelSpectrumCacheStats
+{
+	uint32 Hits = 0;
+	uint32 Misses = 0;
+	uint32 DerivedDataHits = 0;
+	uint32 DerivedDataMisses = 0;
+};
+
+/**
+ * Kernel spectra of the FFT convolution owned by UClassicBloomSubsystem and shared with its scene view extension.
+ *
+ * The render thread keeps every spectrum it computes as a pooled texture, so the two kernel passes run once per
+ * key instead of every frame; entries not requested for MaxAge frames are released. In editor builds the game
+ * thread prefetches the spectrum of every registered component from the derived data cache, building it on the
+ * CPU from the kernel's source art on a miss, so the first frame after startup or a level load neither runs the
+ * kernel passes nor waits for the kernel texture to stream in.
+ */
+class CLASSICBLOOMFX_API FClassicBloomKernelSpectrumCache : public TSharedFromThis<FClassicBloomKernelSpectrumCache, ESPMode::ThreadSafe>
+{
+public:
+	/** Game thread: start loading the spectrum Settings convolve with (no-op without a derived data cache) */
+	void Prefetch(const FClassicBloomRenderSettings& Settings);
+
+	/** Render thread: cached spectrum for Key, or null when the caller has to compute it and hand it to Add */
+	FRDGTextureRef Find(FRDGBuilder& GraphBuilder, const FClassicBloomKernelSpectrumKey& Key);
+
+	/** Render thread: keep Spectrum, computed in this graph, for later frames */
+	void Add(FRDGBuilder& GraphBuilder, const FClassicBloomKernelSpectrumKey& Key, FRDGTextureRef Spectrum);
+
+	/** Safe on any thread */
+	FClassicBloomKernelSpectrumCacheStats GetStats() const;
+
+private:
+	static constexpr int32 MaxEntries = 4;
+	static constexpr uint32 MaxAge = 300;
+
+	struct FEntry
+	{
+		FClassicBloomKernelSpectrumKey Key;
+		TRefCountPtr<IPooledRenderTarget> Texture;
+		TArray<uint8> PrefetchedData;  // Spectrum slices back to back, uploaded on first use
+		uint32 LastUsedFrame = 0;
+	};
+
+	FEntry* FindEntry(const FClassicBloomKernelSpectrumKey& Key);
+
+	// New entry, evicting the least recently used one when full; null if every entry is in use this frame
+	FEntry* AddEntry(const FClassicBloomKernelSpectrumKey& Key);
+
+	// Render thread: drop an entry along with its key's prefetch record
+	void RemoveEntry(int32 Index);
+
+	// Any thread: let the next Prefetch of Key load it again
+	void ForgetPrefetchedKey(const FClassicBloomKernelSpectrumKey& Key);
+
+	// Render thread: hand over a spectrum loaded or built by a prefetch
+	void AddPrefetched(const FClassicBloomKernelSpectrumKey& Key, TArray<uint8>&& Data);
+
+	// Render thread; entries are heap allocated so a pending texture extraction keeps a stable target
+	TArray<TUniquePtr<FEntry>> Entries;
+
+	// Keys prefetched and still cached (or loading), so settings changes do not query the derived data cache again.
+	// Added on the game thread, removed by the render thread when it evicts the key's entry
+	TSet<FClassicBloomKernelSpectrumKey> PrefetchedKeys;
+	FCriticalSection PrefetchedKeysLock;
+
+	std::atomic<uint32> Hits{ 0 };
+	std::atomic<uint32> Misses{ 0 };
+	std::atomic<uint32> DerivedDataHits{ 0 };
+	std::atomic<uint32> DerivedDataMisses{ 0 };
+};
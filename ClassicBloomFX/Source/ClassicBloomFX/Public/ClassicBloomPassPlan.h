@@ -0,0 +1,234 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PixelFormat.h"
+#include "RHIFeatureLevel.h"
+#include "ClassicBloomRenderSettings.h"
+#include "ClassicBloomBlurKernel.h"
+#include "ClassicBloomFrameSlicer.h"
+
+struct FClassicBloomDerivedParams;
+
+/** Pass kinds a plan can contain; each maps to one pixel or compute shader */
+enum class EClassicBloomPassType : uint8
+{
+	BrightPass,
+	GlareStreak,
+	GlareStreakStep,
+	GlareStreakResolve,
+	Blur,
+	BlurCompute,
+	KawaseDownsample,
+	KawaseDownsampleChain,
+	KawaseUpsample,
+	FFTForwardRows,
+	FFTColumns,
+	FFTInverseRows,
+};
+
+/** Scale and bias taking an output pixel position to a source texture UV (same layout as FScreenTransform) */
+struct FClassicBloomUVTransform
+{
+	FVector2f Scale = FVector2f(1.0f, 1.0f);
+	FVector2f Bias = FVector2f(0.0f, 0.0f);
+
+	/** Output texel position in [0, OutputSize) -> UV of SourceRect inside a texture of SourceExtent */
+	static FClassicBloomUVTransform TexelToSourceUV(FIntPoint OutputSize, FIntPoint SourceExtent, const FIntRect& SourceRect);
+};
+
+/** Affine map taking an output pixel position to a source texture UV; unlike FClassicBloomUVTransform it can shear */
+struct FClassicBloomAffineUVTransform
+{
+	FVector3f U = FVector3f(1.0f, 0.0f, 0.0f);  // UV.x = dot(U, (SvPosition, 1))
+	FVector3f V = FVector3f(0.0f, 1.0f, 0.0f);  // UV.y = dot(V, (SvPosition, 1))
+
+	/** Map from output pixels to the pixels of a source of SourceExtent (rows X and Y), turned into UVs */
+	static FClassicBloomAffineUVTransform PixelToSourceUV(const FVector3f& X, const FVector3f& Y, FIntPoint SourceExtent);
+};
+
+/** Intermediate texture of a plan; every mip is used in full (rect == mip extent). ArraySize > 1 plans a Texture2DArray */
+struct FClassicBloomPlannedTexture
+{
+	FIntPoint Extent = FIntPoint::ZeroValue;
+	EPixelFormat Format = PF_FloatR11G11B10;
+	const TCHAR* Name = TEXT("");
+	int32 NumMips = 1;
+	int32 ArraySize = 1;
+	bool bUAV = false;  // Written by a compute pass
+
+	/** Extent of a mip as the RHI allocates it (halved and rounded down, at least 1) */
+	FIntPoint GetMipExtent(int32 Mip) const
+	{
+		return FIntPoint(FMath::Max(Extent.X >> Mip, 1), FMath::Max(Extent.Y >> Mip, 1));
+	}
+
+	uint64 GetMemorySize() const;
+};
+
+/** One fullscreen pass (or dispatch); parameters not used by its type are left at their defaults */
+struct FClassicBloomPlannedPass
+{
+	/** Input slot referring to the view's scene color rather than a planned texture */
+	static constexpr int32 SceneColorInput = -2;
+	/** Input slot referring to the settings' convolution kernel texture */
+	static constexpr int32 ConvolutionKernelInput = -3;
+	static constexpr int32 MaxInputs = 4;
+	static constexpr int32 MaxStreakAxes = 4;
+
+	EClassicBloomPassType Type = EClassicBloomPassType::Blur;
+	const TCHAR* Name = TEXT("");
+	int32 NameIndex = INDEX_NONE;  // Appended to the event name when set (mip, streak or batch index)
+	int32 Slice = INDEX_NONE;      // Frame slicing: the plan slice this pass belongs to, or every frame
+
+	int32 Output = INDEX_NONE;
+	int32 OutputMip = 0;
+	int32 NumOutputMips = 1;  // Kawase downsample chain writes OutputMip .. OutputMip + NumOutputMips - 1
+	bool bAdditive = false;   // Blend onto the output's contents instead of clearing it
+
+	int32 Inputs[MaxInputs] = { INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE };
+	int32 InputMips[MaxInputs] = { 0, 0, 0, 0 };
+	int32 NumInputs = 0;
+
+	// Glare streak (slot 0) and streak resolve (every slot): output pixel -> input UV, sheared for anisotropic streak buffers
+	FClassicBloomAffineUVTransform InputTransforms[MaxInputs];
+
+	// Sampling of Inputs[0] when it does not match the output 1:1 (bright pass, Kawase downsample; glare streak extent only).
+	// FFT passes: SourceExtent is the region holding data, the rest of the transform is zero
+	FClassicBloomUVTransform SvPositionToSourceUV;
+	FIntPoint SourceExtent = FIntPoint::ZeroValue;
+
+	FVector2f Direction = FVector2f::ZeroVector;  // Blur axis or streak direction
+	float Radius = 0.0f;                          // Streak length, streak step stride, Kawase filter radius or convolution kernel width in texels
+	FClassicBloomBlurKernel BlurKernel;           // Blur: weights and fetch offsets, tap count selects the permutation
+	float Falloff = 0.0f;
+	FVector4f StreakAxes[MaxStreakAxes];          // Glare streak: xy = axis direction, z = share of the accumulated average
+	int32 NumStreakAxes = 0;
+	FVector4f TapWeights = FVector4f(0.0f, 0.0f, 0.0f, 0.0f);  // Glare streak step: weights of the taps at (TapStart + i) * Radius
+	float TapStart = 0.0f;
+	float Threshold = 0.0f;
+	float ThresholdKnee = 0.0f;
+	int32 MipLevel = 0;
+	int32 Iterations = 1;                         // Compute blur: passes along Direction applied in one dispatch
+};
+
+/** Passes the frame slicer may skip on some frames; PersistentTextures carry their result to the frames in between */
+struct FClassicBloomPlannedSlice
+{
+	TArray<int32, TInlineAllocator<4>> PersistentTextures;
+	int32 NumPasses = 0;
+	float Cost = 0.0f;
+};
+
+/**
+ * Sizes of the FFT convolution. They follow from the settings alone, never from the view size, so one kernel
+ * spectrum serves every view and resolution: the bright pass is scaled so its longer side plus the kernel's
+ * reach fits the square transform, and the circular convolution never wraps bloom from one edge onto the other.
+ */
+struct CLASSICBLOOMFX_API FClassicBloomConvolutionLayout
+{
+	/** Spectrum textures hold (R, G) and (B, 0) as complex pairs in two array slices */
+	static constexpr EPixelFormat SpectrumFormat = PF_A32B32G32R32F;
+	static constexpr int32 SpectrumSlices = 2;
+
+	int32 ImageLongSide = 0;    // Bright pass texels along the view's longer side
+	int32 FFTSize = 0;          // Width and height of every transform
+	float KernelTexels = 0.0f;  // Kernel image width in spectrum texels
+
+	static FClassicBloomConvolutionLayout Make(const FClassicBloomRenderSettings& Settings);
+
+	/** Bright pass extent for a view of ViewSize: its aspect ratio with ImageLongSide texels along the longer side */
+	FIntPoint GetImageExtent(FIntPoint ViewSize) const;
+};
+
+/**
+ * Immutable description of the bloom passes for one (settings, view size, feature level) combination.
+ * Built without touching RDG; the render thread only replays it. Passes whose output never reaches
+ * the bloom texture are removed, along with the textures they wrote.
+ */
+struct CLASSICBLOOMFX_API FClassicBloomPassPlan
+{
+	TArray<FClassicBloomPlannedTexture> Textures;
+	TArray<FClassicBloomPlannedPass> Passes;
+
+	/** Texture the composite samples (INDEX_NONE when the plan is empty) */
+	int32 BloomTexture = INDEX_NONE;
+
+	/**
+	 * FFT convolution: spectrum of the kernel image, which depends on the settings only. A renderer holding it
+	 * from an earlier frame binds it here and skips the NumKernelSpectrumPasses passes writing it.
+	 */
+	int32 KernelSpectrumTexture = INDEX_NONE;
+	int32 NumKernelSpectrumPasses = 0;
+
+	/**
+	 * Frame slicing: work refreshed on some frames only, and which slices run on which frame. Passes outside a
+	 * slice only read its PersistentTextures; anything else it writes is scratch it overwrites before reading.
+	 */
+	TArray<FClassicBloomPlannedSlice> Slices;
+	FClassicBloomFrameSlicer SliceSchedule;
+
+	/** Resolution every bloom stage is sized from (view rect / downsample divisor) */
+	FIntPoint DownsampledExtent = FIntPoint::ZeroValue;
+
+	/** Temporal reuse: resolution of the history the bloom texture is reconstructed into (zero without temporal reuse) */
+	FIntPoint TemporalExtent = FIntPoint::ZeroValue;
+
+	/** Memory of all planned textures and their mips, for the per-frame transient texture counter */
+	uint64 TransientTextureBytes = 0;
+
+	bool IsValid() const { return BloomTexture != INDEX_NONE; }
+
+	/**
+	 * Plan the passes for a view whose scene color occupies ViewRect inside a texture of SceneColorExtent.
+	 * bR11G11B10SupportsUAV tells whether compute targets can use R11G11B10 (otherwise half float).
+	 */
+	static FClassicBloomPassPlan Build(
+		const FClassicBloomRenderSettings& Settings,
+		const FClassicBloomDerivedParams& Derived,
+		FIntPoint SceneColorExtent,
+		const FIntRect& ViewRect,
+		ERHIFeatureLevel::Type FeatureLevel,
+		bool bR11G11B10SupportsUAV);
+
+private:
+	void RemoveDeadPasses();
+};
+
+/**
+ * Small render-thread LRU of pass plans keyed by settings value, view rect, scene color extent, feature level and format support.
+ * Entries not requested for a few frames are evicted, and the cache never grows past MaxEntries.
+ */
+class CLASSICBLOOMFX_API FClassicBloomPassPlanCache
+{
+public:
+	/** Plan for these inputs, built on first use; the reference is valid for the current pass setup */
+	const FClassicBloomPassPlan& FindOrBuild(
+		const FClassicBloomRenderSettings& Settings,
+		const FClassicBloomDerivedParams& Derived,
+		FIntPoint SceneColorExtent,
+		const FIntRect& ViewRect,
+		ERHIFeatureLevel::Type FeatureLevel,
+		bool bR11G11B10SupportsUAV);
+
+	void Reset() { Entries.Reset(); }
+
+private:
+	static constexpr int32 MaxEntries = 16;
+	static constexpr uint32 MaxAge = 8;
+
+	struct FEntry
+	{
+		uint32 Hash = 0;
+		FClassicBloomRenderSettings Settings;
+		FIntPoint SceneColorExtent = FIntPoint::ZeroValue;
+		FIntRect ViewRect;
+		ERHIFeatureLevel::Type FeatureLevel = ERHIFeatureLevel::Num;
+		bool bR11G11B10SupportsUAV = false;
+		TUniquePtr<FClassicBloomPassPlan> Plan;
+		uint32 LastUsedFrame = 0;
+	};
+
+	TArray<FEntry> Entries;
+};
@@ -0,0 +1,137 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHIResources.h"
+#include "BloomFXComponent.h"
+#include "ClassicBloomBudgetController.h"
+
+/**
+ * Immutable snapshot of UBloomFXComponent settings consumed by the render thread.
+ * Built on the game thread only when a property changes and handed to the renderer
+ * via ENQUEUE_RENDER_COMMAND, so the render thread never touches the component.
+ * Values are already clamped to the ranges the shaders expect.
+ */
+struct CLASSICBLOOMFX_API FClassicBloomRenderSettings
+{
+	// Bloom mode
+	EBloomMode BloomMode = EBloomMode::Standard;
+
+	// Shared settings
+	float BloomIntensity = 2.0f;
+	float BloomThreshold = 0.8f;
+	float BloomSize = 4.0f;
+	bool bUseSceneColor = true;
+	FLinearColor BloomTint = FLinearColor::White;
+	EBloomBlendMode BloomBlendMode = EBloomBlendMode::Screen;
+	float BloomSaturation = 1.0f;
+	bool bProtectHighlights = false;
+	float HighlightProtection = 0.5f;
+
+	// Quality (Standard and Soft Focus)
+	float DownsampleScale = 1.0f;
+	int32 BlurPasses = 1;
+	int32 BlurSamples = 9; // 5, 9 or 13
+	bool bHighQualityUpsampling = false;
+	bool bComputeBlur = true;
+
+	// Directional glare
+	int32 GlareStreakCount = 6;
+	float GlareStreakLength = 40.0f;
+	float GlareRotationOffset = 0.0f;
+	float GlareFalloff = 3.0f;
+	bool bLogGlareStreaks = false;
+	int32 GlareStreakDownsample = 1;
+
+	// Kawase
+	int32 KawaseMipCount = 5;
+	float KawaseFilterRadius = 0.002f;
+	bool bKawaseSoftThreshold = true;
+	float KawaseThresholdKnee = 0.5f; // Already zero when soft threshold is disabled
+	bool bKawaseSinglePassDownsample = true;
+
+	// FFT convolution. The kernel object is for the game thread only (spectrum prefetch); the render thread binds
+	// ConvolutionKernelTexture, which the snapshot keeps alive however long it outlives the component or the texture
+	TWeakObjectPtr<const UTexture2D> ConvolutionKernel;
+	FTextureReferenceRHIRef ConvolutionKernelTexture; // Follows whatever resource the kernel texture currently has
+	FGuid ConvolutionKernelId; // Changes with the kernel image's contents; identifies the kernel in every cache key
+	float ConvolutionKernelSize = 0.5f;
+	int32 ConvolutionFFTSize = 512; // 256, 512 or 1024
+
+	// Soft focus tuning (x=OverlayMult, y=BlendStrength, z=SoftLightMult, w=FinalBlend)
+	FVector4f SoftFocusParams = FVector4f(0.5f, 0.33f, 0.4f, 0.25f);
+
+	// Advanced
+	EBloomPostProcessPass PostProcessPass = EBloomPostProcessPass::Tonemap;
+	bool bUseAdaptiveBrightnessScaling = false;
+	float GameModeBloomScale = 1.0f;
+	bool bBatchMultiView = false;
+	bool bTemporalReuse = false;
+	float TemporalHistoryWeight = 0.9f;
+	bool bFrameSlicing = false;
+	float FrameSliceMaxCost = 0.6f;
+	bool bGpuBudget = false;
+	float GpuBudgetMs = 1.0f;
+
+	// Debug
+	bool bEnableDebugLogging = false;
+	bool bShowBloomOnly = false;
+	bool bShowGammaCompensation = false;
+
+	/** Build a clamped snapshot from the component's current property values (game thread only) */
+	static FClassicBloomRenderSettings FromComponent(const UBloomFXComponent& Component);
+
+	/** Downsample divisor applied to the view rect for the bloom buffers */
+	int32 GetDownsampleDivisor() const
+	{
+		return FMath::Max(1, FMath::RoundToInt(2.0f / DownsampleScale));
+	}
+
+	/** Per-axis factor by which temporal reuse lowers the resolution of the bloom stages below the bloom resolution */
+	static constexpr int32 TemporalDownsampleFactor = 2;
+
+	/** Whether the bloom stages run at reduced resolution and are reconstructed into a per-view history */
+	bool UsesTemporalReuse() const
+	{
+		return bTemporalReuse && BloomMode != EBloomMode::Convolution;
+	}
+
+	/** Whether the plan splits glare axes or the deeper Kawase mips into slices refreshed on some frames only */
+	bool UsesFrameSlicing() const
+	{
+		return bFrameSlicing && !UsesTemporalReuse() && (BloomMode == EBloomMode::DirectionalGlare || BloomMode == EBloomMode::Kawase);
+	}
+
+	/** Whether a GPU time budget may lower the quality parameters below the authored values */
+	bool UsesGpuBudget() const
+	{
+		return bGpuBudget && BloomMode != EBloomMode::Convolution;
+	}
+
+	/** The parameters the GPU budget lowers, as authored */
+	FClassicBloomQualityLevel GetQualityLevel() const;
+
+	/** Which of those parameters the bloom mode uses */
+	EClassicBloomQualityAxes GetQualityAxes() const;
+
+	/** Replace the parameters the GPU budget lowers; DownsampleScale is only touched when the divisor changes */
+	void ApplyQualityLevel(const FClassicBloomQualityLevel& Level);
+
+	/** Whether a view with Other can share the batched bright pass, blur and pyramid with this one */
+	bool IsBatchCompatible(const FClassicBloomRenderSettings& Other) const;
+
+	/** Lerp every float and color parameter towards Other (used to blend bloom volumes) */
+	void BlendContinuousFrom(const FClassicBloomRenderSettings& Other, float Alpha);
+
+	/** Copy the mode, pass counts, toggles and other parameters that cannot be interpolated */
+	void CopyDiscreteFrom(const FClassicBloomRenderSettings& Other);
+
+	bool operator==(const FClassicBloomRenderSettings& Other) const;
+	bool operator!=(const FClassicBloomRenderSettings& Other) const { return !(*this == Other); }
+
+	friend CLASSICBLOOMFX_API uint32 GetTypeHash(const FClassicBloomRenderSettings& Settings);
+};
+
+/** Shared, immutable settings snapshot that can be handed between threads */
+using FClassicBloomRenderSettingsPtr = TSharedPtr<const FClassicBloomRenderSettings, ESPMode::ThreadSafe>;
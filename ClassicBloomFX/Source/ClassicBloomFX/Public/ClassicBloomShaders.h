@@ -6,6 +6,9 @@
 #include "GlobalShader.h"
 #include "ShaderParameterStruct.h"
 #include "ScreenPass.h"
+#include "SceneRenderTargetParameters.h"
+#include "ClassicBloomBlurKernel.h"
+#include "ClassicBloomComputeLimits.h"
 
 // Bright pass shader - extracts bright pixels for bloom
 class FClassicBloomBrightPassPS : public FGlobalShader
@@ -32,6 +35,9 @@ public:
 	}
 };
 
+// Gaussian tap count (FClassicBloomBlurKernel::GetNumTaps); adjacent taps share a bilinear fetch
+class FClassicBloomBlurTapsDim : SHADER_PERMUTATION_SPARSE_INT("BLUR_TAPS", 5, 9, 13);
+
 // Gaussian blur shader - separable (does horizontal or vertical)
 class FClassicBloomBlurPS : public FGlobalShader
 {
@@ -39,13 +45,16 @@ public:
 	DECLARE_GLOBAL_SHADER(FClassicBloomBlurPS);
 	SHADER_USE_PARAMETER_STRUCT(FClassicBloomBlurPS, FGlobalShader);
 
+	using FPermutationDomain = TShaderPermutationDomain<FClassicBloomBlurTapsDim>;
+
 	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
 		SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
 		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SourceTexture)
 		SHADER_PARAMETER_SAMPLER(SamplerState, SourceSampler)
 		SHADER_PARAMETER(FVector4f, BufferSizeAndInvSize)
 		SHADER_PARAMETER(FVector2f, BlurDirection)
-		SHADER_PARAMETER(float, BlurRadius)
+		SHADER_PARAMETER(FVector4f, BlurWeights) // x = center, yzw = fetch pairs (FClassicBloomBlurKernel)
+		SHADER_PARAMETER(FVector4f, BlurOffsets) // yzw = fetch pair distances in texels
 		RENDER_TARGET_BINDING_SLOTS()
 	END_SHADER_PARAMETER_STRUCT()
 
@@ -55,6 +64,57 @@ public:
 	}
 };
 
+// Gaussian blur compute shader - caches a row or column tile in groupshared memory,
+// and can apply several blur passes along that axis in one dispatch
+class FClassicBloomBlurCS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FClassicBloomBlurCS);
+	SHADER_USE_PARAMETER_STRUCT(FClassicBloomBlurCS, FGlobalShader);
+
+	static constexpr int32 ThreadGroupSize = FClassicBloomComputeBlurLimits::ThreadGroupSize;
+	static constexpr int32 TileSize = FClassicBloomComputeBlurLimits::TileSize;
+	static constexpr int32 MaxApron = FClassicBloomComputeBlurLimits::MaxApron;
+
+	using FPermutationDomain = TShaderPermutationDomain<FClassicBloomBlurTapsDim>;
+
+	static int32 GetApron(const FClassicBloomBlurKernel& Kernel)
+	{
+		return FClassicBloomComputeBlurLimits::GetApron(Kernel);
+	}
+
+	static FIntVector GetGroupCount(FIntPoint Extent, bool bVertical)
+	{
+		return bVertical
+			? FIntVector(FMath::DivideAndRoundUp(Extent.Y, TileSize), Extent.X, 1)
+			: FIntVector(FMath::DivideAndRoundUp(Extent.X, TileSize), Extent.Y, 1);
+	}
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SourceTexture)
+		SHADER_PARAMETER(FIntPoint, SourceSize)
+		SHADER_PARAMETER(FVector4f, BlurWeights) // x = center, yzw = fetch pairs (FClassicBloomBlurKernel)
+		SHADER_PARAMETER(FVector4f, BlurOffsets) // yzw = fetch pair distances in texels
+		SHADER_PARAMETER(uint32, bVertical)
+		SHADER_PARAMETER(uint32, Iterations)
+		SHADER_PARAMETER(uint32, Apron)
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, RWOutputTexture)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), ThreadGroupSize);
+		OutEnvironment.SetDefine(TEXT("TILE_SIZE"), TileSize);
+		OutEnvironment.SetDefine(TEXT("MAX_APRON"), MaxApron);
+	}
+};
+
 // Composite bloom shader - adds bloom back to scene
 class FClassicBloomCompositePS : public FGlobalShader
 {
@@ -62,38 +122,65 @@ public:
 	DECLARE_GLOBAL_SHADER(FClassicBloomCompositePS);
 	SHADER_USE_PARAMETER_STRUCT(FClassicBloomCompositePS, FGlobalShader);
 
+	// Read the bloom from a slice of the batched multi-view texture array
+	class FBloomTextureArrayDim : SHADER_PERMUTATION_BOOL("BLOOM_TEXTURE_ARRAY");
+	// EBloomBlendMode: 0=Screen, 1=Overlay, 2=SoftLight, 3=HardLight, 4=Lighten, 5=Multiply
+	class FBlendModeDim : SHADER_PERMUTATION_RANGE_INT("BLEND_MODE", 0, 6);
+	// Soft focus composite (SoftFocusIntensity > 0) instead of the highlight bloom
+	class FSoftFocusDim : SHADER_PERMUTATION_BOOL("SOFT_FOCUS");
+	class FProtectHighlightsDim : SHADER_PERMUTATION_BOOL("PROTECT_HIGHLIGHTS");
+	class FAdaptiveScalingDim : SHADER_PERMUTATION_BOOL("ADAPTIVE_SCALING");
+	// 0 = off, 1 = bloom buffer only, 2 = scene color (gamma compensation check); not compiled where debug view modes are not allowed
+	class FDebugViewDim : SHADER_PERMUTATION_RANGE_INT("DEBUG_VIEW", 0, 3);
+	using FPermutationDomain = TShaderPermutationDomain<FBloomTextureArrayDim, FBlendModeDim, FSoftFocusDim, FProtectHighlightsDim, FAdaptiveScalingDim, FDebugViewDim>;
+
 	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
 		SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
 		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SceneColorTexture)
 		SHADER_PARAMETER_SAMPLER(SamplerState, SceneColorSampler)
 		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, BloomTexture)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2DArray, BloomTextureArray)
+		SHADER_PARAMETER(float, BloomArraySlice)
 		SHADER_PARAMETER_SAMPLER(SamplerState, BloomSampler)
 		SHADER_PARAMETER(FVector4f, OutputViewportSizeAndInvSize)
 		SHADER_PARAMETER(FScreenTransform, SvPositionToSceneColorUV) // Transform SvPosition to scene color texture UV
 		SHADER_PARAMETER(FScreenTransform, SvPositionToBloomUV) // Transform SvPosition to bloom texture UV
 		SHADER_PARAMETER(float, BloomIntensity)
 		SHADER_PARAMETER(FVector4f, BloomTint)
-		SHADER_PARAMETER(float, BloomBlendMode) // 0=Screen, 1=Overlay, 2=SoftLight, 3=HardLight, 4=Lighten, 5=Multiply
 		SHADER_PARAMETER(float, BloomSaturation) // Saturation multiplier for bloom colors
-		SHADER_PARAMETER(float, bProtectHighlights) // 1.0 = enabled, 0.0 = disabled
 		SHADER_PARAMETER(float, HighlightProtection) // Strength of highlight protection (0.0-1.0)
 		SHADER_PARAMETER(float, SoftFocusIntensity)
 		SHADER_PARAMETER(FVector4f, SoftFocusParams) // x=OverlayMult, y=BlendStrength, z=SoftLightMult, w=FinalBlend
-		SHADER_PARAMETER(float, bUseAdaptiveScaling) // Encoded as 1.0 or 0.0
-		SHADER_PARAMETER(float, bShowBloomOnly) // Debug: show only bloom buffer
-		SHADER_PARAMETER(float, bShowGammaCompensation) // Debug: visualize gamma compensation
-		SHADER_PARAMETER(float, bIsGameWorld) // 1.0 if game/PIE world, 0.0 if editor
-		SHADER_PARAMETER(float, GameModeBloomScale) // Manual compensation for game mode
+		SHADER_PARAMETER(float, BloomScale) // Without adaptive scaling: GameModeBloomScale in game worlds, 1 in the editor
 		RENDER_TARGET_BINDING_SLOTS()
 	END_SHADER_PARAMETER_STRUCT()
 
+	/** Debug views replace the whole composite, so the other dimensions collapse to their first value */
+	static FPermutationDomain RemapPermutation(FPermutationDomain PermutationVector)
+	{
+		if (PermutationVector.Get<FDebugViewDim>() != 0)
+		{
+			PermutationVector.Set<FBlendModeDim>(0);
+			PermutationVector.Set<FSoftFocusDim>(false);
+			PermutationVector.Set<FProtectHighlightsDim>(false);
+			PermutationVector.Set<FAdaptiveScalingDim>(false);
+		}
+		return PermutationVector;
+	}
+
+	/** Whether the permutation is compiled for Platform (debug views only where debug view modes are allowed) */
+	static bool ShouldCompileComposite(const FPermutationDomain& PermutationVector, EShaderPlatform Platform);
+
+	/** Permutations compiled for Platform, out of FPermutationDomain::PermutationCount */
+	static int32 GetNumCompiledPermutations(EShaderPlatform Platform);
+
 	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
 	{
-		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+		return ShouldCompileComposite(FPermutationDomain(Parameters.PermutationId), Parameters.Platform);
 	}
 };
 
-// Directional glare streak shader
+// Directional glare streak shader - every streak is blended additively into one accumulation target
 class FClassicBloomGlareStreakPS : public FGlobalShader
 {
 public:
@@ -104,10 +191,13 @@ public:
 		SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
 		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SourceTexture)
 		SHADER_PARAMETER_SAMPLER(SamplerState, SourceSampler)
-		SHADER_PARAMETER(FVector4f, BufferSizeAndInvSize)
-		SHADER_PARAMETER(FVector2f, StreakDirection) // Normalized direction vector
+		SHADER_PARAMETER(FVector4f, BufferSizeAndInvSize) // Source size
+		SHADER_PARAMETER(FVector3f, SvPositionToSourceU) // Output pixel -> source UV, sheared for anisotropic streak buffers
+		SHADER_PARAMETER(FVector3f, SvPositionToSourceV)
 		SHADER_PARAMETER(float, StreakLength) // Length in texels
 		SHADER_PARAMETER(float, StreakFalloff) // Exponential falloff rate
+		SHADER_PARAMETER_ARRAY(FVector4f, StreakAxes, [4]) // xy = axis direction, z = share of the average
+		SHADER_PARAMETER(uint32, NumStreakAxes) // Axes drawn in this pass, the additive blend sums the passes
 		RENDER_TARGET_BINDING_SLOTS()
 	END_SHADER_PARAMETER_STRUCT()
 
@@ -117,22 +207,48 @@ public:
 	}
 };
 
-// Glare streak accumulation shader - combines multiple streak directions
-class FClassicBloomGlareAccumulatePS : public FGlobalShader
+// Glare streak resolve - stretches up to 4 anisotropic streak buffers back to full size and sums them
+class FClassicBloomGlareStreakResolvePS : public FGlobalShader
 {
 public:
-	DECLARE_GLOBAL_SHADER(FClassicBloomGlareAccumulatePS);
-	SHADER_USE_PARAMETER_STRUCT(FClassicBloomGlareAccumulatePS, FGlobalShader);
+	DECLARE_GLOBAL_SHADER(FClassicBloomGlareStreakResolvePS);
+	SHADER_USE_PARAMETER_STRUCT(FClassicBloomGlareStreakResolvePS, FGlobalShader);
+
+	static constexpr int32 MaxStreakBuffers = 4;
 
 	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
-		SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
-		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, StreakTexture0)
-		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, StreakTexture1)
-		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, StreakTexture2)
-		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, StreakTexture3)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, StreakTexture_0)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, StreakTexture_1)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, StreakTexture_2)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, StreakTexture_3)
 		SHADER_PARAMETER_SAMPLER(SamplerState, StreakSampler)
-		SHADER_PARAMETER(FVector4f, GlareViewportSizeAndInvSize)
-		SHADER_PARAMETER(int32, NumStreaks)
+		SHADER_PARAMETER_ARRAY(FVector4f, StreakToBufferU, [MaxStreakBuffers]) // xyz: output pixel -> buffer UV
+		SHADER_PARAMETER_ARRAY(FVector4f, StreakToBufferV, [MaxStreakBuffers])
+		SHADER_PARAMETER(uint32, NumStreakBuffers)
+		RENDER_TARGET_BINDING_SLOTS()
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+};
+
+// Logarithmic glare streak step - 4 taps at a growing stride; a few steps build one long streak
+class FClassicBloomGlareStreakStepPS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FClassicBloomGlareStreakStepPS);
+	SHADER_USE_PARAMETER_STRUCT(FClassicBloomGlareStreakStepPS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SourceTexture)
+		SHADER_PARAMETER_SAMPLER(SamplerState, SourceSampler)
+		SHADER_PARAMETER(FVector4f, BufferSizeAndInvSize)
+		SHADER_PARAMETER(FVector2f, StreakDirection) // Normalized, signed: each half of a streak is its own chain
+		SHADER_PARAMETER(float, StreakStride) // Texels between taps
+		SHADER_PARAMETER(float, StreakTapStart) // First tap index (0, or 1 to skip the center)
+		SHADER_PARAMETER(FVector4f, StreakTapWeights) // Normalized tap weights times the step's output scale
 		RENDER_TARGET_BINDING_SLOTS()
 	END_SHADER_PARAMETER_STRUCT()
 
@@ -156,7 +272,7 @@ public:
 
 	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
 		SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
-		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SourceTexture)
+		SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2D, SourceTexture) // Scene color, or one mip of the pyramid
 		SHADER_PARAMETER_SAMPLER(SamplerState, SourceSampler)
 		SHADER_PARAMETER(FVector4f, SourceSizeAndInvSize) // Source texture size for sampling offsets
 		SHADER_PARAMETER(FVector4f, OutputSizeAndInvSize) // Output viewport size for UV calculation
@@ -174,7 +290,7 @@ public:
 	}
 };
 
-// Kawase upsample shader - 9-tap tent filter with additive blend
+// Kawase upsample shader - 9-tap tent filter, blended additively onto the larger mip in place
 class FClassicBloomKawaseUpsamplePS : public FGlobalShader
 {
 public:
@@ -183,8 +299,7 @@ public:
 
 	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
 		SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
-		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SourceTexture)
-		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, PreviousMipTexture)
+		SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2D, SourceTexture) // Smaller pyramid mip
 		SHADER_PARAMETER_SAMPLER(SamplerState, SourceSampler)
 		SHADER_PARAMETER(FVector4f, OutputSizeAndInvSize) // Output viewport size for UV calculation
 		SHADER_PARAMETER(float, FilterRadius) // Radius in texture coordinates
@@ -196,3 +311,302 @@ public:
 		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
 	}
 };
+
+// Kawase downsample chain compute shader - the whole mip pyramid in one dispatch. Groups start on
+// mip 0 tiles and move on to a next-mip tile once every tile it reads is done (tracked by atomic counters)
+class FClassicBloomKawaseDownsampleChainCS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FClassicBloomKawaseDownsampleChainCS);
+	SHADER_USE_PARAMETER_STRUCT(FClassicBloomKawaseDownsampleChainCS, FGlobalShader);
+
+	static constexpr int32 MaxMips = FClassicBloomKawaseChainLimits::MaxMips;
+	static constexpr int32 TileSize = FClassicBloomKawaseChainLimits::TileSize;
+	static constexpr int32 MaxWorkItems = FClassicBloomKawaseChainLimits::MaxWorkItems;
+
+	static FIntPoint GetTileCount(FIntPoint MipExtent)
+	{
+		return FIntPoint::DivideAndRoundUp(MipExtent, TileSize);
+	}
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SourceTexture)
+		SHADER_PARAMETER_SAMPLER(SamplerState, SourceSampler)
+		SHADER_PARAMETER(FVector4f, SourceSizeAndInvSize)
+		SHADER_PARAMETER(FScreenTransform, SvPositionToSourceUV) // Transform mip 0 pixel position to scene color UV
+		SHADER_PARAMETER(float, BloomThreshold)
+		SHADER_PARAMETER(float, ThresholdKnee)
+		SHADER_PARAMETER(uint32, NumMips)
+		SHADER_PARAMETER_ARRAY(FIntVector4, MipSizeAndOffsets, [MaxMips]) // xy = extent, z = first scratch texel, w = first tile counter
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<uint2>, RWScratch)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<uint>, RWTileCounters)
+		SHADER_PARAMETER_RDG_TEXTURE_UAV_ARRAY(RWTexture2D<float4>, RWMipTextures, [MaxMips])
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("TILE_SIZE"), TileSize);
+		OutEnvironment.SetDefine(TEXT("MAX_MIPS"), MaxMips);
+		OutEnvironment.SetDefine(TEXT("MAX_WORK_ITEMS"), MaxWorkItems);
+	}
+};
+
+// ============================================================================
+// FFT Convolution Shaders
+// One thread group transforms one row or column of the spectrum in groupshared
+// memory; R, G and B are three complex lines (two texture array slices)
+// ============================================================================
+
+// Transform length along the dispatched axis (rows: spectrum width, columns: spectrum height)
+class FClassicBloomFFTSizeDim : SHADER_PERMUTATION_SPARSE_INT("FFT_SIZE", 64, 128, 256, 512, 1024);
+
+// Shared base: compile settings for the FFT compute shaders
+class FClassicBloomFFTCS : public FGlobalShader
+{
+public:
+	static constexpr int32 MaxThreadGroupSize = 256; // Two butterflies per thread and stage at the largest size
+
+	FClassicBloomFFTCS() = default;
+	FClassicBloomFFTCS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+		: FGlobalShader(Initializer)
+	{
+	}
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+
+protected:
+	static void SetFFTDefines(int32 FFTSize, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		OutEnvironment.SetDefine(TEXT("FFT_LOG2_SIZE"), FMath::FloorLog2((uint32)FFTSize));
+		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), FMath::Min(FFTSize / 2, MaxThreadGroupSize));
+	}
+};
+
+// FFT of each row: the bright pass zero padded to the spectrum width, or the kernel image
+// centered on texel (0, 0) with wrap-around so the convolution does not shift the image
+class FClassicBloomFFTForwardRowsCS : public FClassicBloomFFTCS
+{
+public:
+	DECLARE_GLOBAL_SHADER(FClassicBloomFFTForwardRowsCS);
+	SHADER_USE_PARAMETER_STRUCT(FClassicBloomFFTForwardRowsCS, FClassicBloomFFTCS);
+
+	class FKernelInputDim : SHADER_PERMUTATION_BOOL("KERNEL_INPUT");
+	using FPermutationDomain = TShaderPermutationDomain<FClassicBloomFFTSizeDim, FKernelInputDim>;
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SourceTexture) // Bright pass or kernel image
+		SHADER_PARAMETER_SAMPLER(SamplerState, SourceSampler)
+		SHADER_PARAMETER(FIntPoint, SourceSize) // Texels holding image data, the rest of the row is zero
+		SHADER_PARAMETER(FIntPoint, FFTSize)
+		SHADER_PARAMETER(float, KernelSizeInTexels) // Kernel image width in spectrum texels
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2DArray<float4>, RWSpectrumTexture)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		SetFFTDefines(FPermutationDomain(Parameters.PermutationId).Get<FClassicBloomFFTSizeDim>(), OutEnvironment);
+	}
+};
+
+// FFT of each column in place; the convolving permutation multiplies by the kernel spectrum
+// and transforms the column back in the same dispatch
+class FClassicBloomFFTColumnsCS : public FClassicBloomFFTCS
+{
+public:
+	DECLARE_GLOBAL_SHADER(FClassicBloomFFTColumnsCS);
+	SHADER_USE_PARAMETER_STRUCT(FClassicBloomFFTColumnsCS, FClassicBloomFFTCS);
+
+	class FConvolveDim : SHADER_PERMUTATION_BOOL("CONVOLVE");
+	using FPermutationDomain = TShaderPermutationDomain<FClassicBloomFFTSizeDim, FConvolveDim>;
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2DArray, KernelSpectrumTexture)
+		SHADER_PARAMETER(FIntPoint, SourceSize) // Rows holding data, the rest of the column is zero
+		SHADER_PARAMETER(FIntPoint, FFTSize)
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2DArray<float4>, RWSpectrumTexture)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		SetFFTDefines(FPermutationDomain(Parameters.PermutationId).Get<FClassicBloomFFTSizeDim>(), OutEnvironment);
+	}
+};
+
+// Inverse FFT of each row, writing the real part of the image region as the bloom
+class FClassicBloomFFTInverseRowsCS : public FClassicBloomFFTCS
+{
+public:
+	DECLARE_GLOBAL_SHADER(FClassicBloomFFTInverseRowsCS);
+	SHADER_USE_PARAMETER_STRUCT(FClassicBloomFFTInverseRowsCS, FClassicBloomFFTCS);
+
+	using FPermutationDomain = TShaderPermutationDomain<FClassicBloomFFTSizeDim>;
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2DArray, SpectrumTexture)
+		SHADER_PARAMETER(FIntPoint, SourceSize) // Output extent
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, RWOutputTexture)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		SetFFTDefines(FPermutationDomain(Parameters.PermutationId).Get<FClassicBloomFFTSizeDim>(), OutEnvironment);
+	}
+};
+
+// ============================================================================
+// Temporal Reuse Shaders
+// ============================================================================
+
+// Upsample the jittered coarse bloom into the reprojected per-view history
+class FClassicBloomTemporalResolvePS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FClassicBloomTemporalResolvePS);
+	SHADER_USE_PARAMETER_STRUCT(FClassicBloomTemporalResolvePS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
+		SHADER_PARAMETER_STRUCT_INCLUDE(FSceneTextureShaderParameters, SceneTextures)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, CurrentTexture) // Bloom stages at the temporal resolution
+		SHADER_PARAMETER_SAMPLER(SamplerState, CurrentSampler)
+		SHADER_PARAMETER(FVector4f, CurrentSizeAndInvSize)
+		SHADER_PARAMETER(FVector2f, CurrentJitter) // Bright pass offset of this frame in current texels
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, HistoryTexture) // Previous frame's output (rgb = bloom, a = scene depth)
+		SHADER_PARAMETER_SAMPLER(SamplerState, HistorySampler)
+		SHADER_PARAMETER(float, HistoryWeight)
+		SHADER_PARAMETER(float, HistoryExposureScale)
+		SHADER_PARAMETER(FVector4f, OutputSizeAndInvSize)
+		RENDER_TARGET_BINDING_SLOTS()
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+};
+
+// ============================================================================
+// Batched Multi-View Shaders
+// Every view of a family is one slice of a Texture2DArray; each stage is a
+// single dispatch with Z = number of views
+// ============================================================================
+
+// Shared base: compile settings for the batched compute shaders
+class FClassicBloomBatchedCS : public FGlobalShader
+{
+public:
+	static constexpr int32 MaxViews = 4; // 4-player split-screen
+	static constexpr int32 ThreadGroupSize = 8;
+
+	FClassicBloomBatchedCS() = default;
+	FClassicBloomBatchedCS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+		: FGlobalShader(Initializer)
+	{
+	}
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), ThreadGroupSize);
+		OutEnvironment.SetDefine(TEXT("CLASSIC_BLOOM_MAX_BATCHED_VIEWS"), MaxViews);
+	}
+};
+
+// Batched bright pass - family scene color to one slice per view
+class FClassicBloomBatchedBrightPassCS : public FClassicBloomBatchedCS
+{
+public:
+	DECLARE_GLOBAL_SHADER(FClassicBloomBatchedBrightPassCS);
+	SHADER_USE_PARAMETER_STRUCT(FClassicBloomBatchedBrightPassCS, FClassicBloomBatchedCS);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SceneColorTexture)
+		SHADER_PARAMETER_SAMPLER(SamplerState, SourceSampler)
+		SHADER_PARAMETER_ARRAY(FVector4f, SourceUVScaleBias, [MaxViews]) // Per view: output pixel center -> scene color UV
+		SHADER_PARAMETER(FVector4f, OutputSizeAndInvSize)
+		SHADER_PARAMETER(uint32, NumSlices)
+		SHADER_PARAMETER(float, BloomThreshold)
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2DArray<float4>, RWOutputTexture)
+	END_SHADER_PARAMETER_STRUCT()
+};
+
+// Batched separable Gaussian blur
+class FClassicBloomBatchedBlurCS : public FClassicBloomBatchedCS
+{
+public:
+	DECLARE_GLOBAL_SHADER(FClassicBloomBatchedBlurCS);
+	SHADER_USE_PARAMETER_STRUCT(FClassicBloomBatchedBlurCS, FClassicBloomBatchedCS);
+
+	using FPermutationDomain = TShaderPermutationDomain<FClassicBloomBlurTapsDim>;
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2DArray, SourceTexture)
+		SHADER_PARAMETER_SAMPLER(SamplerState, SourceSampler)
+		SHADER_PARAMETER(FVector4f, OutputSizeAndInvSize)
+		SHADER_PARAMETER(uint32, NumSlices)
+		SHADER_PARAMETER(FVector2f, BlurDirection)
+		SHADER_PARAMETER(FVector4f, BlurWeights) // x = center, yzw = fetch pairs (FClassicBloomBlurKernel)
+		SHADER_PARAMETER(FVector4f, BlurOffsets) // yzw = fetch pair distances in texels
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2DArray<float4>, RWOutputTexture)
+	END_SHADER_PARAMETER_STRUCT()
+};
+
+// Batched Kawase downsample - 13-tap filter, first mip reads the family scene color
+class FClassicBloomBatchedKawaseDownsampleCS : public FClassicBloomBatchedCS
+{
+public:
+	DECLARE_GLOBAL_SHADER(FClassicBloomBatchedKawaseDownsampleCS);
+	SHADER_USE_PARAMETER_STRUCT(FClassicBloomBatchedKawaseDownsampleCS, FClassicBloomBatchedCS);
+
+	class FSourceIsSceneColorDim : SHADER_PERMUTATION_BOOL("SOURCE_IS_SCENE_COLOR");
+	using FPermutationDomain = TShaderPermutationDomain<FSourceIsSceneColorDim>;
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SceneColorTexture)
+		SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2DArray, SourceTexture) // One mip of the pyramid
+		SHADER_PARAMETER_SAMPLER(SamplerState, SourceSampler)
+		SHADER_PARAMETER_ARRAY(FVector4f, SourceUVScaleBias, [MaxViews]) // Per view: output pixel center -> source UV
+		SHADER_PARAMETER(FVector4f, SourceSizeAndInvSize)
+		SHADER_PARAMETER(FVector4f, OutputSizeAndInvSize)
+		SHADER_PARAMETER(uint32, NumSlices)
+		SHADER_PARAMETER(float, BloomThreshold)
+		SHADER_PARAMETER(float, ThresholdKnee)
+		SHADER_PARAMETER(int32, bFirstMip) // 1 = apply Karis average and threshold
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2DArray<float4>, RWOutputTexture)
+	END_SHADER_PARAMETER_STRUCT()
+};
+
+// Batched Kawase upsample - 9-tap tent filter, added in place onto the output mip of the same pyramid
+class FClassicBloomBatchedKawaseUpsampleCS : public FClassicBloomBatchedCS
+{
+public:
+	DECLARE_GLOBAL_SHADER(FClassicBloomBatchedKawaseUpsampleCS);
+	SHADER_USE_PARAMETER_STRUCT(FClassicBloomBatchedKawaseUpsampleCS, FClassicBloomBatchedCS);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2DArray, SourceTexture) // One mip of the pyramid
+		SHADER_PARAMETER_SAMPLER(SamplerState, SourceSampler)
+		SHADER_PARAMETER(FVector4f, OutputSizeAndInvSize)
+		SHADER_PARAMETER(uint32, NumSlices)
+		SHADER_PARAMETER(float, FilterRadius) // Radius in texture coordinates
+		SHADER_PARAMETER(int32, bAdditive) // 1 = add onto the output's contents (needs typed UAV loads)
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2DArray<float4>, RWOutputTexture)
+	END_SHADER_PARAMETER_STRUCT()
+};
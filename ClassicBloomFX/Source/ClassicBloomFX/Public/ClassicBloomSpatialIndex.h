@@ -0,0 +1,89 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClassicBloomRenderSettings.h"
+
+class UBloomFXVolumeComponent;
+
+/**
+ * Static bounding volume hierarchy over axis-aligned boxes.
+ * Rebuilt from scratch when its inputs change; point queries visit O(log n) nodes.
+ */
+class CLASSICBLOOMFX_API FClassicBloomBoundsTree
+{
+public:
+	/** Build the tree over the given boxes; item indices refer to positions in Bounds */
+	void Build(TConstArrayView<FBox> Bounds);
+
+	/** Append the indices of every box containing Point */
+	void QueryPoint(const FVector& Point, TArray<int32, TInlineAllocator<16>>& OutItems) const;
+
+	void Reset();
+	bool IsEmpty() const { return Nodes.Num() == 0; }
+
+private:
+	// Nodes are stored depth-first: the left child of an interior node immediately follows it
+	struct FNode
+	{
+		FBox Bounds = FBox(ForceInit);
+		int32 FirstItem = 0;   // Leaf only: first entry in Items
+		int32 NumItems = 0;    // Leaf only: number of entries (0 for interior nodes)
+		int32 RightChild = 0;  // Interior only: index of the right child
+	};
+
+	void BuildNode(TConstArrayView<FBox> Bounds, const TArray<FVector>& Centers, int32 Begin, int32 End);
+
+	TArray<FNode> Nodes;
+	TArray<int32> Items;
+};
+
+/** Immutable game-thread copy of a volume used for blending, so queries never touch the component */
+struct FClassicBloomVolumeProxy
+{
+	FClassicBloomRenderSettingsPtr Settings;
+	FTransform ComponentToWorld;
+	FVector BoxExtent = FVector::ZeroVector;
+	float Priority = 0.0f;
+	float BlendRadius = 0.0f;
+	float BlendWeight = 0.0f;
+
+	/** Box grown by BlendRadius, used as the bounds in the tree */
+	FBox GetInfluenceBounds() const;
+
+	/** Blend weight at a world position (BlendWeight inside the box, linear fade across BlendRadius) */
+	float GetWeightAt(const FVector& Location) const;
+};
+
+/**
+ * Spatial index of bloom volumes owned by UClassicBloomSubsystem (game thread only).
+ * Volume changes only mark the index dirty; proxies and tree are rebuilt lazily on the next query.
+ */
+class CLASSICBLOOMFX_API FClassicBloomVolumeIndex
+{
+public:
+	void Add(UBloomFXVolumeComponent* Volume);
+	void Remove(UBloomFXVolumeComponent* Volume);
+	void MarkDirty() { bDirty = true; }
+	bool Contains(const UBloomFXVolumeComponent* Volume) const;
+
+	/** Whether any registered volume is currently active */
+	bool HasActiveVolumes();
+
+	/**
+	 * Blend every volume affecting Location on top of BaseSettings (the active global component, may be null).
+	 * Float and color parameters are interpolated in priority order; the mode and other discrete
+	 * parameters come from whichever source ends up with the highest effective weight.
+	 * Returns BaseSettings unchanged when no volume affects the location.
+	 */
+	FClassicBloomRenderSettingsPtr Resolve(const FVector& Location, const FClassicBloomRenderSettingsPtr& BaseSettings);
+
+private:
+	void Rebuild();
+
+	TArray<TWeakObjectPtr<UBloomFXVolumeComponent>> Volumes;
+	TArray<FClassicBloomVolumeProxy> Proxies;
+	FClassicBloomBoundsTree Tree;
+	bool bDirty = false;
+};
@@ -0,0 +1,38 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+// ============================================================================
+// CPU stats (stat ClassicBloom)
+// ============================================================================
+
+DECLARE_STATS_GROUP(TEXT("ClassicBloom"), STATGROUP_ClassicBloom, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Resolve View Settings"), STAT_ClassicBloom_ResolveSettings, STATGROUP_ClassicBloom, CLASSICBLOOMFX_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Subscribe To Pass"), STAT_ClassicBloom_Subscribe, STATGROUP_ClassicBloom, CLASSICBLOOMFX_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Graph Setup"), STAT_ClassicBloom_GraphSetup, STATGROUP_ClassicBloom, CLASSICBLOOMFX_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Pass Plan"), STAT_ClassicBloom_BuildPlan, STATGROUP_ClassicBloom, CLASSICBLOOMFX_API);
+
+// Per-frame counters (cleared every frame)
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Passes"), STAT_ClassicBloom_Passes, STATGROUP_ClassicBloom, CLASSICBLOOMFX_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Transient Texture Bytes"), STAT_ClassicBloom_TransientTextureBytes, STATGROUP_ClassicBloom, CLASSICBLOOMFX_API);
+
+// Kernel spectrum cache lookups since startup (FFT convolution)
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Kernel Spectrum Hits"), STAT_ClassicBloom_KernelSpectrumHits, STATGROUP_ClassicBloom, CLASSICBLOOMFX_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Kernel Spectrum Misses"), STAT_ClassicBloom_KernelSpectrumMisses, STATGROUP_ClassicBloom, CLASSICBLOOMFX_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Kernel Spectrum DDC Hits"), STAT_ClassicBloom_KernelSpectrumDDCHits, STATGROUP_ClassicBloom, CLASSICBLOOMFX_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Kernel Spectrum DDC Misses"), STAT_ClassicBloom_KernelSpectrumDDCMisses, STATGROUP_ClassicBloom, CLASSICBLOOMFX_API);
+
+// GPU budget (bGpuBudget): latest bloom GPU time read back and the quality level it drives (0 = as authored)
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Budget GPU Time (ms)"), STAT_ClassicBloom_BudgetGpuTime, STATGROUP_ClassicBloom, CLASSICBLOOMFX_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Budget Quality Level"), STAT_ClassicBloom_BudgetLevel, STATGROUP_ClassicBloom, CLASSICBLOOMFX_API);
+
+// ============================================================================
+// CSV profiler category (-csvCategories=ClassicBloom)
+// ============================================================================
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(CLASSICBLOOMFX_API, ClassicBloom);
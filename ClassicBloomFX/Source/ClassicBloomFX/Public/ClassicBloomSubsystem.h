@@ -5,9 +5,20 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "SceneViewExtension.h"
+#include "RenderGraphFwd.h"
+#include "ClassicBloomComponentRegistry.h"
+#include "ClassicBloomSpatialIndex.h"
+#include "ClassicBloomDerivedParams.h"
+#include "ClassicBloomPassPlan.h"
+#include "ClassicBloomKernelSpectrumCache.h"
+#include "ClassicBloomGpuTimer.h"
+#include "ClassicBloomBudgetController.h"
 #include "ClassicBloomSubsystem.generated.h"
 
 class UBloomFXComponent;
+class APlayerController;
+class FViewInfo;
+struct FClassicBloomSliceReplay;
 
 /**
  * Scene View Extension for Custom Bloom rendering
@@ -15,13 +26,14 @@ class UBloomFXComponent;
 class FClassicBloomSceneViewExtension : public FSceneViewExtensionBase
 {
 public:
-	FClassicBloomSceneViewExtension(const FAutoRegister& AutoRegister, UClassicBloomSubsystem* InSubsystem);
+	FClassicBloomSceneViewExtension(const FAutoRegister& AutoRegister, UClassicBloomSubsystem* InSubsystem, TSharedRef<FClassicBloomComponentRegistry, ESPMode::ThreadSafe> InRegistry,
+		TSharedRef<FClassicBloomKernelSpectrumCache, ESPMode::ThreadSafe> InKernelSpectrumCache);
 	virtual ~FClassicBloomSceneViewExtension() {}
 
 	// ISceneViewExtension interface
 	virtual void SetupViewFamily(FSceneViewFamily& InViewFamily) override {}
 	virtual void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override;
-	virtual void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override {}
+	virtual void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override;
 	
 	virtual void SubscribeToPostProcessingPass(EPostProcessingPass PassId, const FSceneView& View, FAfterPassCallbackDelegateArray& InOutPassCallbacks, bool bIsPassEnabled) override;
 	
@@ -31,6 +43,113 @@ public:
 
 private:
 	TWeakObjectPtr<UClassicBloomSubsystem> WeakSubsystem;
+
+	// Component registry shared with the subsystem; publishes the active settings lock-free
+	TSharedRef<FClassicBloomComponentRegistry, ESPMode::ThreadSafe> Registry;
+
+	// Settings for a view: the volume blend resolved in SetupView, or the global settings
+	const FClassicBloomRenderSettings* GetViewSettings_RenderThread(const FSceneView& View) const;
+
+	// Settings View renders with: its snapshot capped by the r.ClassicBloom.* overrides, at the GPU budget's quality level.
+	// Storage holds the adjusted copy when one is needed; null when the view has no settings
+	const FClassicBloomRenderSettings* GetRenderSettings_RenderThread(const FSceneView& View, FClassicBloomRenderSettings& Storage);
+
+	struct FViewSettingsEntry
+	{
+		FClassicBloomRenderSettingsPtr Settings;
+		uint32 LastUsedFrame = 0;
+	};
+
+	// Settings resolved in SetupView per view key; game thread copies are reused while the result is unchanged.
+	// Both maps drop views not set up for a few frames (closed split-screen players, scene captures, editor viewports)
+	TMap<uint32, FViewSettingsEntry> ViewSettings_GameThread;
+	TArray<TPair<uint32, FClassicBloomRenderSettingsPtr>> PendingViewSettings;
+	TMap<uint32, FViewSettingsEntry> ViewSettings_RenderThread;
+
+	// Derived parameters shared by views with equal settings (render thread)
+	FClassicBloomDerivedParamsCache DerivedParamsCache;
+
+	// Pass plans per settings and view size, replayed into the graph every frame (render thread)
+	FClassicBloomPassPlanCache PassPlanCache;
+
+	// FFT convolution kernel spectra, shared with the subsystem which prefetches them
+	TSharedRef<FClassicBloomKernelSpectrumCache, ESPMode::ThreadSafe> KernelSpectrumCache;
+
+	// Bloom stages shared by the compatible views of one family, one texture array slice per view (render thread)
+	struct FBatchedBloom
+	{
+		const FSceneViewFamily* Family = nullptr;
+		const FRDGBuilder* GraphBuilder = nullptr;
+		uint32 FrameNumber = 0;
+		FRDGTextureRef Texture = nullptr;
+		FIntPoint SliceExtent = FIntPoint::ZeroValue;
+		TArray<const FSceneView*, TInlineAllocator<4>> Views; // Index = slice
+	};
+	FBatchedBloom BatchedBloom;
+
+	// Slice holding View's bloom, building the batch on the first view of the family; INDEX_NONE renders per view
+	int32 GetBatchedBloomSlice_RenderThread(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FPostProcessMaterialInputs& Inputs, const FClassicBloomRenderSettings& Settings);
+	bool AddBatchedBloomPasses_RenderThread(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef FamilySceneColor, const FClassicBloomRenderSettings& Settings, const FClassicBloomDerivedParams& Derived, const FClassicBloomPassPlan& Plan);
+
+	// Temporal reuse: the previous frame's bloom of one view (render thread)
+	struct FTemporalHistory
+	{
+		TRefCountPtr<IPooledRenderTarget> Texture;  // rgb = bloom, a = scene depth
+		FIntPoint Extent = FIntPoint::ZeroValue;
+		EBloomMode Mode = EBloomMode::Standard;
+		float PreExposure = 1.0f;
+		uint32 JitterIndex = 0;
+		uint32 LastUsedFrame = 0;
+	};
+
+	// Per view key; heap allocated so a pending texture extraction keeps a stable target
+	TMap<uint32, TUniquePtr<FTemporalHistory>> TemporalHistories;
+
+	// Sub-texel offset of this frame's bloom stages for View, in bloom texels; advances View's jitter sequence
+	FVector2f GetTemporalJitter_RenderThread(const FSceneView& View);
+
+	// Reconstruct the jittered bloom at Plan.TemporalExtent and keep it as View's history; null if the shader is missing
+	FRDGTextureRef AddTemporalResolvePass_RenderThread(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FPostProcessMaterialInputs& Inputs,
+		const FClassicBloomRenderSettings& Settings, const FClassicBloomPassPlan& Plan, FRDGTextureRef CurrentBloom, FVector2f Jitter);
+
+	// Frame slicing: results of the slices of one view's plan, kept between refreshes (render thread)
+	struct FSlicedHistory
+	{
+		uint32 PlanHash = 0;                                 // Settings and bloom size the results belong to
+		TArray<TRefCountPtr<IPooledRenderTarget>> Textures;  // Per plan texture; only slices' persistent textures are set
+		uint32 ValidSlices = 0;                              // Bit per slice whose textures hold a result
+		uint32 FrameIndex = 0;                               // Position in the plan's slice schedule
+		uint32 LastUsedFrame = 0;
+	};
+
+	// Per view key; heap allocated so a pending texture extraction keeps a stable target
+	TMap<uint32, TUniquePtr<FSlicedHistory>> SlicedHistories;
+
+	// Pick the slices View runs this frame and bind the kept results of the others
+	void BeginFrameSlicing_RenderThread(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FClassicBloomRenderSettings& Settings, const FClassicBloomPassPlan& Plan, FClassicBloomSliceReplay& OutReplay);
+
+	// Keep the results of the slices that ran
+	void EndFrameSlicing_RenderThread(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FClassicBloomPassPlan& Plan, const FClassicBloomSliceReplay& Replay);
+
+	// GPU budget: bloom GPU time of one view and the quality level it drives (render thread). The stages a batch
+	// shares are timed in the view that builds the batch
+	struct FGpuBudget
+	{
+		FClassicBloomGpuTimer Timer;
+		FClassicBloomBudgetController Controller;
+		uint32 FedFrameNumber = 0;  // Frame the landed timings were last fed to the controller
+		uint32 LastUsedFrame = 0;
+	};
+
+	// Per view key: views author their own target and parameters, so each climbs its own ladder.
+	// Heap allocated so the timestamps in flight keep a stable timer
+	TMap<uint32, TUniquePtr<FGpuBudget>> GpuBudgets;
+
+	// View's budget, dropping those of views not rendered for a few frames
+	FGpuBudget& FindOrAddGpuBudget_RenderThread(const FSceneView& View);
+
+	// Settings at View's current budget level: Settings itself at level 0, otherwise a copy in OutBudgetSettings
+	const FClassicBloomRenderSettings& ApplyGpuBudget_RenderThread(const FSceneView& View, const FClassicBloomRenderSettings& Settings, FClassicBloomRenderSettings& OutBudgetSettings);
 	
 	FScreenPassTexture PostProcessPass_RenderThread(FRDGBuilder& GraphBuilder, const FSceneView& View, const FPostProcessMaterialInputs& Inputs);
 };
@@ -52,14 +171,60 @@ public:
 	void RegisterBloomComponent(UBloomFXComponent* Component);
 	void UnregisterBloomComponent(UBloomFXComponent* Component);
 
-	// Get all active bloom components
-	const TArray<TWeakObjectPtr<UBloomFXComponent>>& GetBloomComponents() const { return BloomComponents; }
+	// Called when a component's settings snapshot or active state changes
+	void NotifyBloomComponentChanged(UBloomFXComponent* Component);
+
+	// Get all registered bloom components (volumes are tracked separately by the spatial index)
+	const TArray<TWeakObjectPtr<UBloomFXComponent>>& GetBloomComponents() const { return Registry->GetComponents(); }
+
+	// Settings of the first active component (null if none); one atomic load, safe on any thread
+	const FClassicBloomRenderSettings* GetActiveSettings() const { return Registry->GetActiveSettings(); }
+
+	/**
+	 * Use Component's settings for every view of Player instead of the global bloom (split-screen).
+	 * Pass null to clear. Give the component bOnlyAffectViewTarget so it does not also act as the global bloom.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Rendering|Bloom")
+	void SetPlayerBloomOverride(APlayerController* Player, UBloomFXComponent* Component);
+
+	// Settings for a view: view target component, player override or global settings,
+	// with every bloom volume affecting the view location blended on top (game thread)
+	FClassicBloomRenderSettingsPtr ResolveSettingsForView(const FSceneView& View);
+
+	// Whether views can resolve to something other than the global settings (game thread)
+	bool NeedsPerViewSettings();
+
+	// Whether any bloom volume is active in this world (game thread)
+	bool HasActiveBloomVolumes() { return VolumeIndex.HasActiveVolumes(); }
+
+	// FFT convolution kernel spectrum cache hits and misses since the subsystem started; safe on any thread
+	FClassicBloomKernelSpectrumCacheStats GetKernelSpectrumCacheStats() const { return KernelSpectrumCache->GetStats(); }
 
 private:
 	// Scene view extension for rendering
 	TSharedPtr<FClassicBloomSceneViewExtension, ESPMode::ThreadSafe> SceneViewExtension;
 
-	// Registered bloom components
-	UPROPERTY(Transient)
-	TArray<TWeakObjectPtr<UBloomFXComponent>> BloomComponents;
+	// Registered bloom components and the published active settings
+	TSharedRef<FClassicBloomComponentRegistry, ESPMode::ThreadSafe> Registry = MakeShared<FClassicBloomComponentRegistry, ESPMode::ThreadSafe>();
+
+	// Bloom volumes, queried per view by the scene view extension
+	FClassicBloomVolumeIndex VolumeIndex;
+
+	// Kernel spectra of the FFT convolution, prefetched when components register or change
+	TSharedRef<FClassicBloomKernelSpectrumCache, ESPMode::ThreadSafe> KernelSpectrumCache = MakeShared<FClassicBloomKernelSpectrumCache, ESPMode::ThreadSafe>();
+	void PrefetchKernelSpectrum(const UBloomFXComponent* Component);
+
+	const FClassicBloomRenderSettingsPtr& GetBaseSettingsForViewTarget(const AActor* ViewTarget) const;
+
+	// Components with bOnlyAffectViewTarget, by owning actor
+	TMap<TObjectKey<AActor>, TWeakObjectPtr<UBloomFXComponent>> ViewTargetComponents;
+
+	struct FPlayerBloomOverride
+	{
+		TWeakObjectPtr<APlayerController> Player;
+		TWeakObjectPtr<UBloomFXComponent> Component;
+	};
+
+	// Per-player overrides set from gameplay (one entry per local player at most)
+	TArray<FPlayerBloomOverride> PlayerOverrides;
 };
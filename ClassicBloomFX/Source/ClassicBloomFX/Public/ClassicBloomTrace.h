@@ -0,0 +1,26 @@
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Logging/LogMacros.h"
+#include "Trace/Trace.h"
+
+// ============================================================================
+// Logging
+// ============================================================================
+
+// Compiled out of Shipping builds entirely
+#if UE_BUILD_SHIPPING
+CLASSICBLOOMFX_API DECLARE_LOG_CATEGORY_EXTERN(LogClassicBloom, Log, NoLogging);
+#else
+CLASSICBLOOMFX_API DECLARE_LOG_CATEGORY_EXTERN(LogClassicBloom, Log, All);
+#endif
+
+// ============================================================================
+// Unreal Insights (-trace=ClassicBloom)
+// ============================================================================
+
+// Emits one ClassicBloom.ViewFrame event per bloomed view per frame: settings hash, mode,
+// extents, pass count and graph setup time. Nothing is recorded unless the channel is enabled.
+UE_TRACE_CHANNEL_EXTERN(ClassicBloomChannel, CLASSICBLOOMFX_API);